@@ -0,0 +1,209 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Small client used to send protocol requests to a running antimicro
+// instance. Kept free of any GUI and SDL dependencies so it starts fast
+// enough to be called from game launchers and scripts.
+
+#include "localantimicroprotocol.h"
+#include "common.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QLocalSocket>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QMapIterator>
+
+
+static void printValue(QTextStream &stream, const QString &key, const QVariant &value, int indent)
+{
+    QString padding(indent, ' ');
+
+    if (value.type() == QVariant::List)
+    {
+        stream << padding << key << ":" << endl;
+
+        QListIterator<QVariant> iter(value.toList());
+        while (iter.hasNext())
+        {
+            QVariant temp = iter.next();
+            if (temp.type() == QVariant::Map)
+            {
+                QMapIterator<QString, QVariant> mapIter(temp.toMap());
+                bool first = true;
+                while (mapIter.hasNext())
+                {
+                    mapIter.next();
+                    stream << padding << (first ? "  - " : "    ") << mapIter.key() << ": "
+                           << mapIter.value().toString() << endl;
+                    first = false;
+                }
+            }
+            else
+            {
+                stream << padding << "  - " << temp.toString() << endl;
+            }
+        }
+    }
+    else
+    {
+        stream << padding << key << ": " << value.toString() << endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("antimicroctl");
+    QCoreApplication::setApplicationVersion(PadderCommon::programVersion);
+
+    QTextStream outstream(stdout);
+    QTextStream errorstream(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QCoreApplication::translate("antimicroctl",
+        "Send commands to a running antimicro instance."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("command",
+        QCoreApplication::translate("antimicroctl", "One of load, set, unload, status or stats."));
+    parser.addPositionalArgument("value",
+        QCoreApplication::translate("antimicroctl", "Profile location for load or set number for set."),
+        "[value]");
+    parser.addOptions({
+            {{"controller", "c"},
+                QCoreApplication::translate("antimicroctl", "Apply command to a specific controller. Value can be a controller index, name, or GUID"),
+                QCoreApplication::translate("antimicroctl", "value")},
+            {{"timeout", "t"},
+                QCoreApplication::translate("antimicroctl", "Milliseconds to wait for a response."),
+                QCoreApplication::translate("antimicroctl", "msecs"),
+                "1000"},
+            {"timing",
+                QCoreApplication::translate("antimicroctl", "Print round-trip time of the request.")},
+        });
+
+    parser.process(app);
+
+    QStringList positional = parser.positionalArguments();
+    if (positional.isEmpty())
+    {
+        parser.showHelp(1);
+    }
+
+    quint8 command = LocalAntiMicroProtocol::commandFromName(positional.at(0));
+    if (command == LocalAntiMicroProtocol::InvalidCommand)
+    {
+        errorstream << QCoreApplication::translate("antimicroctl", "Unknown command %1").arg(positional.at(0)) << endl;
+        return 1;
+    }
+
+    QVariantMap args;
+    if (parser.isSet("controller"))
+    {
+        args.insert("controller", parser.value("controller"));
+    }
+
+    if ((command == LocalAntiMicroProtocol::LoadProfile) ||
+        (command == LocalAntiMicroProtocol::ChangeSet))
+    {
+        if (positional.size() < 2)
+        {
+            errorstream << QCoreApplication::translate("antimicroctl", "Command %1 requires a value.")
+                           .arg(positional.at(0)) << endl;
+            return 1;
+        }
+        else if (command == LocalAntiMicroProtocol::LoadProfile)
+        {
+            // Resolve here. The running instance has a different working directory.
+            args.insert("profile", QFileInfo(positional.at(1)).absoluteFilePath());
+        }
+        else
+        {
+            args.insert("set", positional.at(1).toInt());
+        }
+    }
+
+    int timeout = parser.value("timeout").toInt();
+    if (timeout <= 0)
+    {
+        timeout = 1000;
+    }
+
+    QElapsedTimer roundTrip;
+    roundTrip.start();
+
+    QLocalSocket socket;
+    socket.connectToServer(PadderCommon::localSocketKey);
+    if (!socket.waitForConnected(timeout))
+    {
+        errorstream << QCoreApplication::translate("antimicroctl", "Could not connect to a running antimicro instance.") << endl;
+        return 2;
+    }
+
+    LocalAntiMicroProtocol::writeFrame(&socket, command, args);
+    socket.flush();
+
+    QByteArray buffer;
+    quint8 responseCommand = LocalAntiMicroProtocol::InvalidCommand;
+    QVariantMap response;
+    LocalAntiMicroProtocol::FrameResult result = LocalAntiMicroProtocol::FrameIncomplete;
+
+    while ((result == LocalAntiMicroProtocol::FrameIncomplete) && socket.waitForReadyRead(timeout))
+    {
+        buffer.append(socket.readAll());
+        result = LocalAntiMicroProtocol::decodeFrame(buffer, responseCommand, response);
+    }
+
+    qint64 elapsed = roundTrip.nsecsElapsed();
+    socket.disconnectFromServer();
+
+    if (result != LocalAntiMicroProtocol::FrameComplete)
+    {
+        errorstream << QCoreApplication::translate("antimicroctl", "No valid response received.") << endl;
+        return 2;
+    }
+
+    int status = response.take("status").toInt();
+    QString error = response.take("error").toString();
+
+    QMapIterator<QString, QVariant> iter(response);
+    while (iter.hasNext())
+    {
+        iter.next();
+        printValue(outstream, iter.key(), iter.value(), 0);
+    }
+
+    if (parser.isSet("timing"))
+    {
+        outstream << "roundTripUsecs: " << QString::number(elapsed / 1000.0, 'f', 1) << endl;
+    }
+
+    if (status != LocalAntiMicroProtocol::StatusOk)
+    {
+        errorstream << LocalAntiMicroProtocol::statusName(status);
+        if (!error.isEmpty())
+        {
+            errorstream << ": " << error;
+        }
+        errorstream << endl;
+        return 1;
+    }
+
+    return 0;
+}
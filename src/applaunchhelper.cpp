@@ -21,6 +21,7 @@
 #include "inputdevice.h"
 #include "joybutton.h"
 #include "antimicrosettings.h"
+#include "textentrystreamer.h"
 
 #ifdef Q_OS_WIN
     #include "winextras.h"
@@ -54,6 +55,8 @@ void AppLaunchHelper::initRunMethods()
         changeMouseRefreshRate();
         changeSpringModeScreen();
         changeGamepadPollRate();
+        changeTextEntryRate();
+        changeWheelOutputMode();
 
 #ifdef Q_OS_WIN
         checkPointerPrecision();
@@ -105,6 +108,26 @@ void AppLaunchHelper::changeGamepadPollRate()
     }
 }
 
+void AppLaunchHelper::changeTextEntryRate()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    int keystrokeRate = settings->value("TextEntry/KeystrokeRate",
+                                        TextEntryStreamer::DEFAULTKEYSTROKERATE).toInt();
+    if (keystrokeRate > 0)
+    {
+        TextEntryStreamer::setKeystrokeRate(keystrokeRate);
+    }
+}
+
+void AppLaunchHelper::changeWheelOutputMode()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    bool highResolution = settings->value("Mouse/HighResolutionWheel", false).toBool();
+    JoyButton::setHighResolutionWheel(highResolution);
+}
+
 void AppLaunchHelper::printControllerList(QMap<SDL_JoystickID, InputDevice *> *joysticks)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -46,6 +46,8 @@ protected:
     void changeMouseRefreshRate();
     void changeSpringModeScreen();
     void changeGamepadPollRate();
+    void changeTextEntryRate();
+    void changeWheelOutputMode();
 
 #ifdef Q_OS_WIN
     void checkPointerPrecision();
@@ -0,0 +1,350 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "axisbatchkernel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+  #define AXISBATCH_HAVE_SSE2
+  #include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+  #define AXISBATCH_HAVE_AVX2
+  #include <immintrin.h>
+#endif
+
+
+namespace AxisBatchKernel
+{
+    // Values mirror JoyAxis::ThrottleTypes.
+    const qint32 negativeHalfThrottle = -2;
+    const qint32 negativeThrottle = -1;
+    const qint32 positiveThrottle = 1;
+    const qint32 positiveHalfThrottle = 2;
+
+    int AxisBatch::append(int value, int throttle, int deadZone, int maxZone,
+                          int minCal, int maxCal)
+    {
+        values.append(value);
+        throttles.append(throttle);
+        deadZones.append(deadZone);
+        maxZones.append(maxZone);
+        minCals.append(minCal);
+        maxCals.append(maxCal);
+
+        return values.size() - 1;
+    }
+
+    void AxisBatch::clear()
+    {
+        // QVector::resize keeps allocated capacity so buffers are
+        // reused between polling passes.
+        values.resize(0);
+        throttles.resize(0);
+        deadZones.resize(0);
+        maxZones.resize(0);
+        minCals.resize(0);
+        maxCals.resize(0);
+        clampedValues.resize(0);
+        throttledValues.resize(0);
+        deadZoneFlags.resize(0);
+        distances.resize(0);
+    }
+
+    int AxisBatch::size() const
+    {
+        return values.size();
+    }
+
+    static inline qint32 throttleScalar(qint32 value, qint32 throttle,
+                                        qint32 minCal, qint32 maxCal)
+    {
+        qint32 temp = value;
+
+        if (throttle == negativeHalfThrottle)
+        {
+            temp = (value <= 0) ? value : -value;
+        }
+        else if (throttle == negativeThrottle)
+        {
+            temp = (value + minCal) / 2;
+        }
+        else if (throttle == positiveThrottle)
+        {
+            temp = (value + maxCal) / 2;
+        }
+        else if (throttle == positiveHalfThrottle)
+        {
+            temp = (value >= 0) ? value : -value;
+        }
+
+        return temp;
+    }
+
+    static void processScalar(AxisBatch &batch, int start)
+    {
+        const int count = batch.size();
+
+        for (int i = start; i < count; i++)
+        {
+            qint32 value = batch.values.at(i);
+            qint32 minCal = batch.minCals.at(i);
+            qint32 maxCal = batch.maxCals.at(i);
+            qint32 throttle = batch.throttles.at(i);
+            qint32 deadZone = batch.deadZones.at(i);
+
+            qint32 clamped = value;
+            if (value > maxCal)
+            {
+                clamped = maxCal;
+            }
+            else if (value < minCal)
+            {
+                clamped = minCal;
+            }
+
+            qint32 throttled = throttleScalar(value, throttle, minCal, maxCal);
+            qint32 deadThrottled = throttleScalar(clamped, throttle, minCal, maxCal);
+
+            float distance = static_cast<float>(qAbs(throttled) - deadZone) /
+                    static_cast<float>(batch.maxZones.at(i) - deadZone);
+
+            batch.clampedValues[i] = clamped;
+            batch.throttledValues[i] = throttled;
+            batch.deadZoneFlags[i] = (qAbs(deadThrottled) <= deadZone) ? 1 : 0;
+            batch.distances[i] = qBound(0.0f, distance, 1.0f);
+        }
+    }
+
+#ifdef AXISBATCH_HAVE_SSE2
+    static inline __m128i selectSSE2(__m128i mask, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    static inline __m128i absSSE2(__m128i value)
+    {
+        __m128i sign = _mm_srai_epi32(value, 31);
+        return _mm_sub_epi32(_mm_xor_si128(value, sign), sign);
+    }
+
+    // Division by two rounding toward zero like the integer division
+    // used by JoyAxis.
+    static inline __m128i halveSSE2(__m128i value)
+    {
+        return _mm_srai_epi32(_mm_add_epi32(value, _mm_srli_epi32(value, 31)), 1);
+    }
+
+    static inline __m128i throttleSSE2(__m128i value, __m128i throttle,
+                                       __m128i minCal, __m128i maxCal)
+    {
+        __m128i absValue = absSSE2(value);
+        __m128i result = value;
+
+        result = selectSSE2(_mm_cmpeq_epi32(throttle, _mm_set1_epi32(negativeHalfThrottle)),
+                            _mm_sub_epi32(_mm_setzero_si128(), absValue), result);
+        result = selectSSE2(_mm_cmpeq_epi32(throttle, _mm_set1_epi32(negativeThrottle)),
+                            halveSSE2(_mm_add_epi32(value, minCal)), result);
+        result = selectSSE2(_mm_cmpeq_epi32(throttle, _mm_set1_epi32(positiveThrottle)),
+                            halveSSE2(_mm_add_epi32(value, maxCal)), result);
+        result = selectSSE2(_mm_cmpeq_epi32(throttle, _mm_set1_epi32(positiveHalfThrottle)),
+                            absValue, result);
+
+        return result;
+    }
+
+    static int processSSE2(AxisBatch &batch)
+    {
+        const int count = batch.size() & ~3;
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128i flagBit = _mm_set1_epi32(1);
+
+        for (int i = 0; i < count; i += 4)
+        {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.values.constData() + i));
+            __m128i throttle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.throttles.constData() + i));
+            __m128i deadZone = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.deadZones.constData() + i));
+            __m128i maxZone = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.maxZones.constData() + i));
+            __m128i minCal = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.minCals.constData() + i));
+            __m128i maxCal = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.maxCals.constData() + i));
+
+            __m128i clamped = selectSSE2(_mm_cmpgt_epi32(value, maxCal), maxCal, value);
+            clamped = selectSSE2(_mm_cmplt_epi32(clamped, minCal), minCal, clamped);
+
+            __m128i throttled = throttleSSE2(value, throttle, minCal, maxCal);
+            __m128i deadThrottled = absSSE2(throttleSSE2(clamped, throttle, minCal, maxCal));
+            __m128i outsideDeadZone = _mm_cmpgt_epi32(deadThrottled, deadZone);
+            __m128i deadZoneFlag = _mm_andnot_si128(outsideDeadZone, flagBit);
+
+            __m128 distance = _mm_div_ps(_mm_cvtepi32_ps(_mm_sub_epi32(absSSE2(throttled), deadZone)),
+                                         _mm_cvtepi32_ps(_mm_sub_epi32(maxZone, deadZone)));
+            // Operand order matters for NaN handling. Matches qBound.
+            distance = _mm_max_ps(_mm_min_ps(distance, one), zero);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(batch.clampedValues.data() + i), clamped);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(batch.throttledValues.data() + i), throttled);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(batch.deadZoneFlags.data() + i), deadZoneFlag);
+            _mm_storeu_ps(batch.distances.data() + i, distance);
+        }
+
+        return count;
+    }
+#endif
+
+#ifdef AXISBATCH_HAVE_AVX2
+    static inline __m256i halveAVX2(__m256i value)
+    {
+        return _mm256_srai_epi32(_mm256_add_epi32(value, _mm256_srli_epi32(value, 31)), 1);
+    }
+
+    static inline __m256i throttleAVX2(__m256i value, __m256i throttle,
+                                       __m256i minCal, __m256i maxCal)
+    {
+        __m256i absValue = _mm256_abs_epi32(value);
+        __m256i result = value;
+
+        result = _mm256_blendv_epi8(result, _mm256_sub_epi32(_mm256_setzero_si256(), absValue),
+                                    _mm256_cmpeq_epi32(throttle, _mm256_set1_epi32(negativeHalfThrottle)));
+        result = _mm256_blendv_epi8(result, halveAVX2(_mm256_add_epi32(value, minCal)),
+                                    _mm256_cmpeq_epi32(throttle, _mm256_set1_epi32(negativeThrottle)));
+        result = _mm256_blendv_epi8(result, halveAVX2(_mm256_add_epi32(value, maxCal)),
+                                    _mm256_cmpeq_epi32(throttle, _mm256_set1_epi32(positiveThrottle)));
+        result = _mm256_blendv_epi8(result, absValue,
+                                    _mm256_cmpeq_epi32(throttle, _mm256_set1_epi32(positiveHalfThrottle)));
+
+        return result;
+    }
+
+    static int processAVX2(AxisBatch &batch)
+    {
+        const int count = batch.size() & ~7;
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256i flagBit = _mm256_set1_epi32(1);
+
+        for (int i = 0; i < count; i += 8)
+        {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.values.constData() + i));
+            __m256i throttle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.throttles.constData() + i));
+            __m256i deadZone = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.deadZones.constData() + i));
+            __m256i maxZone = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.maxZones.constData() + i));
+            __m256i minCal = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.minCals.constData() + i));
+            __m256i maxCal = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.maxCals.constData() + i));
+
+            __m256i clamped = _mm256_blendv_epi8(value, maxCal, _mm256_cmpgt_epi32(value, maxCal));
+            clamped = _mm256_blendv_epi8(clamped, minCal, _mm256_cmpgt_epi32(minCal, clamped));
+
+            __m256i throttled = throttleAVX2(value, throttle, minCal, maxCal);
+            __m256i deadThrottled = _mm256_abs_epi32(throttleAVX2(clamped, throttle, minCal, maxCal));
+            __m256i outsideDeadZone = _mm256_cmpgt_epi32(deadThrottled, deadZone);
+            __m256i deadZoneFlag = _mm256_andnot_si256(outsideDeadZone, flagBit);
+
+            __m256 distance = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_abs_epi32(throttled), deadZone)),
+                                            _mm256_cvtepi32_ps(_mm256_sub_epi32(maxZone, deadZone)));
+            // Operand order matters for NaN handling. Matches qBound.
+            distance = _mm256_max_ps(_mm256_min_ps(distance, one), zero);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(batch.clampedValues.data() + i), clamped);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(batch.throttledValues.data() + i), throttled);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(batch.deadZoneFlags.data() + i), deadZoneFlag);
+            _mm256_storeu_ps(batch.distances.data() + i, distance);
+        }
+
+        return count;
+    }
+#endif
+
+    void process(AxisBatch &batch)
+    {
+        process(batch, bestKernel());
+    }
+
+    void process(AxisBatch &batch, KernelType kernel)
+    {
+        const int count = batch.size();
+        batch.clampedValues.resize(count);
+        batch.throttledValues.resize(count);
+        batch.deadZoneFlags.resize(count);
+        batch.distances.resize(count);
+
+        int processed = 0;
+
+#ifdef AXISBATCH_HAVE_AVX2
+        if (kernel == AVX2Kernel)
+        {
+            processed = processAVX2(batch);
+        }
+#endif
+
+#ifdef AXISBATCH_HAVE_SSE2
+        if (kernel == SSE2Kernel)
+        {
+            processed = processSSE2(batch);
+        }
+#endif
+
+        Q_UNUSED(kernel);
+
+        // Remaining samples that do not fill a vector register.
+        processScalar(batch, processed);
+    }
+
+    KernelType bestKernel()
+    {
+        KernelType result = ScalarKernel;
+
+#if defined(AXISBATCH_HAVE_AVX2)
+        result = AVX2Kernel;
+#elif defined(AXISBATCH_HAVE_SSE2)
+        result = SSE2Kernel;
+#endif
+
+        return result;
+    }
+
+    bool isKernelAvailable(KernelType kernel)
+    {
+        bool result = (kernel == ScalarKernel);
+
+#ifdef AXISBATCH_HAVE_SSE2
+        result = result || (kernel == SSE2Kernel);
+#endif
+
+#ifdef AXISBATCH_HAVE_AVX2
+        result = result || (kernel == AVX2Kernel);
+#endif
+
+        return result;
+    }
+
+    const char* kernelName(KernelType kernel)
+    {
+        const char *result = "scalar";
+
+        if (kernel == SSE2Kernel)
+        {
+            result = "sse2";
+        }
+        else if (kernel == AVX2Kernel)
+        {
+            result = "avx2";
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,69 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AXISBATCHKERNEL_H
+#define AXISBATCHKERNEL_H
+
+#include <QtGlobal>
+#include <QVector>
+
+/**
+ * @brief Batch evaluation of axis samples. Samples gathered from one
+ *     polling pass are stored as structure of arrays so throttle,
+ *     dead zone, max zone and normalized distance can be computed for
+ *     all of them at once. Results match JoyAxis::calculateThrottledValue,
+ *     JoyAxis::inDeadZone and JoyAxis::getDistanceFromDeadZone.
+ */
+namespace AxisBatchKernel
+{
+    enum KernelType {
+        ScalarKernel = 0,
+        SSE2Kernel,
+        AVX2Kernel
+    };
+
+    struct AxisBatch
+    {
+        // Inputs
+        QVector<qint32> values;
+        QVector<qint32> throttles;
+        QVector<qint32> deadZones;
+        QVector<qint32> maxZones;
+        QVector<qint32> minCals;
+        QVector<qint32> maxCals;
+
+        // Outputs
+        QVector<qint32> clampedValues;
+        QVector<qint32> throttledValues;
+        QVector<qint32> deadZoneFlags;
+        QVector<float> distances;
+
+        int append(int value, int throttle, int deadZone, int maxZone,
+                   int minCal, int maxCal);
+        void clear();
+        int size() const;
+    };
+
+    void process(AxisBatch &batch);
+    void process(AxisBatch &batch, KernelType kernel);
+
+    KernelType bestKernel();
+    bool isKernelAvailable(KernelType kernel);
+    const char* kernelName(KernelType kernel);
+}
+
+#endif // AXISBATCHKERNEL_H
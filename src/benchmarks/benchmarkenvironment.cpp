@@ -0,0 +1,284 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkenvironment.h"
+
+#include "antimicrosettings.h"
+#include "antkeymapper.h"
+#include "eventhandlerfactory.h"
+#include "inputdaemon.h"
+#include "joystick.h"
+#include "joybutton.h"
+
+#include <SDL2/SDL.h>
+
+#include <QSettings>
+
+const int BenchmarkEnvironment::NUMBERDEVICES = 8;
+const int BenchmarkEnvironment::NUMBERAXES = 6;
+const int BenchmarkEnvironment::NUMBERBUTTONS = 16;
+const int BenchmarkEnvironment::NUMBERHATS = 1;
+
+
+/**
+ * @brief Replaces the handler used by the output stage. The factory
+ *     keeps its own handler so key names still resolve as usual.
+ */
+class BenchmarkHandlerInstaller : public EventHandlerFactory
+{
+public:
+    static BaseEventHandler* install(BaseEventHandler *handler)
+    {
+        BaseEventHandler *previous = currentHandler;
+        currentHandler = handler;
+        return previous;
+    }
+};
+
+
+BenchmarkEventHandler::BenchmarkEventHandler(QObject *parent) :
+    BaseEventHandler(parent)
+{
+    numberEvents = 0;
+}
+
+bool BenchmarkEventHandler::init()
+{
+    return true;
+}
+
+bool BenchmarkEventHandler::cleanup()
+{
+    return true;
+}
+
+void BenchmarkEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
+{
+    Q_UNUSED(slot);
+    Q_UNUSED(pressed);
+
+    numberEvents++;
+}
+
+void BenchmarkEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
+{
+    Q_UNUSED(slot);
+    Q_UNUSED(pressed);
+
+    numberEvents++;
+}
+
+void BenchmarkEventHandler::sendMouseEvent(int xDis, int yDis)
+{
+    Q_UNUSED(xDis);
+    Q_UNUSED(yDis);
+
+    numberEvents++;
+}
+
+void BenchmarkEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    Q_UNUSED(vertical);
+    Q_UNUSED(horizontal);
+
+    numberEvents++;
+}
+
+void BenchmarkEventHandler::sendKeystrokeStep(quint32 step)
+{
+    Q_UNUSED(step);
+
+    numberEvents++;
+}
+
+QString BenchmarkEventHandler::getName()
+{
+    return QString("Benchmark");
+}
+
+QString BenchmarkEventHandler::getIdentifier()
+{
+    return QString("benchmark");
+}
+
+qint64 BenchmarkEventHandler::getNumberEvents() const
+{
+    return numberEvents;
+}
+
+
+BenchmarkEnvironment::BenchmarkEnvironment()
+{
+    settings = nullptr;
+    daemon = nullptr;
+    previousHandler = nullptr;
+    sdlStarted = false;
+}
+
+BenchmarkEnvironment::~BenchmarkEnvironment()
+{
+    if (daemon != nullptr)
+    {
+        // The event reader of the daemon shuts SDL down.
+        daemon->quit();
+        daemon->deleteJoysticks();
+        delete daemon;
+        daemon = nullptr;
+    }
+    else if (sdlStarted)
+    {
+        SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+    }
+
+    if (settings != nullptr)
+    {
+        delete settings;
+        settings = nullptr;
+    }
+
+    BenchmarkHandlerInstaller::install(previousHandler);
+}
+
+/**
+ * @brief Attach the virtual joysticks, let an InputDaemon open them and
+ *     route output to the counting handler. An event handler factory
+ *     and key mapper have to exist already.
+ * @return Whether the environment is usable
+ */
+bool BenchmarkEnvironment::init()
+{
+    bool result = tempDir.isValid();
+    if (!result)
+    {
+        errorString = QString("Could not create a temporary directory");
+    }
+
+    if (result)
+    {
+        settings = new AntiMicroSettings(tempDir.filePath("antimicro_settings.ini"), QSettings::IniFormat);
+
+        // Virtual devices have to exist before the daemon scans for
+        // devices. SDL keeps count of the init calls.
+        result = SDL_InitSubSystem(SDL_INIT_JOYSTICK) == 0;
+        sdlStarted = result;
+        if (!result)
+        {
+            errorString = QString("SDL_InitSubSystem failed: %1").arg(SDL_GetError());
+        }
+    }
+
+    for (int i = 0; result && (i < NUMBERDEVICES); i++)
+    {
+        int index = SDL_JoystickAttachVirtual(SDL_JOYSTICK_TYPE_UNKNOWN, NUMBERAXES,
+                                              NUMBERBUTTONS, NUMBERHATS);
+        result = index >= 0;
+        if (result)
+        {
+            deviceIndexes.append(index);
+            deviceIDs.append(SDL_JoystickGetDeviceInstanceID(index));
+        }
+        else
+        {
+            errorString = QString("SDL_JoystickAttachVirtual failed: %1").arg(SDL_GetError());
+        }
+    }
+
+    if (result)
+    {
+        daemon = new InputDaemon(&daemonDevices, settings, false);
+
+        for (int i = 0; result && (i < deviceIDs.size()); i++)
+        {
+            result = daemonDevices.contains(deviceIDs.at(i));
+        }
+
+        if (!result)
+        {
+            errorString = QString("InputDaemon did not open the virtual joysticks");
+        }
+
+        // Drop the device added events of the virtual joysticks.
+        SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    }
+
+    if (result)
+    {
+        previousHandler = BenchmarkHandlerInstaller::install(&handler);
+    }
+
+    return result;
+}
+
+QString BenchmarkEnvironment::getErrorString() const
+{
+    return errorString;
+}
+
+AntiMicroSettings* BenchmarkEnvironment::getSettings()
+{
+    return settings;
+}
+
+InputDaemon* BenchmarkEnvironment::getDaemon()
+{
+    return daemon;
+}
+
+QMap<SDL_JoystickID, InputDevice*>* BenchmarkEnvironment::getDaemonDevices()
+{
+    return &daemonDevices;
+}
+
+BenchmarkEventHandler* BenchmarkEnvironment::getHandler()
+{
+    return &handler;
+}
+
+QList<SDL_JoystickID> BenchmarkEnvironment::getDeviceIDs() const
+{
+    return deviceIDs;
+}
+
+/**
+ * @brief Create a Joystick for one of the virtual devices that is not
+ *     tracked by the daemon. The caller owns the object.
+ * @param Index of the virtual device
+ */
+Joystick* BenchmarkEnvironment::createJoystick(int device)
+{
+    int index = deviceIndexes.at(device);
+    return new Joystick(SDL_JoystickOpen(index), index, settings);
+}
+
+QString BenchmarkEnvironment::filePath(const QString &name) const
+{
+    return tempDir.filePath(name);
+}
+
+/**
+ * @brief Append keyboard slots cycling through the letter keys.
+ */
+void BenchmarkEnvironment::assignKeyboardSlots(JoyButton *button, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int qtKey = Qt::Key_A + (i % 26);
+        int code = AntKeyMapper::getInstance()->returnVirtualKey(qtKey);
+        button->setAssignedSlot(code, qtKey, JoyButtonSlot::JoyKeyboard);
+    }
+}
@@ -0,0 +1,109 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BENCHMARKENVIRONMENT_H
+#define BENCHMARKENVIRONMENT_H
+
+#include "eventhandlers/baseeventhandler.h"
+
+#include <SDL2/SDL_joystick.h>
+
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QTemporaryDir>
+
+class AntiMicroSettings;
+class InputDaemon;
+class InputDevice;
+class Joystick;
+class JoyButton;
+
+
+/**
+ * @brief Output backend that only counts what it is asked to send. Lets
+ *     the benchmarks measure the event processing of antimicro without
+ *     the cost of a real backend.
+ */
+class BenchmarkEventHandler : public BaseEventHandler
+{
+public:
+    explicit BenchmarkEventHandler(QObject *parent = nullptr);
+
+    virtual bool init();
+    virtual bool cleanup();
+    virtual void sendKeyboardEvent(JoyButtonSlot *slot, bool pressed);
+    virtual void sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed);
+    virtual void sendMouseEvent(int xDis, int yDis);
+    virtual void sendMouseWheelEvent(int vertical, int horizontal);
+    virtual void sendKeystrokeStep(quint32 step);
+
+    virtual QString getName();
+    virtual QString getIdentifier();
+
+    qint64 getNumberEvents() const;
+
+private:
+    qint64 numberEvents;
+};
+
+/**
+ * @brief Devices and settings shared by the benchmarks. Controllers are
+ *     SDL virtual joysticks, so no hardware is needed. An InputDaemon
+ *     owns one Joystick per virtual device; benchmarks that change
+ *     element assignments create their own Joystick objects instead.
+ */
+class BenchmarkEnvironment
+{
+public:
+    BenchmarkEnvironment();
+    ~BenchmarkEnvironment();
+
+    bool init();
+    QString getErrorString() const;
+
+    AntiMicroSettings* getSettings();
+    InputDaemon* getDaemon();
+    QMap<SDL_JoystickID, InputDevice*>* getDaemonDevices();
+    BenchmarkEventHandler* getHandler();
+    QList<SDL_JoystickID> getDeviceIDs() const;
+
+    Joystick* createJoystick(int device);
+    QString filePath(const QString &name) const;
+
+    static void assignKeyboardSlots(JoyButton *button, int count);
+
+    static const int NUMBERDEVICES;
+    static const int NUMBERAXES;
+    static const int NUMBERBUTTONS;
+    static const int NUMBERHATS;
+
+private:
+    QTemporaryDir tempDir;
+    AntiMicroSettings *settings;
+    InputDaemon *daemon;
+    QMap<SDL_JoystickID, InputDevice*> daemonDevices;
+    QList<int> deviceIndexes;
+    QList<SDL_JoystickID> deviceIDs;
+    BenchmarkEventHandler handler;
+    BaseEventHandler *previousHandler;
+    QString errorString;
+    bool sdlStarted;
+};
+
+#endif // BENCHMARKENVIRONMENT_H
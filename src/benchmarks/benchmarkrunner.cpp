@@ -0,0 +1,302 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkrunner.h"
+
+#include <QDateTime>
+#include <QHostInfo>
+#include <QThread>
+#include <QTextStream>
+#include <QCoreApplication>
+
+#include <ctime>
+#include <algorithm>
+
+const double BenchmarkRunner::DEFAULTMINIMUMTIME = 0.5;
+const int BenchmarkRunner::DEFAULTREPETITIONS = 5;
+const qint64 BenchmarkRunner::MAXITERATIONS = 1000000000;
+
+static qint64 processCpuTime()
+{
+    return static_cast<qint64>((static_cast<double>(std::clock()) * 1000000000.0) / CLOCKS_PER_SEC);
+}
+
+static double median(QList<double> values)
+{
+    std::sort(values.begin(), values.end());
+    int middle = values.size() / 2;
+    double result = values.at(middle);
+    if ((values.size() % 2) == 0)
+    {
+        result = (result + values.at(middle - 1)) / 2.0;
+    }
+
+    return result;
+}
+
+
+BenchmarkState::BenchmarkState(qint64 iterations)
+{
+    this->iterations = iterations;
+    remaining = iterations;
+    started = false;
+    running = false;
+    cpuStart = 0;
+    realTime = 0;
+    cpuTime = 0;
+    itemsProcessed = 0;
+}
+
+/**
+ * @brief Stop the clocks, for example while the next input batch is
+ *     generated.
+ */
+void BenchmarkState::pauseTiming()
+{
+    if (running)
+    {
+        realTime += realTimer.nsecsElapsed();
+        cpuTime += processCpuTime() - cpuStart;
+        running = false;
+    }
+}
+
+void BenchmarkState::resumeTiming()
+{
+    if (!running)
+    {
+        running = true;
+        cpuStart = processCpuTime();
+        realTimer.start();
+    }
+}
+
+qint64 BenchmarkState::getIterations() const
+{
+    return iterations;
+}
+
+qint64 BenchmarkState::getRealTime() const
+{
+    return realTime;
+}
+
+qint64 BenchmarkState::getCpuTime() const
+{
+    return cpuTime;
+}
+
+/**
+ * @brief Set the number of items handled by the whole run. Used for the
+ *     items_per_second rate when one iteration handles several events.
+ */
+void BenchmarkState::setItemsProcessed(qint64 items)
+{
+    itemsProcessed = items;
+}
+
+qint64 BenchmarkState::getItemsProcessed() const
+{
+    return itemsProcessed;
+}
+
+void BenchmarkState::setLabel(const QString &label)
+{
+    this->label = label;
+}
+
+QString BenchmarkState::getLabel() const
+{
+    return label;
+}
+
+
+BenchmarkRunner::BenchmarkRunner()
+{
+    minimumTime = DEFAULTMINIMUMTIME;
+    repetitions = DEFAULTREPETITIONS;
+}
+
+void BenchmarkRunner::add(const QString &name, Function function)
+{
+    Entry entry;
+    entry.name = name;
+    entry.function = function;
+    entries.append(entry);
+}
+
+QStringList BenchmarkRunner::getNames() const
+{
+    QStringList result;
+    QListIterator<Entry> iter(entries);
+    while (iter.hasNext())
+    {
+        result.append(iter.next().name);
+    }
+
+    return result;
+}
+
+void BenchmarkRunner::setFilter(const QRegularExpression &filter)
+{
+    this->filter = filter;
+}
+
+void BenchmarkRunner::setMinimumTime(double seconds)
+{
+    if (seconds > 0.0)
+    {
+        minimumTime = seconds;
+    }
+}
+
+void BenchmarkRunner::setRepetitions(int repetitions)
+{
+    if (repetitions > 0)
+    {
+        this->repetitions = repetitions;
+    }
+}
+
+/**
+ * @brief Run every benchmark that matches the filter. Progress is
+ *     printed on stderr so the JSON output can go to stdout.
+ * @return Results in Google Benchmark layout
+ */
+QJsonArray BenchmarkRunner::run()
+{
+    QJsonArray results;
+    QTextStream errorStream(stderr);
+
+    QListIterator<Entry> iter(entries);
+    while (iter.hasNext())
+    {
+        const Entry &entry = iter.next();
+        if (filter.pattern().isEmpty() || filter.match(entry.name).hasMatch())
+        {
+            QJsonObject result = runEntry(entry);
+            results.append(result);
+
+            errorStream << QString("%1 %2 ns %3 iterations").arg(entry.name, -48)
+                           .arg(result.value("real_time").toDouble(), 12, 'f', 1)
+                           .arg(result.value("iterations").toDouble(), 12, 'f', 0) << endl;
+        }
+    }
+
+    return results;
+}
+
+/**
+ * @brief Describe the machine the results were taken on.
+ */
+QJsonObject BenchmarkRunner::createContext()
+{
+    QJsonObject context;
+    context.insert("date", QDateTime::currentDateTime().toString(Qt::ISODate));
+    context.insert("host_name", QHostInfo::localHostName());
+    context.insert("executable", QCoreApplication::applicationFilePath());
+    context.insert("num_cpus", QThread::idealThreadCount());
+#ifdef QT_NO_DEBUG
+    context.insert("library_build_type", QString("release"));
+#else
+    context.insert("library_build_type", QString("debug"));
+#endif
+
+    return context;
+}
+
+/**
+ * @brief Find an iteration count for which one run takes at least the
+ *     minimum time. Each step grows by at most ten times the last guess.
+ */
+qint64 BenchmarkRunner::calibrate(const Entry &entry)
+{
+    qint64 iterations = 1;
+    qint64 minimumNanos = static_cast<qint64>(minimumTime * 1000000000.0);
+    bool done = false;
+
+    while (!done)
+    {
+        BenchmarkState state(iterations);
+        entry.function(state);
+
+        qint64 elapsed = qMax(state.getRealTime(), Q_INT64_C(1));
+        if ((elapsed >= minimumNanos) || (iterations >= MAXITERATIONS))
+        {
+            done = true;
+        }
+        else
+        {
+            double predicted = (iterations * 1.4 * minimumNanos) / elapsed;
+            qint64 next = static_cast<qint64>(qMin(predicted, iterations * 10.0));
+            iterations = qMin(qMax(next, iterations + 1), MAXITERATIONS);
+        }
+    }
+
+    return iterations;
+}
+
+QJsonObject BenchmarkRunner::runEntry(const Entry &entry)
+{
+    qint64 iterations = calibrate(entry);
+
+    QList<double> realTimes;
+    QList<double> cpuTimes;
+    double minimumRealTime = 0.0;
+    qint64 itemsProcessed = 0;
+    qint64 totalRealTime = 0;
+    QString label;
+
+    for (int i = 0; i < repetitions; i++)
+    {
+        BenchmarkState state(iterations);
+        entry.function(state);
+
+        double realTime = static_cast<double>(state.getRealTime()) / iterations;
+        realTimes.append(realTime);
+        cpuTimes.append(static_cast<double>(state.getCpuTime()) / iterations);
+        minimumRealTime = (i == 0) ? realTime : qMin(minimumRealTime, realTime);
+
+        itemsProcessed += state.getItemsProcessed();
+        totalRealTime += state.getRealTime();
+        label = state.getLabel();
+    }
+
+    QJsonObject result;
+    result.insert("name", entry.name);
+    result.insert("run_name", entry.name);
+    result.insert("run_type", QString("iteration"));
+    result.insert("repetitions", repetitions);
+    result.insert("iterations", static_cast<double>(iterations));
+    result.insert("real_time", median(realTimes));
+    result.insert("cpu_time", median(cpuTimes));
+    result.insert("real_time_min", minimumRealTime);
+    result.insert("time_unit", QString("ns"));
+
+    if ((itemsProcessed > 0) && (totalRealTime > 0))
+    {
+        result.insert("items_per_second", (itemsProcessed * 1000000000.0) / totalRealTime);
+    }
+
+    if (!label.isEmpty())
+    {
+        result.insert("label", label);
+    }
+
+    return result;
+}
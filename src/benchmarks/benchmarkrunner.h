@@ -0,0 +1,135 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QList>
+#include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <functional>
+
+/**
+ * @brief Timing state handed to a benchmark body. The measured work runs
+ *     once per keepRunning() call. Setup done before the loop is not
+ *     timed.
+ */
+class BenchmarkState
+{
+public:
+    explicit BenchmarkState(qint64 iterations);
+
+    inline bool keepRunning()
+    {
+        if (!started)
+        {
+            started = true;
+            resumeTiming();
+        }
+
+        bool result = remaining > 0;
+        if (result)
+        {
+            remaining--;
+        }
+        else
+        {
+            pauseTiming();
+        }
+
+        return result;
+    }
+
+    void pauseTiming();
+    void resumeTiming();
+
+    qint64 getIterations() const;
+    qint64 getRealTime() const;
+    qint64 getCpuTime() const;
+
+    void setItemsProcessed(qint64 items);
+    qint64 getItemsProcessed() const;
+    void setLabel(const QString &label);
+    QString getLabel() const;
+
+private:
+    qint64 iterations;
+    qint64 remaining;
+    bool started;
+    bool running;
+
+    QElapsedTimer realTimer;
+    qint64 cpuStart;
+    qint64 realTime;
+    qint64 cpuTime;
+
+    qint64 itemsProcessed;
+    QString label;
+};
+
+/**
+ * @brief Runs the registered benchmarks and collects the results in the
+ *     JSON layout used by Google Benchmark, so runs from two commits can
+ *     be compared with its tools. Each benchmark is calibrated until one
+ *     run takes the minimum time and the median of the repetitions is
+ *     reported.
+ */
+class BenchmarkRunner
+{
+public:
+    typedef std::function<void (BenchmarkState &state)> Function;
+
+    BenchmarkRunner();
+
+    void add(const QString &name, Function function);
+    QStringList getNames() const;
+
+    void setFilter(const QRegularExpression &filter);
+    void setMinimumTime(double seconds);
+    void setRepetitions(int repetitions);
+
+    QJsonArray run();
+
+    static QJsonObject createContext();
+
+    static const double DEFAULTMINIMUMTIME;
+    static const int DEFAULTREPETITIONS;
+    static const qint64 MAXITERATIONS;
+
+private:
+    struct Entry
+    {
+        QString name;
+        Function function;
+    };
+
+    QJsonObject runEntry(const Entry &entry);
+    qint64 calibrate(const Entry &entry);
+
+    QList<Entry> entries;
+    QRegularExpression filter;
+    double minimumTime;
+    int repetitions;
+};
+
+#endif // BENCHMARKRUNNER_H
@@ -0,0 +1,760 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "inputbenchmarks.h"
+
+#include "benchmarkrunner.h"
+#include "benchmarkenvironment.h"
+#include "inputdaemon.h"
+#include "inputdevice.h"
+#include "joystick.h"
+#include "setjoystick.h"
+#include "joyaxis.h"
+#include "joybuttontypes/joyaxisbutton.h"
+#include "joybutton.h"
+#include "joybuttonslot.h"
+#include "joybuttonslotiterator.h"
+#include "joybuttontypes/joycontrolstickbutton.h"
+#include "joydpad.h"
+#include "joybuttontypes/joydpadbutton.h"
+#include "xmlconfigreader.h"
+#include "xmlconfigwriter.h"
+#include "keytranslationtable.h"
+#include "subpixelaccumulator.h"
+#include "deviceworkerpool.h"
+
+#include "gamecontroller/gamecontrollermotion.h"
+
+#include <SDL2/SDL.h>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QHashIterator>
+#include <QMapIterator>
+#include <QSemaphore>
+#include <QAtomicInt>
+
+#include <cmath>
+
+#ifdef Q_OS_LINUX
+  #include <unistd.h>
+#endif
+
+const int InputBenchmarks::SWEEPSIZE = 256;
+const int InputBenchmarks::GYROSAMPLERATE = 1000;
+
+// Number of sine evaluations done by the synthetic worker pool event.
+// Close to the cost of an axis event that reaches the output stage.
+const int InputBenchmarks::WORKEREVENTCOST = 200;
+
+// Results are written here so the compiler cannot drop the measured work.
+static volatile qint64 benchmarkSink = 0;
+
+// Released once per synthetic event handled on a worker thread.
+static QSemaphore workerEventsDone;
+static QAtomicInt workerEventSink;
+
+
+InputBenchmarks::InputBenchmarks(BenchmarkEnvironment *environment)
+{
+    this->environment = environment;
+    axisSweep = createSweep(SWEEPSIZE, JoyAxis::AXISMAX * 0.8);
+    daemonPrepared = false;
+}
+
+void InputBenchmarks::registerBenchmarks(BenchmarkRunner &runner)
+{
+    runner.add("JoyAxis::joyEvent/keyboard", [this](BenchmarkState &state) { axisEvent(state, false); });
+    runner.add("JoyAxis::joyEvent/mouse", [this](BenchmarkState &state) { axisEvent(state, true); });
+
+    runner.add("JoyControlStick::joyEvent/StandardMode",
+               [this](BenchmarkState &state) { stickEvent(state, JoyControlStick::StandardMode); });
+    runner.add("JoyControlStick::joyEvent/EightWayMode",
+               [this](BenchmarkState &state) { stickEvent(state, JoyControlStick::EightWayMode); });
+    runner.add("JoyControlStick::joyEvent/FourWayCardinal",
+               [this](BenchmarkState &state) { stickEvent(state, JoyControlStick::FourWayCardinal); });
+    runner.add("JoyControlStick::joyEvent/FourWayDiagonal",
+               [this](BenchmarkState &state) { stickEvent(state, JoyControlStick::FourWayDiagonal); });
+
+    runner.add("JoyButton::activateSlots/16", [this](BenchmarkState &state) { buttonMacro(state, 16); });
+    runner.add("JoyButton::activateSlots/256", [this](BenchmarkState &state) { buttonMacro(state, 256); });
+
+    runner.add("JoyButton::moveMouseCursor/2", [this](BenchmarkState &state) { mouseTick(state); });
+
+    for (int numberDevices = 1; numberDevices <= BenchmarkEnvironment::NUMBERDEVICES; numberDevices *= 2)
+    {
+        runner.add(QString("InputDaemon::run/%1_devices").arg(numberDevices),
+                   [this, numberDevices](BenchmarkState &state) { daemonRun(state, numberDevices); });
+    }
+
+    for (int numberDevices = 1; numberDevices <= BenchmarkEnvironment::NUMBERDEVICES; numberDevices *= 2)
+    {
+        runner.add(QString("DeviceWorkerPool::processQueuedEvents/%1_devices").arg(numberDevices),
+                   [this, numberDevices](BenchmarkState &state) { workerPoolRun(state, numberDevices); });
+    }
+
+    runner.add("XMLConfigReader::read/large_profile", [this](BenchmarkState &state) { profileRead(state); });
+
+    runner.add("GameControllerMotion::gyroSample/1kHz_replay", [this](BenchmarkState &state) { gyroReplay(state); });
+
+    runner.add("KeyTranslationTable::value", [this](BenchmarkState &state) { keyTableLookup(state, false); });
+    runner.add("QHash::value", [this](BenchmarkState &state) { keyTableLookup(state, true); });
+
+    runner.add("SubPixelAccumulator::add", [this](BenchmarkState &state) { subPixelAdd(state); });
+}
+
+/**
+ * @brief Load the large profile into a new device and report how much
+ *     the resident set grew. Buttons build their slot records while the
+ *     profile is read, so a second set of records is built afterwards
+ *     and its growth is reported as well. The difference between the two
+ *     is the profile without records, the memory used before buttons kept
+ *     records. Activation throughput is covered by the
+ *     JoyButton::activateSlots benchmarks.
+ */
+QJsonObject InputBenchmarks::measureProfileMemory()
+{
+    QJsonObject result;
+    QString path = getLargeProfilePath();
+    Joystick *joystick = environment->createJoystick(1);
+
+    qint64 rssBefore = residentSetSize();
+
+    XMLConfigReader reader;
+    reader.setFileName(path);
+    reader.configJoystick(joystick);
+
+    qint64 rssAfter = residentSetSize();
+
+    QList<JoyButtonSlotIterator::Records> recordCopies;
+    QListIterator<JoyButton*> buttonIter(joystick->findChildren<JoyButton*>());
+    while (buttonIter.hasNext())
+    {
+        recordCopies.append(JoyButtonSlotIterator::createRecords(*buttonIter.next()->getAssignedSlots()));
+    }
+
+    qint64 rssRecords = residentSetSize();
+
+    result.insert("profile_read", !path.isEmpty() && !reader.hasError());
+    result.insert("slots", joystick->findChildren<JoyButtonSlot*>().size());
+    result.insert("slot_object_bytes", static_cast<int>(sizeof(JoyButtonSlot)));
+    result.insert("slot_record_bytes", static_cast<int>(sizeof(JoyButtonSlotIterator::Record)));
+
+    if ((rssBefore >= 0) && (rssAfter >= 0))
+    {
+        result.insert("rss_kib", rssAfter / 1024);
+        result.insert("rss_growth_kib", (rssAfter - rssBefore) / 1024);
+    }
+
+    if ((rssAfter >= 0) && (rssRecords >= 0))
+    {
+        result.insert("records_rss_kib", (rssRecords - rssAfter) / 1024);
+        result.insert("rss_growth_without_records_kib",
+                      ((rssAfter - rssBefore) - (rssRecords - rssAfter)) / 1024);
+    }
+
+    recordCopies.clear();
+
+    delete joystick;
+    return result;
+}
+
+/**
+ * @brief Sweep one axis back and forth so both axis buttons get pressed
+ *     and released.
+ */
+void InputBenchmarks::axisEvent(BenchmarkState &state, bool mouse)
+{
+    Joystick *joystick = environment->createJoystick(0);
+    JoyAxis *axis = joystick->getActiveSetJoystick()->getJoyAxis(0);
+
+    if (mouse)
+    {
+        axis->getPAxisButton()->setAssignedSlot(JoyButtonSlot::MouseRight, JoyButtonSlot::JoyMouseMovement);
+        axis->getNAxisButton()->setAssignedSlot(JoyButtonSlot::MouseLeft, JoyButtonSlot::JoyMouseMovement);
+    }
+    else
+    {
+        BenchmarkEnvironment::assignKeyboardSlots(axis->getPAxisButton(), 1);
+        BenchmarkEnvironment::assignKeyboardSlots(axis->getNAxisButton(), 1);
+    }
+
+    // The first event is taken as the center of the axis.
+    axis->joyEvent(0);
+
+    int position = 0;
+    while (state.keepRunning())
+    {
+        axis->joyEvent(axisSweep.at(position));
+        position = (position + 1) % axisSweep.size();
+    }
+
+    axis->joyEvent(0);
+    if (mouse)
+    {
+        JoyButton::invokeMouseEvents();
+    }
+
+    state.setItemsProcessed(state.getIterations());
+    delete joystick;
+}
+
+/**
+ * @brief Turn a stick around a full circle with a return to the center
+ *     every few samples so direction changes and releases are included.
+ */
+void InputBenchmarks::stickEvent(BenchmarkState &state, JoyControlStick::JoyMode mode)
+{
+    Joystick *joystick = environment->createJoystick(0);
+    SetJoystick *set = joystick->getActiveSetJoystick();
+    JoyAxis *axisX = set->getJoyAxis(0);
+    JoyAxis *axisY = set->getJoyAxis(1);
+    axisX->joyEvent(0);
+    axisY->joyEvent(0);
+
+    JoyControlStick *stick = new JoyControlStick(axisX, axisY, 0, set->getIndex(), set);
+    set->addControlStick(0, stick);
+    stick->setJoyMode(mode);
+
+    QHashIterator<JoyControlStick::JoyStickDirections, JoyControlStickButton*> iter(*stick->getButtons());
+    while (iter.hasNext())
+    {
+        BenchmarkEnvironment::assignKeyboardSlots(iter.next().value(), 1);
+    }
+
+    const int numberSamples = 72;
+    QVector<int> valuesX;
+    QVector<int> valuesY;
+    for (int i = 0; i < numberSamples; i++)
+    {
+        double radius = ((i % 8) == 7) ? 0.0 : (JoyAxis::AXISMAX * 0.9);
+        double angle = (2.0 * JoyControlStick::PI * i) / numberSamples;
+        valuesX.append(static_cast<int>(radius * cos(angle)));
+        valuesY.append(static_cast<int>(radius * sin(angle)));
+    }
+
+    int position = 0;
+    while (state.keepRunning())
+    {
+        axisX->joyEvent(valuesX.at(position));
+        axisY->joyEvent(valuesY.at(position));
+        stick->activatePendingEvent();
+        position = (position + 1) % numberSamples;
+    }
+
+    axisX->joyEvent(0);
+    axisY->joyEvent(0);
+    stick->activatePendingEvent();
+
+    state.setItemsProcessed(state.getIterations());
+    delete joystick;
+}
+
+/**
+ * @brief Press and release a button holding a long keyboard macro.
+ */
+void InputBenchmarks::buttonMacro(BenchmarkState &state, int numberSlots)
+{
+    Joystick *joystick = environment->createJoystick(0);
+    JoyButton *button = joystick->getActiveSetJoystick()->getJoyButton(0);
+    BenchmarkEnvironment::assignKeyboardSlots(button, numberSlots);
+
+    while (state.keepRunning())
+    {
+        button->joyEvent(true);
+        button->joyEvent(false);
+    }
+
+    state.setItemsProcessed(state.getIterations() * numberSlots);
+    delete joystick;
+}
+
+/**
+ * @brief Run mouse event ticks with two axes held on mouse movement
+ *     slots. Each tick moves the cursor once for both buttons.
+ */
+void InputBenchmarks::mouseTick(BenchmarkState &state)
+{
+    Joystick *joystick = environment->createJoystick(0);
+    SetJoystick *set = joystick->getActiveSetJoystick();
+    JoyAxis *axisX = set->getJoyAxis(0);
+    JoyAxis *axisY = set->getJoyAxis(1);
+
+    axisX->getPAxisButton()->setAssignedSlot(JoyButtonSlot::MouseRight, JoyButtonSlot::JoyMouseMovement);
+    axisY->getPAxisButton()->setAssignedSlot(JoyButtonSlot::MouseDown, JoyButtonSlot::JoyMouseMovement);
+
+    axisX->joyEvent(0);
+    axisY->joyEvent(0);
+    axisX->joyEvent(24000);
+    axisY->joyEvent(16000);
+
+    while (state.keepRunning())
+    {
+        JoyButton::invokeMouseEvents();
+    }
+
+    // Let the buttons leave the pending mouse lists before they go away.
+    axisX->joyEvent(0);
+    axisY->joyEvent(0);
+    JoyButton::invokeMouseEvents();
+
+    state.setItemsProcessed(state.getIterations() * 2);
+    delete joystick;
+}
+
+/**
+ * @brief Give every daemon device a small profile so pushed events reach
+ *     the output stage, and let the daemon settle on centered axes.
+ */
+void InputBenchmarks::prepareDaemonDevices()
+{
+    QMapIterator<SDL_JoystickID, InputDevice*> iter(*environment->getDaemonDevices());
+    while (iter.hasNext())
+    {
+        InputDevice *device = iter.next().value();
+        SetJoystick *set = device->getActiveSetJoystick();
+
+        for (int i = 0; i < set->getNumberAxes(); i++)
+        {
+            JoyAxis *axis = set->getJoyAxis(i);
+            BenchmarkEnvironment::assignKeyboardSlots(axis->getPAxisButton(), 1);
+            BenchmarkEnvironment::assignKeyboardSlots(axis->getNAxisButton(), 1);
+        }
+
+        BenchmarkEnvironment::assignKeyboardSlots(set->getJoyButton(0), 1);
+    }
+
+    pushDaemonBatch(-1, BenchmarkEnvironment::NUMBERDEVICES);
+    environment->getDaemon()->run();
+    QCoreApplication::removePostedEvents(nullptr, QEvent::MetaCall);
+    daemonPrepared = true;
+}
+
+/**
+ * @brief Queue one batch of SDL events for the first daemon devices. A
+ *     negative step queues centered axes and released buttons.
+ * @param Step of the axis sweep
+ * @param Number of devices that get events
+ * @return Number of queued events
+ */
+int InputBenchmarks::pushDaemonBatch(int step, int numberDevices)
+{
+    int result = 0;
+    QList<SDL_JoystickID> deviceIDs = environment->getDeviceIDs();
+    int count = qMin(numberDevices, deviceIDs.size());
+
+    for (int i = 0; i < count; i++)
+    {
+        for (int axis = 0; axis < BenchmarkEnvironment::NUMBERAXES; axis++)
+        {
+            SDL_Event event;
+            SDL_zero(event);
+            event.type = SDL_JOYAXISMOTION;
+            event.jaxis.which = deviceIDs.at(i);
+            event.jaxis.axis = static_cast<Uint8>(axis);
+            event.jaxis.value = (step < 0) ? 0 :
+                static_cast<Sint16>(axisSweep.at((step + (axis * 16) + (i * 8)) % axisSweep.size()));
+            result += SDL_PushEvent(&event) == 1 ? 1 : 0;
+        }
+
+        bool pressed = (step >= 0) && ((step % 2) == 0);
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = pressed ? SDL_JOYBUTTONDOWN : SDL_JOYBUTTONUP;
+        event.jbutton.which = deviceIDs.at(i);
+        event.jbutton.button = 0;
+        event.jbutton.state = pressed ? SDL_PRESSED : SDL_RELEASED;
+        result += SDL_PushEvent(&event) == 1 ? 1 : 0;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Run one polling pass of the daemon per iteration over a batch of
+ *     synthetic events from the given number of devices. Queueing the
+ *     next batch is not timed.
+ */
+void InputBenchmarks::daemonRun(BenchmarkState &state, int numberDevices)
+{
+    InputDaemon *daemon = environment->getDaemon();
+    if (!daemonPrepared)
+    {
+        prepareDaemonDevices();
+    }
+
+    qint64 numberEvents = 0;
+    int step = 0;
+    numberEvents += pushDaemonBatch(step, numberDevices);
+
+    while (state.keepRunning())
+    {
+        daemon->run();
+
+        state.pauseTiming();
+        // run() schedules the next poll of the event reader.
+        QCoreApplication::removePostedEvents(nullptr, QEvent::MetaCall);
+        step++;
+        numberEvents += pushDaemonBatch(step, numberDevices);
+        state.resumeTiming();
+    }
+
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    pushDaemonBatch(-1, numberDevices);
+    daemon->run();
+    QCoreApplication::removePostedEvents(nullptr, QEvent::MetaCall);
+
+    state.setItemsProcessed(numberEvents);
+}
+
+/**
+ * @brief Hand one batch of synthetic events per device to a worker pool
+ *     and wait until the workers are done. The pool itself does not wait,
+ *     so the time of a pass is set by the busiest worker. The label lists
+ *     the number of worker threads.
+ */
+void InputBenchmarks::workerPoolRun(BenchmarkState &state, int numberDevices)
+{
+    DeviceWorkerPool pool(&InputBenchmarks::workerPoolEvent);
+    QList<QObject*> devices;
+    for (int i = 0; i < numberDevices; i++)
+    {
+        QObject *device = new QObject;
+        pool.assignDevice(device);
+        devices.append(device);
+    }
+
+    const int eventsPerDevice = BenchmarkEnvironment::NUMBERAXES + 1;
+    int numberEvents = numberDevices * eventsPerDevice;
+    int step = 0;
+
+    while (state.keepRunning())
+    {
+        for (int i = 0; i < devices.size(); i++)
+        {
+            for (int j = 0; j < eventsPerDevice; j++)
+            {
+                SDL_Event event;
+                SDL_zero(event);
+                event.type = SDL_JOYAXISMOTION;
+                event.jaxis.axis = static_cast<Uint8>(j);
+                event.jaxis.value = static_cast<Sint16>(axisSweep.at((step + (j * 16) + (i * 8)) % axisSweep.size()));
+                pool.queueEvent(devices.at(i), event);
+            }
+        }
+
+        pool.processQueuedEvents();
+        workerEventsDone.acquire(numberEvents);
+        step++;
+    }
+
+    for (int i = 0; i < devices.size(); i++)
+    {
+        pool.releaseDevice(devices.at(i));
+        delete devices.at(i);
+    }
+
+    benchmarkSink = workerEventSink.load();
+    state.setLabel(QString("%1 workers").arg(pool.getNumberWorkers()));
+    state.setItemsProcessed(state.getIterations() * numberEvents);
+}
+
+/**
+ * @brief Write a profile that uses every set and element of a virtual
+ *     device. The file is created once and reused.
+ * @return Path of the profile
+ */
+QString InputBenchmarks::getLargeProfilePath()
+{
+    if (largeProfilePath.isEmpty())
+    {
+        Joystick *joystick = environment->createJoystick(1);
+
+        for (int i = 0; i < InputDevice::NUMBER_JOYSETS; i++)
+        {
+            SetJoystick *set = joystick->getSetJoystick(i);
+            set->setName(QString("Set %1").arg(i + 1));
+
+            JoyControlStick *stick = new JoyControlStick(set->getJoyAxis(0), set->getJoyAxis(1), 0, i, set);
+            set->addControlStick(0, stick);
+            stick->setJoyMode(JoyControlStick::EightWayMode);
+
+            QHashIterator<JoyControlStick::JoyStickDirections, JoyControlStickButton*> iter(*stick->getButtons());
+            while (iter.hasNext())
+            {
+                BenchmarkEnvironment::assignKeyboardSlots(iter.next().value(), 2);
+            }
+
+            for (int j = 2; j < set->getNumberAxes(); j++)
+            {
+                BenchmarkEnvironment::assignKeyboardSlots(set->getJoyAxis(j)->getPAxisButton(), 2);
+                BenchmarkEnvironment::assignKeyboardSlots(set->getJoyAxis(j)->getNAxisButton(), 2);
+            }
+
+            for (int j = 0; j < set->getNumberButtons(); j++)
+            {
+                BenchmarkEnvironment::assignKeyboardSlots(set->getJoyButton(j), 4);
+            }
+
+            for (int j = 0; j < set->getNumberHats(); j++)
+            {
+                QHashIterator<int, JoyDPadButton*> dpadIter(*set->getJoyDPad(j)->getButtons());
+                while (dpadIter.hasNext())
+                {
+                    BenchmarkEnvironment::assignKeyboardSlots(dpadIter.next().value(), 1);
+                }
+            }
+        }
+
+        QString path = environment->filePath("large_profile.amgp");
+        XMLConfigWriter writer;
+        writer.setFileName(path);
+        writer.write(joystick);
+        if (!writer.hasError())
+        {
+            largeProfilePath = path;
+        }
+
+        delete joystick;
+    }
+
+    return largeProfilePath;
+}
+
+/**
+ * @brief Load a large profile into a device. The device is reset between
+ *     reads outside of the timed region.
+ */
+void InputBenchmarks::profileRead(BenchmarkState &state)
+{
+    QString path = getLargeProfilePath();
+    Joystick *joystick = environment->createJoystick(1);
+    bool error = path.isEmpty();
+
+    while (state.keepRunning())
+    {
+        // The reader keeps the file it was given, so use a new one for
+        // every read like the profile loading code does.
+        XMLConfigReader reader;
+        reader.setFileName(path);
+        reader.configJoystick(joystick);
+        error = error || reader.hasError();
+
+        state.pauseTiming();
+        joystick->reset();
+        state.resumeTiming();
+    }
+
+    if (error)
+    {
+        state.setLabel(QString("read failed"));
+    }
+    else
+    {
+        state.setLabel(QString("%1 KiB").arg(QFileInfo(path).size() / 1024));
+    }
+
+    state.setItemsProcessed(state.getIterations());
+    delete joystick;
+}
+
+/**
+ * @brief Replay a synthetic 1 kHz sensor stream. Every sample carries an
+ *     accelerometer and a gyroscope reading.
+ */
+void InputBenchmarks::gyroReplay(BenchmarkState &state)
+{
+    GameControllerMotion motion;
+    motion.setEnabled(true);
+    motion.setHorizontalAxis(GameControllerMotion::PlayerSpaceAxis);
+
+    const int numberSamples = 512;
+    QVector<float> gyroData;
+    QVector<float> accelData;
+    for (int i = 0; i < numberSamples; i++)
+    {
+        double angle = (2.0 * JoyControlStick::PI * i) / numberSamples;
+        gyroData << static_cast<float>(0.8 * sin(angle))
+                 << static_cast<float>(1.2 * cos(angle))
+                 << static_cast<float>(0.3 * sin(angle * 3.0));
+        accelData << static_cast<float>(0.5 * sin(angle)) << 9.7f
+                  << static_cast<float>(0.5 * cos(angle));
+    }
+
+    quint64 timestamp = 0;
+    quint64 interval = 1000000 / GYROSAMPLERATE;
+    qint64 total = 0;
+    int position = 0;
+
+    while (state.keepRunning())
+    {
+        int mouseX = 0;
+        int mouseY = 0;
+        timestamp += interval;
+        motion.accelerometerSample(accelData.constData() + (position * 3), timestamp);
+        motion.gyroSample(gyroData.constData() + (position * 3), timestamp, mouseX, mouseY);
+        total += mouseX + mouseY;
+        position = (position + 1) % numberSamples;
+    }
+
+    benchmarkSink = total;
+    state.setItemsProcessed(state.getIterations());
+}
+
+/**
+ * @brief Look up keys from all three key ranges in a table and in the
+ *     hash it was built from.
+ */
+void InputBenchmarks::keyTableLookup(BenchmarkState &state, bool useHash)
+{
+    QHash<int, int> source = createKeyHash();
+    KeyTranslationTable table;
+    table.build(source);
+
+    QVector<int> keys;
+    QList<int> sourceKeys = source.keys();
+    quint32 seed = 12345;
+    for (int i = 0; i < 1024; i++)
+    {
+        seed = (seed * 1103515245u) + 12345u;
+        keys.append(sourceKeys.at(static_cast<int>((seed >> 8) % static_cast<quint32>(sourceKeys.size()))));
+    }
+
+    qint64 total = 0;
+    int position = 0;
+
+    if (useHash)
+    {
+        while (state.keepRunning())
+        {
+            total += source.value(keys.at(position));
+            position = (position + 1) & 1023;
+        }
+    }
+    else
+    {
+        while (state.keepRunning())
+        {
+            total += table.value(keys.at(position));
+            position = (position + 1) & 1023;
+        }
+    }
+
+    benchmarkSink = total;
+    state.setItemsProcessed(state.getIterations());
+}
+
+void InputBenchmarks::subPixelAdd(BenchmarkState &state)
+{
+    SubPixelAccumulator accumulator;
+    QVector<int> sweep = createSweep(SWEEPSIZE, 3.0 * 1024.0);
+    qint64 total = 0;
+    int position = 0;
+
+    while (state.keepRunning())
+    {
+        total += accumulator.add(sweep.at(position) / 1024.0);
+        position = (position + 1) % sweep.size();
+    }
+
+    benchmarkSink = total;
+    state.setItemsProcessed(state.getIterations());
+}
+
+/**
+ * @brief Synthetic device event for the worker pool benchmark. Does a
+ *     fixed amount of work and reports back to the benchmark thread.
+ */
+void InputBenchmarks::workerPoolEvent(QObject *device, const SDL_Event &event)
+{
+    Q_UNUSED(device);
+
+    double total = 0.0;
+    for (int i = 0; i < WORKEREVENTCOST; i++)
+    {
+        total += sin((event.jaxis.value + i) * 0.001);
+    }
+
+    workerEventSink.fetchAndAddRelaxed(static_cast<int>(total));
+    workerEventsDone.release();
+}
+
+/**
+ * @brief Resident set size of the process.
+ * @return Size in bytes or -1 where it can not be read
+ */
+qint64 InputBenchmarks::residentSetSize()
+{
+    qint64 result = -1;
+
+#ifdef Q_OS_LINUX
+    QFile statm("/proc/self/statm");
+    if (statm.open(QFile::ReadOnly))
+    {
+        QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1)
+        {
+            result = fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+
+        statm.close();
+    }
+#endif
+
+    return result;
+}
+
+/**
+ * @brief One period of a sine wave.
+ */
+QVector<int> InputBenchmarks::createSweep(int count, double amplitude)
+{
+    QVector<int> result;
+    result.reserve(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        double angle = (2.0 * JoyControlStick::PI * i) / count;
+        result.append(static_cast<int>(amplitude * sin(angle)));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Key layout resembling a key mapper table: ASCII keys, custom Qt
+ *     keys and native keys.
+ */
+QHash<int, int> InputBenchmarks::createKeyHash()
+{
+    QHash<int, int> result;
+
+    for (int i = 0x20; i < 0x7F; i++)
+    {
+        result.insert(i, i + 1);
+    }
+
+    for (int i = 0; i < 128; i++)
+    {
+        result.insert(0x01000000 + i, 0x100 + i);
+        result.insert(0x20000000 + i, 0x200 + i);
+    }
+
+    return result;
+}
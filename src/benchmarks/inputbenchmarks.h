@@ -0,0 +1,83 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INPUTBENCHMARKS_H
+#define INPUTBENCHMARKS_H
+
+#include "joycontrolstick.h"
+
+#include <SDL2/SDL_events.h>
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QJsonObject>
+
+class BenchmarkRunner;
+class BenchmarkState;
+class BenchmarkEnvironment;
+
+
+/**
+ * @brief Benchmarks of the input hot paths. Element benchmarks feed
+ *     values straight into the element. The InputDaemon benchmarks push
+ *     synthetic SDL events for 1 to 8 virtual devices and run one polling
+ *     pass per iteration. The DeviceWorkerPool benchmarks run the same
+ *     device counts through the worker threads.
+ */
+class InputBenchmarks
+{
+public:
+    explicit InputBenchmarks(BenchmarkEnvironment *environment);
+
+    void registerBenchmarks(BenchmarkRunner &runner);
+    QJsonObject measureProfileMemory();
+
+    static const int SWEEPSIZE;
+    static const int GYROSAMPLERATE;
+    static const int WORKEREVENTCOST;
+
+protected:
+    void axisEvent(BenchmarkState &state, bool mouse);
+    void stickEvent(BenchmarkState &state, JoyControlStick::JoyMode mode);
+    void buttonMacro(BenchmarkState &state, int numberSlots);
+    void mouseTick(BenchmarkState &state);
+    void daemonRun(BenchmarkState &state, int numberDevices);
+    void workerPoolRun(BenchmarkState &state, int numberDevices);
+    void profileRead(BenchmarkState &state);
+    void gyroReplay(BenchmarkState &state);
+    void keyTableLookup(BenchmarkState &state, bool useHash);
+    void subPixelAdd(BenchmarkState &state);
+
+    void prepareDaemonDevices();
+    int pushDaemonBatch(int step, int numberDevices);
+    QString getLargeProfilePath();
+
+    static QVector<int> createSweep(int count, double amplitude);
+    static QHash<int, int> createKeyHash();
+    static void workerPoolEvent(QObject *device, const SDL_Event &event);
+    static qint64 residentSetSize();
+
+private:
+    BenchmarkEnvironment *environment;
+    QVector<int> axisSweep;
+    bool daemonPrepared;
+    QString largeProfilePath;
+};
+
+#endif // INPUTBENCHMARKS_H
@@ -0,0 +1,221 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmarkrunner.h"
+#include "benchmarkenvironment.h"
+#include "inputbenchmarks.h"
+#include "stickdirectioncheck.h"
+
+#include "messagehandler.h"
+#include "logger.h"
+#include "common.h"
+#include "eventhandlerfactory.h"
+#include "antkeymapper.h"
+#include "inputdevice.h"
+#include "setjoystick.h"
+#include "joybutton.h"
+#include "joybuttonslot.h"
+
+#include <SDL2/SDL.h>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+
+
+/**
+ * @brief Runs the input benchmarks against virtual SDL joysticks and
+ *     writes the results as JSON to stdout or to a file.
+ */
+int main(int argc, char *argv[])
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    // Widgets are only needed for the screen geometry used by mouse code.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication benchapp(argc, argv);
+    QCoreApplication::setApplicationName("antimicro_bench");
+    QCoreApplication::setApplicationVersion(PadderCommon::programVersion);
+
+    qRegisterMetaType<JoyButtonSlot*>();
+    qRegisterMetaType<SetJoystick*>();
+    qRegisterMetaType<InputDevice*>();
+    qRegisterMetaType<QThread*>();
+    qRegisterMetaType<SDL_JoystickID>("SDL_JoystickID");
+    qRegisterMetaType<JoyButtonSlot::JoySlotInputAction>("JoyButtonSlot::JoySlotInputAction");
+
+    QTextStream outstream(stdout);
+    QTextStream errorstream(stderr);
+    Logger appLogger(&errorstream, &errorstream);
+    appLogger.setLogLevel(Logger::LOG_WARNING);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks of the antimicro input paths.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption filterOption("filter", "Only run benchmarks matching <regex>.", "regex");
+    QCommandLineOption outputOption("output", "Write the JSON report to <file> instead of stdout.", "file");
+    QCommandLineOption minTimeOption("min-time", "Minimum time in seconds of one repetition.", "seconds",
+                                     QString::number(BenchmarkRunner::DEFAULTMINIMUMTIME));
+    QCommandLineOption repetitionsOption("repetitions", "Number of repetitions of each benchmark.", "count",
+                                         QString::number(BenchmarkRunner::DEFAULTREPETITIONS));
+    QCommandLineOption listOption("list", "List the benchmarks and exit.");
+    QCommandLineOption skipChecksOption("skip-checks", "Do not run the self-checks before the benchmarks.");
+    parser.addOption(filterOption);
+    parser.addOption(outputOption);
+    parser.addOption(minTimeOption);
+    parser.addOption(repetitionsOption);
+    parser.addOption(listOption);
+    parser.addOption(skipChecksOption);
+    parser.process(benchapp);
+
+    // The factory provides key names for slots. Its handler is never
+    // initialized, output goes to the counting handler of the environment.
+#ifdef WITH_UINPUT
+    QString eventGeneratorIdentifier = QString("uinput");
+#else
+    QString eventGeneratorIdentifier = EventHandlerFactory::fallBackIdentifier();
+#endif
+    EventHandlerFactory::getInstance(eventGeneratorIdentifier);
+    AntKeyMapper::getInstance(eventGeneratorIdentifier);
+    PadderCommon::mouseHelperObj.initDeskWid();
+
+    int result = 0;
+    BenchmarkEnvironment *environment = new BenchmarkEnvironment();
+
+    if (!environment->init())
+    {
+        errorstream << QString("Could not set up the benchmark environment: %1")
+                       .arg(environment->getErrorString()) << endl;
+        result = 1;
+    }
+    else
+    {
+        BenchmarkRunner runner;
+        InputBenchmarks benchmarks(environment);
+        benchmarks.registerBenchmarks(runner);
+
+        if (parser.isSet(filterOption))
+        {
+            runner.setFilter(QRegularExpression(parser.value(filterOption)));
+        }
+
+        runner.setMinimumTime(parser.value(minTimeOption).toDouble());
+        runner.setRepetitions(parser.value(repetitionsOption).toInt());
+
+        if (parser.isSet(listOption))
+        {
+            outstream << runner.getNames().join("\n") << endl;
+        }
+        else
+        {
+            QJsonObject selfChecks;
+            if (!parser.isSet(skipChecksOption))
+            {
+                // The stick direction tables must resolve every input like
+                // the comparison code they replace.
+                qint64 comparisons = 0;
+                QStringList mismatches;
+                bool passed = StickDirectionCheck::run(environment, comparisons, mismatches);
+
+                QJsonObject stickCheck;
+                stickCheck.insert("comparisons", comparisons);
+                stickCheck.insert("passed", passed);
+                selfChecks.insert("stick_direction_tables", stickCheck);
+
+                if (!passed)
+                {
+                    errorstream << "Stick direction tables do not match the reference:" << endl;
+                    errorstream << mismatches.join("\n") << endl;
+                    result = 1;
+                }
+            }
+
+            QJsonObject context = BenchmarkRunner::createContext();
+            context.insert("antimicro_version", PadderCommon::programVersion);
+            context.insert("qt_version", QString(qVersion()));
+
+            SDL_version sdlVersion;
+            SDL_GetVersion(&sdlVersion);
+            context.insert("sdl_version", QString("%1.%2.%3").arg(sdlVersion.major)
+                           .arg(sdlVersion.minor).arg(sdlVersion.patch));
+
+            QJsonArray buildOptions;
+#ifdef USE_AXIS_BATCH
+            buildOptions.append(QString("USE_AXIS_BATCH"));
+#endif
+#ifdef USE_DEVICE_WORKERS
+            buildOptions.append(QString("USE_DEVICE_WORKERS"));
+#endif
+            context.insert("build_options", buildOptions);
+            context.insert("self_checks", selfChecks);
+
+            // Measured before the benchmarks so their allocations do
+            // not count.
+            context.insert("profile_memory", benchmarks.measureProfileMemory());
+
+            // Failed checks are reported without timing the broken code.
+            QJsonObject report;
+            report.insert("context", context);
+            report.insert("benchmarks", (result == 0) ? runner.run() : QJsonArray());
+
+            QByteArray data = QJsonDocument(report).toJson();
+            if (parser.isSet(outputOption))
+            {
+                QFile outputFile(parser.value(outputOption));
+                if (outputFile.open(QFile::WriteOnly | QFile::Truncate))
+                {
+                    outputFile.write(data);
+                    outputFile.close();
+                }
+                else
+                {
+                    errorstream << QString("Could not write %1").arg(outputFile.fileName()) << endl;
+                    result = 1;
+                }
+            }
+            else
+            {
+                outstream << data;
+                outstream.flush();
+            }
+        }
+    }
+
+    // Nothing should be left pressed once the devices are gone.
+    JoyButton::releaseAllPressedKeys();
+
+    delete environment;
+    environment = nullptr;
+
+    PadderCommon::mouseHelperObj.deleteDeskWid();
+    AntKeyMapper::getInstance()->deleteInstance();
+    EventHandlerFactory::getInstance()->deleteInstance();
+
+    return result;
+}
@@ -0,0 +1,199 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "stickdirectioncheck.h"
+
+#include "benchmarkenvironment.h"
+#include "joystick.h"
+#include "setjoystick.h"
+#include "joyaxis.h"
+
+#include <cmath>
+
+const int StickDirectionCheck::MAXREPORTEDMISMATCHES = 20;
+const int StickDirectionCheck::GRIDEXTENT = 48;
+
+
+StickDirectionCheck::StickDirectionCheck(JoyAxis *axisX, JoyAxis *axisY, int originset, QObject *parent) :
+    JoyControlStick(axisX, axisY, 0, originset, parent)
+{
+}
+
+/**
+ * @brief Check the tables of a stick for all modes and diagonal ranges.
+ * @param Environment providing the virtual devices
+ * @param Incremented by the number of comparisons made
+ * @param Receives descriptions of the first mismatches
+ * @return Whether all lookups matched the reference
+ */
+bool StickDirectionCheck::run(BenchmarkEnvironment *environment, qint64 &comparisons, QStringList &mismatches)
+{
+    Joystick *joystick = environment->createJoystick(0);
+    SetJoystick *set = joystick->getActiveSetJoystick();
+
+    StickDirectionCheck *stick = new StickDirectionCheck(set->getJoyAxis(0), set->getJoyAxis(1),
+                                                         set->getIndex(), set);
+    set->addControlStick(0, stick);
+
+    QList<JoyMode> modes;
+    modes << StandardMode << EightWayMode << FourWayCardinal << FourWayDiagonal;
+
+    for (int i = 0; i < modes.size(); i++)
+    {
+        stick->setJoyMode(modes.at(i));
+
+        for (int range = 1; range <= 90; range++)
+        {
+            stick->setDiagonalRange(range);
+            stick->verifyCurrentTables(comparisons, mismatches);
+        }
+    }
+
+    delete joystick;
+
+    return mismatches.isEmpty();
+}
+
+/**
+ * @brief Compare both tables against the reference for the current mode
+ *     and diagonal range.
+ */
+void StickDirectionCheck::verifyCurrentTables(qint64 &comparisons, QStringList &mismatches)
+{
+    // Boundaries fall on half degrees. Check each boundary and points
+    // just past it, inside the step and just before the next boundary.
+    static const double offsets[] = {0.0, 1e-7, 0.125, 0.25, 0.375, 0.5 - 1e-7};
+    const int numberOffsets = static_cast<int>(sizeof(offsets) / sizeof(offsets[0]));
+
+    for (int step = 0; step <= 720; step++)
+    {
+        for (int i = 0; i < numberOffsets; i++)
+        {
+            double bearing = (step * 0.5) + offsets[i];
+            if (bearing <= 360.0)
+            {
+                checkBearing(bearing, comparisons, mismatches);
+            }
+        }
+    }
+
+    for (int x = -GRIDEXTENT; x <= GRIDEXTENT; x++)
+    {
+        for (int y = -GRIDEXTENT; y <= GRIDEXTENT; y++)
+        {
+            checkAxes(x, y, comparisons, mismatches);
+        }
+    }
+
+    // Full deflection in quarter degree steps, where integer rounding
+    // puts the bearing closest to the zone boundaries.
+    for (int i = 0; i < (360 * 4); i++)
+    {
+        double angle = (i * 0.25 * PI) / 180.0;
+        int x = static_cast<int>(floor((JoyAxis::AXISMAX * sin(angle)) + 0.5));
+        int y = static_cast<int>(floor((-JoyAxis::AXISMAX * cos(angle)) + 0.5));
+        checkAxes(x, y, comparisons, mismatches);
+    }
+}
+
+void StickDirectionCheck::checkBearing(double bearing, qint64 &comparisons, QStringList &mismatches)
+{
+    JoyStickDirections actual = lookupDirection(bearing);
+    JoyStickDirections expected = referenceDirection(bearing, true);
+    comparisons++;
+    if (actual != expected)
+    {
+        addMismatch(QString("bearing %1").arg(bearing, 0, 'g', 10), actual, expected, mismatches);
+    }
+
+    actual = lookupEventDirection(bearing);
+    expected = referenceDirection(bearing, false);
+    comparisons++;
+    if (actual != expected)
+    {
+        addMismatch(QString("event bearing %1").arg(bearing, 0, 'g', 10), actual, expected, mismatches);
+    }
+}
+
+void StickDirectionCheck::checkAxes(int axisXValue, int axisYValue, qint64 &comparisons, QStringList &mismatches)
+{
+    JoyStickDirections actual = calculateStickDirection(axisXValue, axisYValue);
+    JoyStickDirections expected = referenceDirection(axisXValue, axisYValue);
+    comparisons++;
+    if (actual != expected)
+    {
+        addMismatch(QString("axes %1,%2").arg(axisXValue).arg(axisYValue), actual, expected, mismatches);
+    }
+}
+
+JoyControlStick::JoyStickDirections StickDirectionCheck::referenceDirection(double bearing, bool wholeAngles)
+{
+    JoyStickDirections result = StickCentered;
+    JoyMode mode = getJoyMode();
+
+    if ((mode == StandardMode) || (mode == EightWayMode))
+    {
+        result = standardModeDirectionFromBearing(bearing, wholeAngles);
+    }
+    else if (mode == FourWayCardinal)
+    {
+        result = fourWayCardinalDirectionFromBearing(bearing);
+    }
+    else if (mode == FourWayDiagonal)
+    {
+        result = fourWayDiagonalDirectionFromBearing(bearing);
+    }
+
+    return result;
+}
+
+JoyControlStick::JoyStickDirections StickDirectionCheck::referenceDirection(int axisXValue, int axisYValue)
+{
+    JoyStickDirections result = StickCentered;
+    JoyMode mode = getJoyMode();
+
+    if (mode == StandardMode)
+    {
+        result = determineStandardModeDirection(axisXValue, axisYValue);
+    }
+    else if (mode == EightWayMode)
+    {
+        result = determineEightWayModeDirection(axisXValue, axisYValue);
+    }
+    else if (mode == FourWayCardinal)
+    {
+        result = determineFourWayCardinalDirection(axisXValue, axisYValue);
+    }
+    else if (mode == FourWayDiagonal)
+    {
+        result = determineFourWayDiagonalDirection(axisXValue, axisYValue);
+    }
+
+    return result;
+}
+
+void StickDirectionCheck::addMismatch(const QString &input, JoyStickDirections actual,
+                                      JoyStickDirections expected, QStringList &mismatches)
+{
+    if (mismatches.size() < MAXREPORTEDMISMATCHES)
+    {
+        mismatches.append(QString("mode %1, diagonal range %2, %3: table %4, reference %5")
+                          .arg(getJoyMode()).arg(getDiagonalRange()).arg(input)
+                          .arg(actual).arg(expected));
+    }
+}
@@ -0,0 +1,55 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef STICKDIRECTIONCHECK_H
+#define STICKDIRECTIONCHECK_H
+
+#include "joycontrolstick.h"
+
+#include <QStringList>
+
+class BenchmarkEnvironment;
+
+
+/**
+ * @brief Self-check of the stick direction tables. Compares the table
+ *     lookups with the comparison based reference code for every mode,
+ *     every diagonal range, every half degree bearing step and its edges,
+ *     a dense grid of small axis values and full deflection rays.
+ */
+class StickDirectionCheck : public JoyControlStick
+{
+public:
+    static bool run(BenchmarkEnvironment *environment, qint64 &comparisons, QStringList &mismatches);
+
+    static const int MAXREPORTEDMISMATCHES;
+    static const int GRIDEXTENT;
+
+protected:
+    StickDirectionCheck(JoyAxis *axisX, JoyAxis *axisY, int originset, QObject *parent);
+
+    void verifyCurrentTables(qint64 &comparisons, QStringList &mismatches);
+    void checkBearing(double bearing, qint64 &comparisons, QStringList &mismatches);
+    void checkAxes(int axisXValue, int axisYValue, qint64 &comparisons, QStringList &mismatches);
+    JoyStickDirections referenceDirection(double bearing, bool wholeAngles);
+    JoyStickDirections referenceDirection(int axisXValue, int axisYValue);
+    void addMismatch(const QString &input, JoyStickDirections actual,
+                     JoyStickDirections expected, QStringList &mismatches);
+};
+
+#endif // STICKDIRECTIONCHECK_H
@@ -30,8 +30,8 @@ Calibration::Calibration(QMap<SDL_JoystickID, InputDevice*>* joysticks, QWidget
 
     setWindowTitle(trUtf8("Calibration"));
 
-    sumX = 0;
-    sumY = 0;
+    lastAxisXValue = 0;
+    lastAxisYValue = 0;
     center_calibrated_x = -1;
     center_calibrated_y = -1;
     max_axis_val_x = -1;
@@ -112,8 +112,8 @@ void Calibration::resetSettings()
     switch(msgBox.exec())
     {
         case QMessageBox::Ok:
-        sumX = 0;
-        sumY = 0;
+        lastAxisXValue = 0;
+        lastAxisYValue = 0;
         center_calibrated_x = -1;
         center_calibrated_y = -1;
         max_axis_val_x = -1;
@@ -123,8 +123,8 @@ void Calibration::resetSettings()
         deadzone_calibrated_x = -1;
         deadzone_calibrated_y = -1;
         calibrated = false;
-        x_es_val.clear();
-        y_es_val.clear();
+        statistics.reset();
+        outerCorrectionTable.clear();
 
         joyAxisX->setAxisCenterCal(center_calibrated_x);
         joyAxisY->setAxisCenterCal(center_calibrated_y);
@@ -141,6 +141,7 @@ void Calibration::resetSettings()
         calibrated = false;
         stick->setCalibrationFlag(false);
         stick->setCalibrationSummary(QString());
+        stick->setOuterCorrectionTable(outerCorrectionTable);
 
         update();
         ui->stickStatusBoxWidget->update();
@@ -233,17 +234,12 @@ void Calibration::startCalibration()
             ui->startButton->setText(trUtf8("Start second step"));
             update();
 
-                for (int i = 0; i < x_es_val.count(); i++) {
-                  sumX += x_es_val.values().at(i);
-                }
-
-                for (int i = 0; i < y_es_val.count(); i++) {
-                  sumY += y_es_val.values().at(i);
-                }
+                const AxisStatistics &statsX = statistics.getAxisXStatistics();
+                const AxisStatistics &statsY = statistics.getAxisYStatistics();
 
-                if ((sumX != 0) && (sumY != 0)) {
-                    center_calibrated_x = sumX / x_es_val.count();
-                    center_calibrated_y = sumY / y_es_val.count();
+                if ((statsX.count > 0) && (statsY.count > 0)) {
+                    center_calibrated_x = qRound(statsX.mean);
+                    center_calibrated_y = qRound(statsY.mean);
                 } else {
                     center_calibrated_x = 0;
                     center_calibrated_y = 0;
@@ -255,13 +251,13 @@ void Calibration::startCalibration()
                 QString text = QString();
                 text.append(trUtf8("\n\nCenter X: %1").arg(center_calibrated_x));
                 text.append(trUtf8("\nCenter Y: %1").arg(center_calibrated_y));
+                text.append(trUtf8("\nCenter noise X: %1").arg(statsX.standardDeviation(), 0, 'f', 1));
+                text.append(trUtf8("\nCenter noise Y: %1").arg(statsY.standardDeviation(), 0, 'f', 1));
                 ui->Informations->setText(text);
                 this->text = text;
 
-                x_es_val.clear();
-                y_es_val.clear();
-                sumX = 0;
-                sumY = 0;
+                statistics.reset();
+                outerCorrectionTable.clear();
                 update();
 
                 disconnect(ui->startButton, &QPushButton::clicked, this, nullptr);
@@ -286,39 +282,17 @@ void Calibration::startSecondStep()
             this->setWindowTitle(trUtf8("Calibrating position"));
             update();
 
-            qDebug() << "X_ES_VAL: " << x_es_val.count(QString("-"));
-            qDebug() << "Y_ES_VAL: " << y_es_val.count(QString("-"));
-
+            const AxisStatistics &statsX = statistics.getAxisXStatistics();
+            const AxisStatistics &statsY = statistics.getAxisYStatistics();
 
-            if (enoughProb(x_es_val.count(QString("-")), y_es_val.count(QString("-")))) {
+            qDebug() << "X negative samples: " << statsX.negativeCount;
+            qDebug() << "Y negative samples: " << statsY.negativeCount;
 
-                int min_x = 0;
-                int min_y = 0;
 
-                for (int i = 0; i < x_es_val.count(QString("-")); i++) {
-                  //  if ((abs(x_es_val.values(QString("-")).at(i)) > deadzone_calibrated_x))
-                    if (i > 0) {
-                        if (x_es_val.values(QString("-")).at(i) < x_es_val.values(QString("-")).at(i-1))  {
-                            min_x = x_es_val.values(QString("-")).at(i);
-                        }
-                    } else {
-                        min_x = x_es_val.values(QString("-")).at(i);
-                    }
-                }
-
-                for (int i = 0; i < y_es_val.count(QString("-")); i++) {
-                  //  if ((abs(y_es_val.values(QString("-")).at(i)) > deadzone_calibrated_y))
-                    if (i > 0) {
-                        if (y_es_val.values(QString("-")).at(i) < y_es_val.values(QString("-")).at(i-1))  {
-                            min_y = y_es_val.values(QString("-")).at(i);
-                        }
-                    } else {
-                        min_y = y_es_val.values(QString("-")).at(i);
-                    }
-                }
+            if (enoughProb(statsX.negativeCount, statsY.negativeCount)) {
 
-                min_axis_val_x = min_x;
-                min_axis_val_y = min_y;
+                min_axis_val_x = qMin(statsX.min, 0);
+                min_axis_val_y = qMin(statsY.min, 0);
 
                 QString text = ui->Informations->text();
                 text.append(trUtf8("\n\nX: %1").arg(min_axis_val_x));
@@ -327,10 +301,9 @@ void Calibration::startSecondStep()
                 this->text = text;
                 update();
 
-                x_es_val.clear();
-                y_es_val.clear();
-                sumX = 0;
-                sumY = 0;
+                // Keep the radius histogram so the outer circle is built
+                // from both corners.
+                statistics.resetAxisStatistics();
 
                 disconnect(ui->startButton, &QPushButton::clicked, this, nullptr);
                 connect(ui->startButton, &QPushButton::clicked, this, &Calibration::startLastStep);
@@ -355,35 +328,13 @@ void Calibration::startLastStep()
             ui->startButton->setText(trUtf8("Start final step"));
             update();
 
-            if (enoughProb(x_es_val.count(QString("+")), y_es_val.count(QString("+")))) {
+            const AxisStatistics &statsX = statistics.getAxisXStatistics();
+            const AxisStatistics &statsY = statistics.getAxisYStatistics();
 
-                int max_x = 0;
-                int max_y = 0;
+            if (enoughProb(statsX.positiveCount, statsY.positiveCount)) {
 
-                for (int i = 0; i < x_es_val.count(QString("+")); i++) {
-                  //  if ((x_es_val.values(QString("+")).at(i) > deadzone_calibrated_x))
-                        if (i > 0) {
-                            if (x_es_val.values(QString("+")).at(i) > x_es_val.values(QString("+")).at(i-1))  {
-                                max_x = x_es_val.values(QString("+")).at(i);
-                            }
-                        } else {
-                            max_x = x_es_val.values(QString("+")).at(i);
-                        }
-                }
-
-                for (int i = 0; i < y_es_val.count(QString("+")); i++) {
-                 //   if ((y_es_val.values(QString("+")).at(i) > deadzone_calibrated_y))
-                    if (i > 0) {
-                        if (y_es_val.values(QString("+")).at(i) > y_es_val.values(QString("+")).at(i-1))  {
-                            max_y = y_es_val.values(QString("+")).at(i);
-                        }
-                    } else {
-                        max_y = y_es_val.values(QString("+")).at(i);
-                    }
-                }
-
-                max_axis_val_x = max_x;
-                max_axis_val_y = max_y;
+                max_axis_val_x = qMax(statsX.max, 0);
+                max_axis_val_y = qMax(statsY.max, 0);
 
                 QString text2 = ui->Informations->text();
                 text2.append(trUtf8("\n\nX: %1").arg(max_axis_val_x));
@@ -402,6 +353,11 @@ void Calibration::startLastStep()
                 text3.append(trUtf8("\nrange Y: %1 - %2").arg(min_axis_val_y).arg(max_axis_val_y));
                 text3.append(trUtf8("\n\ndeadzone X: %1").arg(deadzone_calibrated_x));
                 text3.append(trUtf8("\ndeadzone Y: %1").arg(deadzone_calibrated_y));
+
+                outerCorrectionTable = statistics.buildOuterCorrectionTable();
+                text3.append(trUtf8("\n\nouter circle: %1 of %2 directions")
+                             .arg(statistics.getCoveredBins())
+                             .arg(CalibrationStatistics::ANGLEBINS));
                 ui->Informations->setText(text3);
                 this->text = text3;
 
@@ -443,6 +399,7 @@ void Calibration::saveSettings()
       calibrated = true;
       stick->setCalibrationFlag(true);
       stick->setCalibrationSummary(this->text);
+      stick->setOuterCorrectionTable(outerCorrectionTable);
 
       ui->stickStatusBoxWidget->update();
       update();
@@ -480,32 +437,7 @@ bool Calibration::enoughProb(int x_count, int y_count)
 }
 
 /**
- * @brief it's a slot of moving ax Y. Counts positive and negative values for later comparisions
- * @param place for sign "+" or "-". Depends on we want to find max value or min value for ax
- * @param list of moving ax values in positive and negative ways
- * @return min value if sign was "-" or max value if sign was "+"
- */
-int Calibration::chooseMinMax(QString min_max_sign, QList<int> ax_values)
-{
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
-
-    int min_max = 0;
-
-    foreach(int val, ax_values) {
-
-        if (min_max_sign == QString("+")) {
-            if (min_max < val) min_max = val;
-
-        } else {
-            if (min_max > val) min_max = val;
-        }
-    }
-
-    return min_max;
-}
-
-/**
- * @brief it's a slot of moving ax X. Counts positive and negative values for later comparisions
+ * @brief it's a slot of moving ax X. Feeds paired stick samples into running statistics
  * @param value of moving ax
  * @return nothing
  */
@@ -513,18 +445,15 @@ void Calibration::checkX(int value)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    if (value > 0) {
-        if (x_es_val.count(QString("+")) <= 100) x_es_val.insert(QString("+"), value);
-    } else if (value < 0) {
-        if (x_es_val.count(QString("-")) <= 100) x_es_val.insert(QString("-"), value);
-    }
+    lastAxisXValue = value;
+    statistics.addSample(lastAxisXValue, lastAxisYValue);
 
     axisBarX->setValue(value);
     update();
 }
 
 /**
- * @brief it's a slot of moving ax Y. Counts positive and negative values for later comparisions
+ * @brief it's a slot of moving ax Y. Feeds paired stick samples into running statistics
  * @param value of moving ax
  * @return nothing
  */
@@ -532,11 +461,8 @@ void Calibration::checkY(int value)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    if (value > 0) {
-        if (y_es_val.count(QString("+")) <= 100) y_es_val.insert(QString("+"), value);
-    } else if (value < 0) {
-        if (y_es_val.count(QString("-")) <= 100) y_es_val.insert(QString("-"), value);
-    }
+    lastAxisYValue = value;
+    statistics.addSample(lastAxisXValue, lastAxisYValue);
 
     axisBarY->setValue(value);
     update();
@@ -673,6 +599,10 @@ void Calibration::setProgressBars(JoyControlStick* controlstick)
             ui->progressBarsLayout->addLayout(hbox);
             ui->progressBarsLayout->addLayout(hbox2);
 
+            lastAxisXValue = joyAxisX->getCurrentRawValue();
+            lastAxisYValue = joyAxisY->getCurrentRawValue();
+            statistics.reset();
+
             connect(joyAxisX, &JoyAxis::moved, this, &Calibration::checkX);
             connect(joyAxisY, &JoyAxis::moved, this, &Calibration::checkY);
 
@@ -729,6 +659,10 @@ void Calibration::setProgressBars(int inputDevNr, int setJoyNr, int stickNr)
             ui->progressBarsLayout->addLayout(hbox);
             ui->progressBarsLayout->addLayout(hbox2);
 
+            lastAxisXValue = joyAxisX->getCurrentRawValue();
+            lastAxisYValue = joyAxisY->getCurrentRawValue();
+            statistics.reset();
+
             connect(joyAxisX, &JoyAxis::moved, this, &Calibration::checkX);
             connect(joyAxisY, &JoyAxis::moved, this, &Calibration::checkY);
 
@@ -2,13 +2,13 @@
 #define CALIBRATION_H
 
 #include "joycontrolstickeditdialog.h"
+#include "calibrationstatistics.h"
 
 #include <SDL2/SDL_joystick.h>
 
 #include <QWidget>
 #include <QProgressBar>
-#include <QList>
-#include <QHash>
+#include <QVector>
 
 class JoyControlStick;
 class InputDevice;
@@ -25,7 +25,6 @@ public:
     explicit Calibration(QMap<SDL_JoystickID, InputDevice*>* joysticks, QWidget *parent = 0);
     ~Calibration();
 
-    int chooseMinMax(QString min_max_sign, QList<int> ax_values);
     bool ifGtkJstestRunToday();
     const QString getSetfromGtkJstest();
     void setQuadraticZoneCalibrated(int &max_axis_val_x, int &min_axis_val_x, int &max_axis_val_y, int &min_axis_val_y);
@@ -48,8 +47,10 @@ private:
     JoyAxis* joyAxisY;
     QProgressBar *axisBarX;
     QProgressBar *axisBarY;
-    QMultiHash<QString,int> x_es_val;
-    QMultiHash<QString,int> y_es_val;
+    CalibrationStatistics statistics;
+    QVector<double> outerCorrectionTable;
+    int lastAxisXValue;
+    int lastAxisYValue;
     int center_calibrated_x;
     int center_calibrated_y;
     int max_axis_val_x;
@@ -58,8 +59,6 @@ private:
     int min_axis_val_y;
     int deadzone_calibrated_x;
     int deadzone_calibrated_y;
-    int sumX;
-    int sumY;
     bool calibrated;
     QString text;
 
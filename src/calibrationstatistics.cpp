@@ -0,0 +1,251 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "calibrationstatistics.h"
+
+#include <cmath>
+
+// Number of angle bins used for the outer circle histogram. 64 bins give
+// a resolution of 5.625 degrees which is finer than any stick gate.
+const int CalibrationStatistics::ANGLEBINS = 64;
+
+// A bin only counts as covered once the stick was pushed at least half way
+// out in that direction.
+const int CalibrationStatistics::MINOUTERRADIUS = 16384;
+
+// Upper bound of the radial scale factor stored in a correction table.
+const double CalibrationStatistics::MAXCORRECTION = 1.5;
+
+static const double CALIBRATIONPI = acos(-1.0);
+
+
+AxisStatistics::AxisStatistics()
+{
+    reset();
+}
+
+/**
+ * @brief Update running minimum, maximum, mean and variance with a new sample.
+ * @param Raw axis value
+ */
+void AxisStatistics::addSample(int value)
+{
+    if (count == 0)
+    {
+        min = value;
+        max = value;
+    }
+    else
+    {
+        min = qMin(min, value);
+        max = qMax(max, value);
+    }
+
+    if (value > 0)
+    {
+        positiveCount++;
+    }
+    else if (value < 0)
+    {
+        negativeCount++;
+    }
+
+    count++;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+void AxisStatistics::reset()
+{
+    count = 0;
+    positiveCount = 0;
+    negativeCount = 0;
+    min = 0;
+    max = 0;
+    mean = 0.0;
+    m2 = 0.0;
+}
+
+double AxisStatistics::variance() const
+{
+    return (count > 1) ? (m2 / (count - 1)) : 0.0;
+}
+
+double AxisStatistics::standardDeviation() const
+{
+    return sqrt(variance());
+}
+
+
+CalibrationStatistics::CalibrationStatistics() :
+    binMaxRadius(ANGLEBINS, 0),
+    binSamples(ANGLEBINS, 0)
+{
+}
+
+/**
+ * @brief Add a paired stick sample. Both axes statistics and the radius
+ *     histogram are updated in constant time.
+ * @param X axis value
+ * @param Y axis value
+ */
+void CalibrationStatistics::addSample(int axisXValue, int axisYValue)
+{
+    axisXStatistics.addSample(axisXValue);
+    axisYStatistics.addSample(axisYValue);
+
+    if ((axisXValue != 0) || (axisYValue != 0))
+    {
+        double x = axisXValue;
+        double y = axisYValue;
+        int radius = static_cast<int>(sqrt((x * x) + (y * y)));
+        int bin = angleBin(axisXValue, axisYValue);
+
+        binSamples[bin]++;
+        if (radius > binMaxRadius.at(bin))
+        {
+            binMaxRadius[bin] = radius;
+        }
+    }
+}
+
+/**
+ * @brief Clear the per axis statistics while keeping the radius histogram.
+ *     Used between calibration steps so the outer circle keeps growing.
+ */
+void CalibrationStatistics::resetAxisStatistics()
+{
+    axisXStatistics.reset();
+    axisYStatistics.reset();
+}
+
+void CalibrationStatistics::reset()
+{
+    resetAxisStatistics();
+    binMaxRadius.fill(0);
+    binSamples.fill(0);
+}
+
+const AxisStatistics& CalibrationStatistics::getAxisXStatistics() const
+{
+    return axisXStatistics;
+}
+
+const AxisStatistics& CalibrationStatistics::getAxisYStatistics() const
+{
+    return axisYStatistics;
+}
+
+/**
+ * @brief Get the number of angle bins in which the stick reached
+ *     far enough to be used for the outer circle.
+ * @return Number of covered bins
+ */
+int CalibrationStatistics::getCoveredBins() const
+{
+    int covered = 0;
+
+    for (int i = 0; i < ANGLEBINS; i++)
+    {
+        if (binMaxRadius.at(i) >= MINOUTERRADIUS)
+        {
+            covered++;
+        }
+    }
+
+    return covered;
+}
+
+/**
+ * @brief Build a table of radial scale factors, one per angle bin. Each
+ *     factor maps the largest radius observed in that direction onto the
+ *     largest radius observed overall. Bins that were never reached are
+ *     interpolated from the closest covered neighbours.
+ * @return Correction table with ANGLEBINS entries or an empty table
+ *     when less than a quarter of the circle was covered.
+ */
+QVector<double> CalibrationStatistics::buildOuterCorrectionTable() const
+{
+    QVector<double> table;
+
+    if (getCoveredBins() >= (ANGLEBINS / 4))
+    {
+        QVector<double> radius(ANGLEBINS, 0.0);
+        double reference = 0.0;
+
+        for (int i = 0; i < ANGLEBINS; i++)
+        {
+            if (binMaxRadius.at(i) >= MINOUTERRADIUS)
+            {
+                radius[i] = binMaxRadius.at(i);
+                reference = qMax(reference, radius.at(i));
+            }
+        }
+
+        for (int i = 0; i < ANGLEBINS; i++)
+        {
+            if (binMaxRadius.at(i) < MINOUTERRADIUS)
+            {
+                int prev = i;
+                int prevSteps = 0;
+                do
+                {
+                    prev = (prev + ANGLEBINS - 1) % ANGLEBINS;
+                    prevSteps++;
+                } while (binMaxRadius.at(prev) < MINOUTERRADIUS);
+
+                int next = i;
+                int nextSteps = 0;
+                do
+                {
+                    next = (next + 1) % ANGLEBINS;
+                    nextSteps++;
+                } while (binMaxRadius.at(next) < MINOUTERRADIUS);
+
+                double weight = prevSteps / static_cast<double>(prevSteps + nextSteps);
+                radius[i] = binMaxRadius.at(prev) +
+                        ((binMaxRadius.at(next) - binMaxRadius.at(prev)) * weight);
+            }
+        }
+
+        table.resize(ANGLEBINS);
+        for (int i = 0; i < ANGLEBINS; i++)
+        {
+            table[i] = qBound(1.0, reference / radius.at(i), MAXCORRECTION);
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief Map an angle as returned by atan2(x, -y) onto an angle bin.
+ * @param Angle in radians in the range of -PI - PI
+ * @return Bin index in the range of 0 - ANGLEBINS-1
+ */
+int CalibrationStatistics::angleBin(double angle)
+{
+    int bin = static_cast<int>(((angle + CALIBRATIONPI) * ANGLEBINS) / (2.0 * CALIBRATIONPI));
+    return qBound(0, bin, ANGLEBINS - 1);
+}
+
+int CalibrationStatistics::angleBin(int axisXValue, int axisYValue)
+{
+    return angleBin(atan2(static_cast<double>(axisXValue),
+                          -static_cast<double>(axisYValue)));
+}
@@ -0,0 +1,83 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CALIBRATIONSTATISTICS_H
+#define CALIBRATIONSTATISTICS_H
+
+#include <QtGlobal>
+#include <QVector>
+
+/**
+ * @brief Running statistics of a single axis. Mean and variance are
+ *     updated with Welford's method so no samples have to be stored.
+ */
+struct AxisStatistics
+{
+    int count;
+    int positiveCount;
+    int negativeCount;
+    int min;
+    int max;
+    double mean;
+    double m2;
+
+    AxisStatistics();
+
+    void addSample(int value);
+    void reset();
+    double variance() const;
+    double standardDeviation() const;
+};
+
+
+/**
+ * @brief Online statistics of a stick gathered during calibration.
+ *     Besides per axis statistics, the largest radius seen in every
+ *     angle bin is kept so an outer circle correction table can be
+ *     produced once the stick has been moved around its gate.
+ */
+class CalibrationStatistics
+{
+public:
+    CalibrationStatistics();
+
+    void addSample(int axisXValue, int axisYValue);
+    void resetAxisStatistics();
+    void reset();
+
+    const AxisStatistics& getAxisXStatistics() const;
+    const AxisStatistics& getAxisYStatistics() const;
+
+    int getCoveredBins() const;
+    QVector<double> buildOuterCorrectionTable() const;
+
+    static int angleBin(double angle);
+    static int angleBin(int axisXValue, int axisYValue);
+
+    static const int ANGLEBINS;
+    static const int MINOUTERRADIUS;
+    static const double MAXCORRECTION;
+
+private:
+    AxisStatistics axisXStatistics;
+    AxisStatistics axisYStatistics;
+
+    QVector<int> binMaxRadius;
+    QVector<int> binSamples;
+};
+
+#endif // CALIBRATIONSTATISTICS_H
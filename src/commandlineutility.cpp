@@ -48,6 +48,7 @@ CommandLineUtility::CommandLineUtility(QObject *parent) :
     daemonMode = false;
     displayString = "";
     listControllers = false;
+    startupTrace = false;
     mappingController = false;
     currentLogLevel = Logger::LOG_NONE;
 
@@ -62,6 +63,10 @@ void CommandLineUtility::parseArguments(QCommandLineParser* parser) {
 
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    // Checked outside the loop below since it can be combined with any
+    // other option.
+    startupTrace = parser->isSet("startup-trace");
+
     int i = 0;
 
     while ((i < parser->optionNames().count()) && !encounteredError)
@@ -474,6 +479,13 @@ bool CommandLineUtility::shouldMapController()
     return mappingController;
 }
 
+bool CommandLineUtility::isStartupTraceEnabled()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return startupTrace;
+}
+
 QString CommandLineUtility::getEventGenerator()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -136,6 +136,7 @@ public:
     bool isUnloadRequested();
     bool shouldListControllers();
     bool shouldMapController();
+    bool isStartupTraceEnabled();
     bool hasProfileInOptions();
     bool hasError();
 
@@ -171,6 +172,7 @@ private:
     bool daemonMode;
     bool listControllers;
     bool mappingController;
+    bool startupTrace;
 
     int startSetNumber; // unsigned
     int controllerNumber; // unsigned
@@ -178,6 +178,7 @@ namespace PadderCommon
     QMutex sdlWaitMutex;
     QMutex inputDaemonMutex;
     QReadWriteLock editingLock;
+    QMutex outputStageMutex(QMutex::Recursive);
     bool editingBindings = false;
     MouseHelper mouseHelperObj;
 }
@@ -142,6 +142,7 @@ namespace PadderCommon
     extern QMutex inputDaemonMutex;
     extern bool editingBindings;
     extern QReadWriteLock editingLock;
+    extern QMutex outputStageMutex;
     extern MouseHelper mouseHelperObj;
 
     QString preferredProfileDir(AntiMicroSettings *settings);
@@ -153,6 +154,33 @@ namespace PadderCommon
     void lockInputDevices();
     void unlockInputDevices();
 
+    /**
+     * @brief Scoped lock for code that changes output state shared by all
+     *     devices, like the active key lists and the mouse speed lists.
+     *     It is only needed when devices are processed on worker threads
+     *     so other builds do not pay for it.
+     */
+    class OutputStageLocker
+    {
+    public:
+        inline OutputStageLocker()
+        {
+        #ifdef USE_DEVICE_WORKERS
+            outputStageMutex.lock();
+        #endif
+        }
+
+        inline ~OutputStageLocker()
+        {
+        #ifdef USE_DEVICE_WORKERS
+            outputStageMutex.unlock();
+        #endif
+        }
+
+    private:
+        Q_DISABLE_COPY(OutputStageLocker)
+    };
+
     /*!
      * \brief Returns the "human-readable" name of the given profile.
      */
@@ -0,0 +1,324 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "deviceworkerpool.h"
+
+#include "messagehandler.h"
+#include "common.h"
+
+#include <QThread>
+#include <QMutexLocker>
+#include <QMetaObject>
+
+
+const int DeviceWorker::DAEMONLOCKWAIT = 5;
+const int DeviceWorkerPool::MAXWORKERS = 4;
+
+
+DeviceWorker::DeviceWorker(EventFunction eventFunction, QObject *parent) :
+    QObject(parent)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    this->eventFunction = eventFunction;
+    batchScheduled = false;
+}
+
+/**
+ * @brief Add an event to the next batch. Can be called while the worker
+ *     is running the previous batch.
+ * @param Device that produced the event
+ * @param SDL event
+ */
+void DeviceWorker::appendEvent(QObject *device, const SDL_Event &event)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    PendingEvent pending;
+    pending.device = device;
+    pending.event = event;
+
+    QMutexLocker locker(&pendingMutex);
+    pendingEvents.append(pending);
+}
+
+/**
+ * @brief Ask the worker thread to run the collected events. Nothing is
+ *     queued if a batch is already waiting to be started since it will
+ *     pick up the new events as well.
+ */
+void DeviceWorker::scheduleBatch()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&pendingMutex);
+
+    if (!batchScheduled && !pendingEvents.isEmpty())
+    {
+        batchScheduled = true;
+        QMetaObject::invokeMethod(this, "processPendingEvents", Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief Process the events collected up to now. The list is swapped out
+ *     first so the input daemon can keep adding events meanwhile.
+ *     The batch runs under the input daemon mutex like the events that
+ *     are processed on the daemon thread, so editors that take the mutex
+ *     keep event processing out. When the mutex can not be taken soon,
+ *     the batch is posted again instead of blocking the worker. The
+ *     daemon may be waiting on the worker to release a device while it
+ *     holds the mutex.
+ */
+void DeviceWorker::processPendingEvents()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (!PadderCommon::inputDaemonMutex.tryLock(DAEMONLOCKWAIT))
+    {
+        QMetaObject::invokeMethod(this, "processPendingEvents", Qt::QueuedConnection);
+        return;
+    }
+
+    pendingMutex.lock();
+    runningEvents.swap(pendingEvents);
+    batchScheduled = false;
+    pendingMutex.unlock();
+
+    for (int i = 0; i < runningEvents.size(); i++)
+    {
+        const PendingEvent &pending = runningEvents.at(i);
+        eventFunction(pending.device, pending.event);
+    }
+
+    runningEvents.clear();
+
+    PadderCommon::inputDaemonMutex.unlock();
+}
+
+/**
+ * @brief Push a device back to another thread. An object can only be
+ *     moved by the thread it lives in so this has to run on the worker.
+ *     Events of the device that were not started yet are dropped.
+ * @param Device to move
+ * @param Thread that takes over the device
+ */
+void DeviceWorker::releaseDevice(QObject *device, QThread *thread)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    pendingMutex.lock();
+    QMutableVectorIterator<PendingEvent> iter(pendingEvents);
+    while (iter.hasNext())
+    {
+        if (iter.next().device == device)
+        {
+            iter.remove();
+        }
+    }
+    pendingMutex.unlock();
+
+    device->moveToThread(thread);
+}
+
+
+/**
+ * @brief Start the worker threads.
+ * @param Function called for every event on the worker of its device
+ * @param Number of worker threads. defaultNumberWorkers() is used when
+ *     the value is not positive.
+ */
+DeviceWorkerPool::DeviceWorkerPool(DeviceWorker::EventFunction eventFunction,
+                                   int numberWorkers, QObject *parent) :
+    QObject(parent)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (numberWorkers <= 0)
+    {
+        numberWorkers = defaultNumberWorkers();
+    }
+
+    for (int i = 0; i < numberWorkers; i++)
+    {
+        QThread *thread = new QThread;
+        DeviceWorker *worker = new DeviceWorker(eventFunction);
+        worker->moveToThread(thread);
+        connect(thread, &QThread::finished, worker, &DeviceWorker::deleteLater);
+        thread->start(QThread::HighPriority);
+
+        workerThreads.append(thread);
+        workers.append(worker);
+        workerLoads.append(0);
+    }
+}
+
+DeviceWorkerPool::~DeviceWorkerPool()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QListIterator<QThread*> iter(workerThreads);
+    while (iter.hasNext())
+    {
+        QThread *thread = iter.next();
+        thread->quit();
+        thread->wait();
+        delete thread;
+        thread = nullptr;
+    }
+
+    workerThreads.clear();
+    workers.clear();
+}
+
+/**
+ * @brief Leave one core for the SDL reader and the input daemon.
+ * @return Number of worker threads used by default
+ */
+int DeviceWorkerPool::defaultNumberWorkers()
+{
+    return qBound(1, QThread::idealThreadCount() - 1, MAXWORKERS);
+}
+
+int DeviceWorkerPool::getNumberWorkers() const
+{
+    return workers.size();
+}
+
+/**
+ * @brief Move a device to the worker with the fewest devices. A device
+ *     can not keep a parent that lives in another thread so it is
+ *     detached from its parent first. Has to be called from the thread
+ *     the device lives in.
+ * @param Device to assign
+ */
+void DeviceWorkerPool::assignDevice(QObject *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&affinityMutex);
+
+    if (!deviceAffinity.contains(device))
+    {
+        int index = 0;
+        for (int i = 1; i < workerLoads.size(); i++)
+        {
+            if (workerLoads.at(i) < workerLoads.at(index))
+            {
+                index = i;
+            }
+        }
+
+        deviceAffinity.insert(device, index);
+        workerLoads[index]++;
+
+        connect(device, &QObject::destroyed, this,
+                &DeviceWorkerPool::removeDevice, Qt::DirectConnection);
+
+        device->setParent(nullptr);
+        device->moveToThread(workerThreads.at(index));
+    }
+}
+
+/**
+ * @brief Bring a device back to the calling thread so it can be deleted
+ *     or changed there. Waits for the batches already started on the
+ *     worker of the device. Other workers keep running.
+ * @param Device to release
+ */
+void DeviceWorkerPool::releaseDevice(QObject *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    int index = -1;
+
+    affinityMutex.lock();
+    if (deviceAffinity.contains(device))
+    {
+        index = deviceAffinity.take(device);
+        workerLoads[index]--;
+    }
+    affinityMutex.unlock();
+
+    if (index >= 0)
+    {
+        disconnect(device, &QObject::destroyed, this, &DeviceWorkerPool::removeDevice);
+
+        if (device->thread() != QThread::currentThread())
+        {
+            QMetaObject::invokeMethod(workers.at(index), "releaseDevice",
+                                      Qt::BlockingQueuedConnection,
+                                      Q_ARG(QObject*, device),
+                                      Q_ARG(QThread*, QThread::currentThread()));
+        }
+    }
+}
+
+bool DeviceWorkerPool::hasDevice(QObject *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&affinityMutex);
+    return deviceAffinity.contains(device);
+}
+
+/**
+ * @brief Add an event to the batch of the worker that owns the device.
+ *     Unassigned devices are assigned first.
+ * @param Device that produced the event
+ * @param SDL event
+ */
+void DeviceWorkerPool::queueEvent(QObject *device, const SDL_Event &event)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    assignDevice(device);
+
+    affinityMutex.lock();
+    int index = deviceAffinity.value(device);
+    affinityMutex.unlock();
+
+    workers.at(index)->appendEvent(device, event);
+}
+
+/**
+ * @brief Start the batches queued since the last call on their workers.
+ *     The call does not wait for them, so a slow set change or macro on
+ *     one device does not hold up polling for the other devices.
+ */
+void DeviceWorkerPool::processQueuedEvents()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    for (int i = 0; i < workers.size(); i++)
+    {
+        workers.at(i)->scheduleBatch();
+    }
+}
+
+void DeviceWorkerPool::removeDevice(QObject *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&affinityMutex);
+
+    if (deviceAffinity.contains(device))
+    {
+        workerLoads[deviceAffinity.take(device)]--;
+    }
+}
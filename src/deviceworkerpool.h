@@ -0,0 +1,110 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEVICEWORKERPOOL_H
+#define DEVICEWORKERPOOL_H
+
+#include <SDL2/SDL_events.h>
+
+#include <QObject>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+
+class QThread;
+
+/**
+ * @brief Processes the events of the devices assigned to it on its own
+ *     thread. Events are collected by the input daemon during a polling
+ *     pass and handed over in one batch. The daemon does not wait for
+ *     the batch, so events that arrive while one is running are kept
+ *     for the next one.
+ */
+class DeviceWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef void (*EventFunction)(QObject *device, const SDL_Event &event);
+
+    explicit DeviceWorker(EventFunction eventFunction, QObject *parent = nullptr);
+
+    void appendEvent(QObject *device, const SDL_Event &event);
+    void scheduleBatch();
+
+    static const int DAEMONLOCKWAIT;
+
+public slots:
+    void processPendingEvents();
+    void releaseDevice(QObject *device, QThread *thread);
+
+private:
+    struct PendingEvent
+    {
+        QObject *device;
+        SDL_Event event;
+    };
+
+    EventFunction eventFunction;
+    QMutex pendingMutex;
+    QVector<PendingEvent> pendingEvents;
+    QVector<PendingEvent> runningEvents;
+    bool batchScheduled;
+};
+
+
+/**
+ * @brief Small pool of device worker threads. A device stays on the
+ *     worker it was first assigned to so its events are processed in
+ *     order and its timers keep firing on one thread.
+ */
+class DeviceWorkerPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DeviceWorkerPool(DeviceWorker::EventFunction eventFunction,
+                              int numberWorkers = 0, QObject *parent = nullptr);
+    ~DeviceWorkerPool();
+
+    void assignDevice(QObject *device);
+    void releaseDevice(QObject *device);
+    bool hasDevice(QObject *device);
+
+    void queueEvent(QObject *device, const SDL_Event &event);
+    void processQueuedEvents();
+
+    int getNumberWorkers() const;
+
+    static int defaultNumberWorkers();
+
+    static const int MAXWORKERS;
+
+private slots:
+    void removeDevice(QObject *device);
+
+private:
+    QList<QThread*> workerThreads;
+    QList<DeviceWorker*> workers;
+    QVector<int> workerLoads;
+    QHash<QObject*, int> deviceAffinity;
+    QMutex affinityMutex;
+};
+
+#endif // DEVICEWORKERPOOL_H
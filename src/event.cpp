@@ -24,14 +24,16 @@
 #include <QStringList>
 #include <QCursor>
 #include <QDesktopWidget>
-#include <QProcess>
 #include <QDebug>
 
 #include "event.h"
 
 #include "messagehandler.h"
 #include "eventhandlerfactory.h"
+#include "eventhandlerdispatch.h"
 #include "joybutton.h"
+#include "processlauncher.h"
+#include "textentrystreamer.h"
 
 #if defined(Q_OS_UNIX)
 
@@ -114,30 +116,33 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyKeyboard)
     {
-        EventHandlerFactory::getInstance()->handler()->sendKeyboardEvent(slot, pressed);
+        OutputEventHandler::sendKeyboardEvent(slot, pressed);
     }
     else if (device == JoyButtonSlot::JoyMouseButton)
     {
-        EventHandlerFactory::getInstance()->handler()->sendMouseButtonEvent(slot, pressed);
+        OutputEventHandler::sendMouseButtonEvent(slot, pressed);
     }
     else if ((device == JoyButtonSlot::JoyTextEntry) && pressed && !slot->getTextData().isEmpty())
     {
-        EventHandlerFactory::getInstance()->handler()->sendTextEntryEvent(slot->getTextData());
-    }
-    else if ((device == JoyButtonSlot::JoyExecute) && pressed && !slot->getTextData().isEmpty())
-    {
-        QString execString = slot->getTextData();
-        if (slot->getExtraData().canConvert<QString>())
+        const KeystrokeProgram::Steps &program = slot->getTextEntryProgram();
+        if (!program.isEmpty())
         {
-            QString argumentsString = slot->getExtraData().toString();
-            QStringList argumentsTempList(PadderCommon::parseArgumentsString(argumentsString));
-            QProcess::startDetached(execString, argumentsTempList);
+            // Stream the precompiled program so long text entries do not
+            // block the input thread.
+            TextEntryStreamer::getInstance()->queueProgram(program);
         }
         else
         {
-            QProcess::startDetached(execString);
+            OutputEventHandler::sendTextEntryEvent(slot->getTextData());
         }
     }
+    else if ((device == JoyButtonSlot::JoyExecute) && pressed && !slot->getTextData().isEmpty())
+    {
+        // Process creation happens on the launcher thread so the input
+        // thread is never blocked by fork/exec.
+        ProcessLauncher::getInstance()->queueLaunch(slot->getTextData(),
+                                                    slot->getArgumentsList());
+    }
 }
 
 // Create the relative mouse event used by the operating system.
@@ -145,7 +150,20 @@ void sendevent(int code1, int code2)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    EventHandlerFactory::getInstance()->handler()->sendMouseEvent(code1, code2);
+    OutputEventHandler::sendMouseEvent(code1, code2);
+}
+
+// Create a wheel event in 1/120 of a notch. Only used when the active
+// backend reports a high resolution wheel.
+void sendWheelEvent(int vertical, int horizontal)
+{
+    OutputEventHandler::sendMouseWheelEvent(vertical, horizontal);
+}
+
+bool hasHighResolutionWheel()
+{
+    BaseEventHandler *handler = EventHandlerFactory::activeHandler();
+    return (handler != nullptr) && handler->hasHighResolutionWheel();
 }
 
 // TODO: Re-implement spring event generation to simplify the process
@@ -172,7 +190,6 @@ void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring,
         double displacementY = 0.0;
 
         PadderCommon::mouseHelperObj.mouseTimer.stop();
-        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
 
         if ((fullSpring->screen >= -1) &&
             (fullSpring->screen >= PadderCommon::mouseHelperObj.getDesktopWidget()->screenCount()))
@@ -231,15 +248,14 @@ void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring,
             }
         }
 
-        if (handler->getIdentifier() == "xtest")
+        if (EventHandlerFactory::activeBackend() == EventHandlerFactory::XTestBackend)
         {
             fakeAbsMouseCoordinates(displacementX, displacementY,
                                     springWidth, springHeight, xmovecoor, ymovecoor,
                                     fullSpring->screen);
         }
-        else if (handler->getIdentifier() == "uinput")
+        else if (EventHandlerFactory::activeBackend() == EventHandlerFactory::UInputBackend)
         {
-
             fakeAbsMouseCoordinates(displacementX, displacementY,
                                     springWidth, springHeight, xmovecoor, ymovecoor,
                                     fullSpring->screen);
@@ -253,6 +269,52 @@ void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring,
     }
 }
 
+/**
+ * @brief Move the cursor to a spring mode destination and keep the
+ *     destination as the predicted cursor position.
+ */
+static void sendSpringMove(PadderCommon::springModeInfo *fullSpring,
+                           int xmovecoor, int ymovecoor,
+                           int currentMouseX, int currentMouseY,
+                           const QRect &deskRect)
+{
+#if defined(Q_OS_UNIX)
+    if (fullSpring->screen <= -1)
+    {
+        EventHandlerFactory::EventBackend backend = EventHandlerFactory::activeBackend();
+        if (backend == EventHandlerFactory::XTestBackend)
+        {
+            OutputEventHandler::sendMouseAbsEvent(xmovecoor, ymovecoor, -1);
+        }
+        else if (backend == EventHandlerFactory::UInputBackend)
+        {
+            OutputEventHandler::sendMouseSpringEvent(xmovecoor, ymovecoor,
+                                                     deskRect.width() + deskRect.x(),
+                                                     deskRect.height() + deskRect.y());
+        }
+    }
+    else
+    {
+        OutputEventHandler::sendMouseEvent(xmovecoor - currentMouseX,
+                                           ymovecoor - currentMouseY);
+    }
+
+#elif defined(Q_OS_WIN)
+    if (fullSpring->screen <= -1)
+    {
+        OutputEventHandler::sendMouseSpringEvent(xmovecoor, ymovecoor,
+                                                 deskRect.width() + deskRect.x(),
+                                                 deskRect.height() + deskRect.y());
+    }
+    else
+    {
+        sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
+    }
+#endif
+
+    PadderCommon::mouseHelperObj.setSpringCursorPos(xmovecoor, ymovecoor);
+}
+
 // TODO: Change to only use this routine when using a relative mouse
 // pointer to fake absolute mouse moves. Otherwise, don't worry about
 // current position of the mouse and just send an absolute mouse pointer
@@ -296,19 +358,9 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring,
         width = deskRect.width();
         height = deskRect.height();
 
-#if defined(Q_OS_UNIX) && defined(WITH_X11)
-        QPoint currentPoint;
-        if (QApplication::platformName() == QStringLiteral("xcb"))
-        {
-            currentPoint = X11Extras::getInstance()->getPos();
-        }
-        else
-        {
-            currentPoint = QCursor::pos();
-        }
-#elif defined(Q_OS_WIN)
-        QPoint currentPoint = QCursor::pos();
-#endif
+        // Predicted position. The window system is only asked now and
+        // then so an update does not wait on it.
+        QPoint currentPoint = PadderCommon::mouseHelperObj.getSpringCursorPos();
 
         currentMouseX = currentPoint.x();
         currentMouseY = currentPoint.y();
@@ -403,83 +455,17 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring,
             // If either position is set to center, force update.
             if ((xmovecoor == (deskRect.x() + midwidth)) || (ymovecoor == (deskRect.y() + midheight)))
             {
-#if defined(Q_OS_UNIX)
-                BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
-                if (fullSpring->screen <= -1)
-                {
-                    if (handler->getIdentifier() == "xtest")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseAbsEvent(xmovecoor,
-                                                                                         ymovecoor,
-                                                                                         -1);
-                    }
-                    else if (handler->getIdentifier() == "uinput")
-                    {
-                        EventHandlerFactory::getInstance()->handler()
-                                ->sendMouseSpringEvent(xmovecoor, ymovecoor,
-                                                       width + deskRect.x(), height + deskRect.y());
-                    }
-                }
-                else
-                {
-                    EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                                  ymovecoor - currentMouseY);
-                }
-
-#elif defined(Q_OS_WIN)
-                if (fullSpring->screen <= -1)
-                {
-                    EventHandlerFactory::getInstance()->handler()
-                            ->sendMouseSpringEvent(xmovecoor, ymovecoor,
-                                                   width + deskRect.x(), height + deskRect.y());
-                }
-                else
-                {
-                    sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
-#endif
-
+                sendSpringMove(fullSpring, xmovecoor, ymovecoor,
+                               currentMouseX, currentMouseY, deskRect);
             }
             else if (!PadderCommon::mouseHelperObj.springMouseMoving && relativeSpring &&
                 ((relativeSpring->displacementX >= -1.0) || (relativeSpring->displacementY >= -1.0)) &&
                 ((diffx >= (destRelativeWidth * .013)) || (diffy >= (destRelativeHeight * .013))))
             {
                 PadderCommon::mouseHelperObj.springMouseMoving = true;
-#if defined(Q_OS_UNIX)
-                BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
-                if (fullSpring->screen <= -1)
-                {
-                    if (handler->getIdentifier() == "xtest")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseAbsEvent(xmovecoor,
-                                                                                         ymovecoor,
-                                                                                         -1);
-                    }
-                    else if (handler->getIdentifier() == "uinput")
-                    {
-                        EventHandlerFactory::getInstance()->handler()
-                                ->sendMouseSpringEvent(xmovecoor, ymovecoor,
-                                                       width + deskRect.x(), height + deskRect.y());
-                    }
-                }
-                else
-                {
-                    EventHandlerFactory::getInstance()->handler()
-                            ->sendMouseEvent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
+                sendSpringMove(fullSpring, xmovecoor, ymovecoor,
+                               currentMouseX, currentMouseY, deskRect);
 
-#elif defined(Q_OS_WIN)
-                if (fullSpring->screen <= -1)
-                {
-                    EventHandlerFactory::getInstance()->handler()
-                            ->sendMouseSpringEvent(xmovecoor, ymovecoor,
-                                                   width + deskRect.x(), height + deskRect.y());
-                }
-                else
-                {
-                    sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
-#endif
                 PadderCommon::mouseHelperObj.mouseTimer.start(
                             qMax(JoyButton::getMouseRefreshRate(),
                                  JoyButton::getGamepadRefreshRate()) + 1);
@@ -488,44 +474,8 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring,
                      ((diffx >= (destSpringWidth * .013)) || (diffy >= (destSpringHeight * .013))))
             {
                 PadderCommon::mouseHelperObj.springMouseMoving = true;
-#if defined(Q_OS_UNIX)
-
-                BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
-                if (fullSpring->screen <= -1)
-                {
-                    if (handler->getIdentifier() == "xtest")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseAbsEvent(xmovecoor,
-                                                                                         ymovecoor,
-                                                                                         -1);
-                    }
-                    else if (handler->getIdentifier() == "uinput")
-                    {
-                        EventHandlerFactory::getInstance()->handler()
-                                ->sendMouseSpringEvent(xmovecoor, ymovecoor,
-                                                       width + deskRect.x(), height + deskRect.y());
-                    }
-                }
-                else
-                {
-                    EventHandlerFactory::getInstance()->handler()
-                            ->sendMouseEvent(xmovecoor - currentMouseX,
-                                             ymovecoor - currentMouseY);
-                }
-
-
-#elif defined(Q_OS_WIN)
-                if (fullSpring->screen <= -1)
-                {
-                    EventHandlerFactory::getInstance()->handler()
-                            ->sendMouseSpringEvent(xmovecoor, ymovecoor,
-                                                   width + deskRect.x(), height + deskRect.y());
-                }
-                else
-                {
-                    sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
-#endif
+                sendSpringMove(fullSpring, xmovecoor, ymovecoor,
+                               currentMouseX, currentMouseY, deskRect);
 
                 PadderCommon::mouseHelperObj.mouseTimer.start(
                             qMax(JoyButton::getMouseRefreshRate(),
@@ -539,42 +489,8 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring,
 
             else if (PadderCommon::mouseHelperObj.springMouseMoving)
             {
-#if defined(Q_OS_UNIX)
-                BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
-                if (fullSpring->screen <= -1)
-                {
-                    if (handler->getIdentifier() == "xtest")
-                    {
-                        EventHandlerFactory::getInstance()->handler()->sendMouseAbsEvent(xmovecoor,
-                                                                                         ymovecoor,
-                                                                                         -1);
-                    }
-                    else if (handler->getIdentifier() == "uinput")
-                    {
-                        EventHandlerFactory::getInstance()->handler()
-                                ->sendMouseSpringEvent(xmovecoor, ymovecoor,
-                                                       width + deskRect.x(), height + deskRect.y());
-                    }
-                }
-                else
-                {
-                    EventHandlerFactory::getInstance()->handler()
-                            ->sendMouseEvent(xmovecoor - currentMouseX,
-                                             ymovecoor - currentMouseY);
-                }
-
-#elif defined(Q_OS_WIN)
-                if (fullSpring->screen <= -1)
-                {
-                    EventHandlerFactory::getInstance()->handler()
-                            ->sendMouseSpringEvent(xmovecoor, ymovecoor,
-                                                   width + deskRect.x(), height + deskRect.y());
-                }
-                else
-                {
-                    sendevent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
-                }
-#endif
+                sendSpringMove(fullSpring, xmovecoor, ymovecoor,
+                               currentMouseX, currentMouseY, deskRect);
 
                 PadderCommon::mouseHelperObj.mouseTimer.start(
                             qMax(JoyButton::getMouseRefreshRate(),
@@ -609,6 +525,7 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring,
         PadderCommon::mouseHelperObj.springMouseMoving = false;
         PadderCommon::mouseHelperObj.pivotPoint[0] = -1;
         PadderCommon::mouseHelperObj.pivotPoint[1] = -1;
+        PadderCommon::mouseHelperObj.invalidateSpringCursorPos();
     }
 }
 
@@ -29,6 +29,8 @@
 
 void sendevent (JoyButtonSlot *slot, bool pressed=true);
 void sendevent(int code1, int code2);
+void sendWheelEvent(int vertical, int horizontal);
+bool hasHighResolutionWheel();
 void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring,
                         PadderCommon::springModeInfo *relativeSpring=0,
                         int* const mousePosX=0, int* const mousePos=0);
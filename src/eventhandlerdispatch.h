@@ -0,0 +1,141 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVENTHANDLERDISPATCH_H
+#define EVENTHANDLERDISPATCH_H
+
+#include "eventhandlerfactory.h"
+#include "eventhandlers/baseeventhandler.h"
+
+
+/**
+ * @brief Output policy used by the event generation code. Calls are
+ *     qualified with the concrete handler type so the compiler binds
+ *     them directly instead of going through the vtable. The handler
+ *     pointer is read from the factory without the getInstance() path.
+ */
+template <typename Handler>
+class EventHandlerDispatch
+{
+public:
+    static inline Handler* handler()
+    {
+        return static_cast<Handler*>(EventHandlerFactory::activeHandler());
+    }
+
+    static inline void sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
+    {
+        handler()->Handler::sendKeyboardEvent(slot, pressed);
+    }
+
+    static inline void sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
+    {
+        handler()->Handler::sendMouseButtonEvent(slot, pressed);
+    }
+
+    static inline void sendMouseEvent(int xDis, int yDis)
+    {
+        handler()->Handler::sendMouseEvent(xDis, yDis);
+    }
+
+    static inline void sendMouseAbsEvent(int xDis, int yDis, int screen)
+    {
+        handler()->Handler::sendMouseAbsEvent(xDis, yDis, screen);
+    }
+
+    static inline void sendMouseSpringEvent(int xDis, int yDis, int width, int height)
+    {
+        handler()->Handler::sendMouseSpringEvent(xDis, yDis, width, height);
+    }
+
+    static inline void sendMouseWheelEvent(int vertical, int horizontal)
+    {
+        handler()->Handler::sendMouseWheelEvent(vertical, horizontal);
+    }
+
+    static inline void sendTextEntryEvent(QString maintext)
+    {
+        handler()->Handler::sendTextEntryEvent(maintext);
+    }
+
+    static inline void sendKeystrokeStep(quint32 step)
+    {
+        handler()->Handler::sendKeystrokeStep(step);
+    }
+};
+
+/**
+ * @brief Runtime selected backend. BaseEventHandler members are abstract
+ *     so these calls must stay virtual.
+ */
+template <>
+class EventHandlerDispatch<BaseEventHandler>
+{
+public:
+    static inline BaseEventHandler* handler()
+    {
+        return EventHandlerFactory::activeHandler();
+    }
+
+    static inline void sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
+    {
+        handler()->sendKeyboardEvent(slot, pressed);
+    }
+
+    static inline void sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
+    {
+        handler()->sendMouseButtonEvent(slot, pressed);
+    }
+
+    static inline void sendMouseEvent(int xDis, int yDis)
+    {
+        handler()->sendMouseEvent(xDis, yDis);
+    }
+
+    static inline void sendMouseAbsEvent(int xDis, int yDis, int screen)
+    {
+        handler()->sendMouseAbsEvent(xDis, yDis, screen);
+    }
+
+    static inline void sendMouseSpringEvent(int xDis, int yDis, int width, int height)
+    {
+        handler()->sendMouseSpringEvent(xDis, yDis, width, height);
+    }
+
+    static inline void sendMouseWheelEvent(int vertical, int horizontal)
+    {
+        handler()->sendMouseWheelEvent(vertical, horizontal);
+    }
+
+    static inline void sendTextEntryEvent(QString maintext)
+    {
+        handler()->sendTextEntryEvent(maintext);
+    }
+
+    static inline void sendKeystrokeStep(quint32 step)
+    {
+        handler()->sendKeystrokeStep(step);
+    }
+};
+
+#ifdef USE_STATIC_EVENT_HANDLER
+typedef EventHandlerDispatch<STATIC_EVENT_HANDLER> OutputEventHandler;
+#else
+typedef EventHandlerDispatch<BaseEventHandler> OutputEventHandler;
+#endif
+
+#endif // EVENTHANDLERDISPATCH_H
@@ -18,9 +18,12 @@
 #include "eventhandlerfactory.h"
 
 #include "messagehandler.h"
+#include "startuptrace.h"
 #include "eventhandlers/baseeventhandler.h"
 
 #include <QHash>
+#include <QThread>
+#include <QElapsedTimer>
 #include <QDebug>
 
 
@@ -43,14 +46,57 @@ static QHash<QString, QString> buildDisplayNames()
 
 QHash<QString, QString> handlerDisplayNames = buildDisplayNames();
 
+/**
+ * @brief Runs the init routine of an event handler on a separate thread
+ *     so virtual device creation overlaps with the rest of startup.
+ */
+class EventHandlerInitThread : public QThread
+{
+public:
+    explicit EventHandlerInitThread(BaseEventHandler *handler) :
+        QThread(),
+        handler(handler),
+        result(false)
+    {
+    }
+
+    bool getResult() const
+    {
+        return result;
+    }
+
+protected:
+    void run() override
+    {
+        QElapsedTimer initTime;
+        initTime.start();
+        result = handler->init();
+        StartupTrace::record(QString("Event generator init (background)"), initTime.nsecsElapsed());
+    }
+
+private:
+    BaseEventHandler *handler;
+    bool result;
+};
+
 EventHandlerFactory* EventHandlerFactory::instance = nullptr;
+BaseEventHandler* EventHandlerFactory::currentHandler = nullptr;
+EventHandlerFactory::EventBackend EventHandlerFactory::currentBackend = EventHandlerFactory::UnknownBackend;
 
 EventHandlerFactory::EventHandlerFactory(QString handler, QObject *parent) :
     QObject(parent)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-#ifdef Q_OS_UNIX
+    eventHandler = nullptr;
+    initThread = nullptr;
+    initStatus = false;
+
+#ifdef USE_STATIC_EVENT_HANDLER
+    // Only one backend is available so the requested name does not matter.
+    Q_UNUSED(handler);
+    eventHandler = new STATIC_EVENT_HANDLER(this);
+#elif defined(Q_OS_UNIX)
     #ifdef WITH_UINPUT
     if (handler == "uinput")
     {
@@ -76,12 +122,21 @@ EventHandlerFactory::EventHandlerFactory(QString handler, QObject *parent) :
     }
   #endif
 #endif
+
+    currentHandler = eventHandler;
+    currentBackend = (eventHandler != nullptr) ?
+                backendFromIdentifier(eventHandler->getIdentifier()) : UnknownBackend;
 }
 
 EventHandlerFactory::~EventHandlerFactory()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    currentHandler = nullptr;
+    currentBackend = UnknownBackend;
+
+    waitHandlerInit();
+
     if (eventHandler != nullptr)
     {
         delete eventHandler;
@@ -127,6 +182,76 @@ BaseEventHandler* EventHandlerFactory::handler()
     return eventHandler;
 }
 
+/**
+ * @brief Begin initializing the event handler. uinput device creation
+ *     only talks to the kernel and runs on a helper thread. Other
+ *     backends share the display connection with the GUI thread, so
+ *     they are initialized right away.
+ */
+void EventHandlerFactory::startHandlerInit()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if ((eventHandler != nullptr) && (initThread == nullptr))
+    {
+        if (currentBackend == UInputBackend)
+        {
+            initThread = new EventHandlerInitThread(eventHandler);
+            initThread->start();
+        }
+        else
+        {
+            initStatus = eventHandler->init();
+            StartupTrace::mark(QString("Event generator init"));
+        }
+    }
+}
+
+/**
+ * @brief Wait for the init routine started by startHandlerInit.
+ * @return Whether the event handler was initialized
+ */
+bool EventHandlerFactory::waitHandlerInit()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (initThread != nullptr)
+    {
+        initThread->wait();
+        initStatus = static_cast<EventHandlerInitThread*>(initThread)->getResult();
+        delete initThread;
+        initThread = nullptr;
+    }
+
+    return initStatus;
+}
+
+EventHandlerFactory::EventBackend EventHandlerFactory::backendFromIdentifier(QString identifier)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    EventBackend backend = UnknownBackend;
+
+    if (identifier == "xtest")
+    {
+        backend = XTestBackend;
+    }
+    else if (identifier == "uinput")
+    {
+        backend = UInputBackend;
+    }
+    else if (identifier == "sendinput")
+    {
+        backend = SendInputBackend;
+    }
+    else if (identifier == "vmulti")
+    {
+        backend = VMultiBackend;
+    }
+
+    return backend;
+}
+
 QString EventHandlerFactory::fallBackIdentifier()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -69,7 +69,20 @@
   #define BACKEND_ELSE_IF if
 #endif
 
+// Bind the output backend at compile time when only one backend is built.
+#if defined(WITH_STATIC_EVENT_HANDLER) && (NUM_BACKENDS == 1)
+  #define USE_STATIC_EVENT_HANDLER 1
+  #if defined(Q_OS_WIN)
+    #define STATIC_EVENT_HANDLER WinSendInputEventHandler
+  #elif defined(WITH_UINPUT)
+    #define STATIC_EVENT_HANDLER UInputEventHandler
+  #else
+    #define STATIC_EVENT_HANDLER XTestEventHandler
+  #endif
+#endif
+
 class BaseEventHandler;
+class QThread;
 
 
 class EventHandlerFactory : public QObject
@@ -77,6 +90,9 @@ class EventHandlerFactory : public QObject
     Q_OBJECT
 
 public:
+    enum EventBackend {UnknownBackend=0, XTestBackend, UInputBackend,
+                       SendInputBackend, VMultiBackend};
+
     static EventHandlerFactory* getInstance(QString handler = "");
     void deleteInstance();
     BaseEventHandler* handler();
@@ -84,12 +100,41 @@ public:
     static QStringList buildEventGeneratorList();
     static QString handlerDisplayName(QString handler);
 
+    /**
+     * @brief Handler of the current instance without going through
+     *     getInstance(). Only valid while the factory exists.
+     * @return Active event handler or nullptr
+     */
+    static inline BaseEventHandler* activeHandler()
+    {
+        return currentHandler;
+    }
+
+    /**
+     * @brief Backend of the current handler. Cached when the handler is
+     *     created so hot paths do not have to compare identifier strings.
+     * @return Active backend or UnknownBackend
+     */
+    static inline EventBackend activeBackend()
+    {
+        return currentBackend;
+    }
+
+    static EventBackend backendFromIdentifier(QString identifier);
+
+    void startHandlerInit();
+    bool waitHandlerInit();
+
 protected:
     explicit EventHandlerFactory(QString handler, QObject *parent = nullptr);
     ~EventHandlerFactory();
 
     BaseEventHandler *eventHandler;
+    QThread *initThread;
+    bool initStatus;
     static EventHandlerFactory *instance;
+    static BaseEventHandler *currentHandler;
+    static EventBackend currentBackend;
 
 };
 
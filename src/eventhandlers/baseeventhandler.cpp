@@ -22,6 +22,9 @@
 
 #include <QDebug>
 
+// Same scale as the high resolution wheel axes of the Linux input layer.
+const int BaseEventHandler::WHEELNOTCHUNITS = 120;
+
 
 BaseEventHandler::BaseEventHandler(QObject *parent) :
     QObject(parent)
@@ -94,6 +97,33 @@ void BaseEventHandler::sendMouseSpringEvent(int xDis, int yDis)
     Q_UNUSED(yDis);
 }
 
+/**
+ * @brief Whether the backend accepts wheel movement in fractions of a
+ *     notch through sendMouseWheelEvent.
+ * @return False by default
+ */
+bool BaseEventHandler::hasHighResolutionWheel()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return false;
+}
+
+/**
+ * @brief Do nothing by default. Only called when hasHighResolutionWheel
+ *     returns true.
+ * @param Vertical wheel movement in 1/120 of a notch. Positive is up
+ * @param Horizontal wheel movement in 1/120 of a notch. Positive matches
+ *     a MouseWheelLeft slot
+ */
+void BaseEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    Q_UNUSED(vertical);
+    Q_UNUSED(horizontal);
+}
+
 void BaseEventHandler::sendTextEntryEvent(QString maintext)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -101,5 +131,44 @@ void BaseEventHandler::sendTextEntryEvent(QString maintext)
     Q_UNUSED(maintext);
 }
 
+/**
+ * @brief Compile text into a keystroke program for this backend.
+ *     Backends without support return an empty program and text entries
+ *     are sent through sendTextEntryEvent instead.
+ * @param Text to compile
+ * @return Keystroke program
+ */
+KeystrokeProgram::Steps BaseEventHandler::compileTextEntry(QString maintext)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    Q_UNUSED(maintext);
+
+    return KeystrokeProgram::Steps();
+}
+
+/**
+ * @brief Send one step of a keystroke program built by compileTextEntry.
+ * @param Encoded step
+ */
+void BaseEventHandler::sendKeystrokeStep(quint32 step)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    Q_UNUSED(step);
+}
+
+/**
+ * @brief Number of native key codes, starting at 0, that are tracked
+ *     in dense tables. Larger codes still work through a slower path.
+ * @return Key code range of the backend
+ */
+int BaseEventHandler::getKeyCodeRange()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return 0x10000;
+}
+
 
 
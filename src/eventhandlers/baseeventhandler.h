@@ -18,6 +18,8 @@
 #ifndef BASEEVENTHANDLER_H
 #define BASEEVENTHANDLER_H
 
+#include "keystrokeprogram.h"
+
 #include <QObject>
 #include <QString>
 
@@ -43,14 +45,21 @@ public:
     virtual void sendMouseSpringEvent(int xDis, int yDis,
                                       int width, int height); //.., unsigned, unsigned, unsigned, unsigned
     virtual void sendMouseSpringEvent(int xDis, int yDis);
+    virtual bool hasHighResolutionWheel();
+    virtual void sendMouseWheelEvent(int vertical, int horizontal);
 
     virtual void sendTextEntryEvent(QString maintext);
+    virtual KeystrokeProgram::Steps compileTextEntry(QString maintext);
+    virtual void sendKeystrokeStep(quint32 step);
+    virtual int getKeyCodeRange();
 
     virtual QString getName() = 0;
     virtual QString getIdentifier() = 0;
     virtual void printPostMessages();
     QString getErrorString();
 
+    static const int WHEELNOTCHUNITS;
+
 
 protected:
     QString lastErrorString;
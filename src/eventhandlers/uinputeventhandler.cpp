@@ -37,6 +37,9 @@ static const QString mouseDeviceName = PadderCommon::mouseDeviceName;
 static const QString keyboardDeviceName = PadderCommon::keyboardDeviceName;
 static const QString springMouseDeviceName = PadderCommon::springMouseDeviceName;
 
+static const int ABSAXISMIN = -32767;
+static const int ABSAXISMAX = 32767;
+
 #ifdef WITH_X11
     #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
       #include <QApplication>
@@ -54,6 +57,8 @@ UInputEventHandler::UInputEventHandler(QObject *parent) :
     keyboardFileHandler = 0;
     mouseFileHandler = 0;
     springMouseFileHandler = 0;
+    wheelRemainderVertical = 0;
+    wheelRemainderHorizontal = 0;
 }
 
 UInputEventHandler::~UInputEventHandler()
@@ -62,15 +67,59 @@ UInputEventHandler::~UInputEventHandler()
 }
 
 /**
- * @brief Initialize keyboard and mouse virtual devices. Each device will
- *     use its own file handle with various codes set to distinquish the two
- *     devices.
- * @return
+ * @brief Initialize keyboard and mouse virtual devices. The devices are
+ *     kept until cleanup() so a repeated init reuses them instead of
+ *     announcing new devices to the X server.
+ * @return Whether the virtual devices are available
  */
 bool UInputEventHandler::init()
 {
     bool result = true;
 
+    if (!hasDevices())
+    {
+        // Drop whatever an earlier failed attempt left open.
+        cleanup();
+        result = createDevices();
+
+#ifdef WITH_X11
+        if (result)
+        {
+        #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+
+        if (QApplication::platformName() == QStringLiteral("xcb"))
+        {
+        #endif
+        // Some time needs to elapse after device creation before changing
+        // pointer settings. Otherwise, settings will not take effect. init
+        // may run on a helper thread, so the timer is bound to the handler.
+        QTimer::singleShot(2000, this, &UInputEventHandler::x11ResetMouseAccelerationChange);
+        #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        }
+        #endif
+        }
+#endif
+    }
+
+    return result;
+}
+
+bool UInputEventHandler::hasDevices()
+{
+    return (keyboardFileHandler > 0) && (mouseFileHandler > 0) &&
+           (springMouseFileHandler > 0);
+}
+
+/**
+ * @brief Create the keyboard, relative mouse and absolute mouse devices.
+ *     Each device uses its own file handle with various codes set to
+ *     distinguish them.
+ * @return Whether all devices were created
+ */
+bool UInputEventHandler::createDevices()
+{
+    bool result = true;
+
     // Open file handle for keyboard emulation.
     keyboardFileHandler = openUInputHandle();
     if (keyboardFileHandler > 0)
@@ -114,23 +163,6 @@ bool UInputEventHandler::init()
         }
     }
 
-#ifdef WITH_X11
-    if (result)
-    {
-    #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-
-    if (QApplication::platformName() == QStringLiteral("xcb"))
-    {
-    #endif
-    // Some time needs to elapse after device creation before changing
-    // pointer settings. Otherwise, settings will not take effect.
-    QTimer::singleShot(2000, this, SLOT(x11ResetMouseAccelerationChange()));
-    #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    }
-    #endif
-    }
-#endif
-
     return result;
 }
 
@@ -213,7 +245,7 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, 1);
+                sendMouseWheelEvent(WHEELNOTCHUNITS, 0);
             }
 
         }
@@ -221,21 +253,21 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, -1);
+                sendMouseWheelEvent(-WHEELNOTCHUNITS, 0);
             }
         }
         else if (code == 6)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, 1);
+                sendMouseWheelEvent(0, WHEELNOTCHUNITS);
             }
         }
         else if (code == 7)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, -1);
+                sendMouseWheelEvent(0, -WHEELNOTCHUNITS);
             }
         }
         else if (code == 8)
@@ -290,6 +322,65 @@ void UInputEventHandler::sendMouseSpringEvent(int xDis, int yDis)
     }
 }
 
+bool UInputEventHandler::hasHighResolutionWheel()
+{
+#ifdef REL_WHEEL_HI_RES
+    return mouseFileHandler > 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Send wheel movement in fractions of a notch. Whole notches are
+ *     also reported on the legacy wheel axes once enough movement has
+ *     accumulated, since consumers without high resolution support
+ *     only read those. The accumulated movement is dropped when the
+ *     direction changes.
+ * @param Vertical wheel movement in 1/120 of a notch
+ * @param Horizontal wheel movement in 1/120 of a notch
+ */
+void UInputEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    writeWheelAxis(true, vertical);
+    writeWheelAxis(false, horizontal);
+
+    if ((vertical != 0) || (horizontal != 0))
+    {
+        write_uinput_event(mouseFileHandler, EV_SYN, SYN_REPORT, 0, false);
+    }
+}
+
+void UInputEventHandler::writeWheelAxis(bool vertical, int units)
+{
+    if (units != 0)
+    {
+#ifdef REL_WHEEL_HI_RES
+        write_uinput_event(mouseFileHandler, EV_REL,
+                           vertical ? REL_WHEEL_HI_RES : REL_HWHEEL_HI_RES, units, false);
+#endif
+
+        int &remainder = vertical ? wheelRemainderVertical : wheelRemainderHorizontal;
+
+        // Movement left over from scrolling the other way must not eat
+        // the first notch of a new scroll.
+        if (((remainder > 0) && (units < 0)) || ((remainder < 0) && (units > 0)))
+        {
+            remainder = 0;
+        }
+
+        remainder += units;
+
+        int notches = remainder / WHEELNOTCHUNITS;
+        if (notches != 0)
+        {
+            remainder -= notches * WHEELNOTCHUNITS;
+            write_uinput_event(mouseFileHandler, EV_REL,
+                               vertical ? REL_WHEEL : REL_HWHEEL, notches, false);
+        }
+    }
+}
+
 int UInputEventHandler::openUInputHandle()
 {
     int filehandle = -1;
@@ -355,6 +446,10 @@ void UInputEventHandler::setRelMouseEvents(int filehandle)
     ioctl(filehandle, UI_SET_RELBIT, REL_Y);
     ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL);
     ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL);
+#ifdef REL_WHEEL_HI_RES
+    ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL_HI_RES);
+    ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL_HI_RES);
+#endif
 
     ioctl(filehandle, UI_SET_KEYBIT, BTN_LEFT);
     ioctl(filehandle, UI_SET_KEYBIT, BTN_RIGHT);
@@ -393,62 +488,90 @@ void UInputEventHandler::populateKeyCodes(int filehandle)
     }
 }
 
-void UInputEventHandler::createUInputKeyboardDevice(int filehandle)
+/**
+ * @brief Describe a virtual device to the uinput module. UI_DEV_SETUP and
+ *     UI_ABS_SETUP are used when the kernel supports them (Linux 4.5 and
+ *     later). Otherwise a legacy uinput_user_dev struct gets written.
+ * @param File handle of the device
+ * @param Name of the device
+ * @param Whether the device reports absolute X and Y axes
+ */
+void UInputEventHandler::setupUInputDevice(int filehandle, const QString &name,
+                                           bool absoluteAxes)
 {
-    struct uinput_user_dev uidev;
+    QByteArray temp = name.toUtf8();
+    bool configured = false;
 
-    memset(&uidev, 0, sizeof(uidev));
-    QByteArray temp = keyboardDeviceName.toUtf8();
-    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
-    uidev.id.bustype = BUS_USB;
-    uidev.id.vendor  = 0x0;
-    uidev.id.product = 0x0;
-    uidev.id.version = 1;
+#ifdef UI_DEV_SETUP
+    struct uinput_setup usetup;
 
+    memset(&usetup, 0, sizeof(usetup));
+    strncpy(usetup.name, temp.constData(), UINPUT_MAX_NAME_SIZE - 1);
+    usetup.id.bustype = BUS_USB;
+    usetup.id.vendor  = 0x0;
+    usetup.id.product = 0x0;
+    usetup.id.version = 1;
 
-    write(filehandle, &uidev, sizeof(uidev));
-    ioctl(filehandle, UI_DEV_CREATE);
-}
+    configured = (ioctl(filehandle, UI_DEV_SETUP, &usetup) == 0);
 
-void UInputEventHandler::createUInputMouseDevice(int filehandle)
-{
-    struct uinput_user_dev uidev;
+    if (configured && absoluteAxes)
+    {
+        struct uinput_abs_setup abssetup;
 
-    memset(&uidev, 0, sizeof(uidev));
-    QByteArray temp = mouseDeviceName.toUtf8();
-    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
-    uidev.id.bustype = BUS_USB;
-    uidev.id.vendor  = 0x0;
-    uidev.id.product = 0x0;
-    uidev.id.version = 1;
+        memset(&abssetup, 0, sizeof(abssetup));
+        abssetup.absinfo.minimum = ABSAXISMIN;
+        abssetup.absinfo.maximum = ABSAXISMAX;
+        abssetup.absinfo.flat = 0;
 
+        abssetup.code = ABS_X;
+        configured = (ioctl(filehandle, UI_ABS_SETUP, &abssetup) == 0);
 
-    write(filehandle, &uidev, sizeof(uidev));
-    ioctl(filehandle, UI_DEV_CREATE);
-}
+        abssetup.code = ABS_Y;
+        configured = configured && (ioctl(filehandle, UI_ABS_SETUP, &abssetup) == 0);
+    }
+#endif
 
-void UInputEventHandler::createUInputSpringMouseDevice(int filehandle)
-{
-    struct uinput_user_dev uidev;
+    if (!configured)
+    {
+        struct uinput_user_dev uidev;
+
+        memset(&uidev, 0, sizeof(uidev));
+        strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE - 1);
+        uidev.id.bustype = BUS_USB;
+        uidev.id.vendor  = 0x0;
+        uidev.id.product = 0x0;
+        uidev.id.version = 1;
 
-    memset(&uidev, 0, sizeof(uidev));
-    QByteArray temp = springMouseDeviceName.toUtf8();
-    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
-    uidev.id.bustype = BUS_USB;
-    uidev.id.vendor  = 0x0;
-    uidev.id.product = 0x0;
-    uidev.id.version = 1;
+        if (absoluteAxes)
+        {
+            uidev.absmin[ABS_X] = ABSAXISMIN;
+            uidev.absmax[ABS_X] = ABSAXISMAX;
+            uidev.absflat[ABS_X] = 0;
 
-    uidev.absmin[ABS_X] = -32767;
-    uidev.absmax[ABS_X] = 32767;
-    uidev.absflat[ABS_X] = 0;
+            uidev.absmin[ABS_Y] = ABSAXISMIN;
+            uidev.absmax[ABS_Y] = ABSAXISMAX;
+            uidev.absflat[ABS_Y] = 0;
+        }
 
-    uidev.absmin[ABS_Y] = -32767;
-    uidev.absmax[ABS_Y] = 32767;
-    uidev.absflat[ABS_Y] = 0;
+        write(filehandle, &uidev, sizeof(uidev));
+    }
+}
 
+void UInputEventHandler::createUInputKeyboardDevice(int filehandle)
+{
+    setupUInputDevice(filehandle, keyboardDeviceName, false);
+    ioctl(filehandle, UI_DEV_CREATE);
+}
+
+void UInputEventHandler::createUInputMouseDevice(int filehandle)
+{
+    setupUInputDevice(filehandle, mouseDeviceName, false);
+    ioctl(filehandle, UI_DEV_CREATE);
+}
 
-    write(filehandle, &uidev, sizeof(uidev));
+void UInputEventHandler::createUInputSpringMouseDevice(int filehandle)
+{
+    setupUInputDevice(filehandle, springMouseDeviceName, true);
     ioctl(filehandle, UI_DEV_CREATE);
 }
 
@@ -496,6 +619,11 @@ QString UInputEventHandler::getIdentifier()
     return getName();
 }
 
+int UInputEventHandler::getKeyCodeRange()
+{
+    return KEY_CNT;
+}
+
 /**
  * @brief Print extra help messages to stdout.
  */
@@ -514,6 +642,23 @@ void UInputEventHandler::printPostMessages()
 
 void UInputEventHandler::sendTextEntryEvent(QString maintext)
 {
+    KeystrokeProgram::Steps program = compileTextEntry(maintext);
+
+    for (int i = 0; i < program.size(); i++)
+    {
+        sendKeystrokeStep(program.at(i));
+    }
+}
+
+/**
+ * @brief Resolve every character of a text entry to uinput key codes and
+ *     build a keystroke program from them.
+ * @param Text to compile
+ * @return Keystroke program
+ */
+KeystrokeProgram::Steps UInputEventHandler::compileTextEntry(QString maintext)
+{
+    KeystrokeProgram::Steps program;
     AntKeyMapper *mapper = AntKeyMapper::getInstance();
 
     if (mapper && mapper->getKeyMapper())
@@ -525,11 +670,9 @@ void UInputEventHandler::sendTextEntryEvent(QString maintext)
             nativeWinKeyMapper = qobject_cast<QtX11KeyMapper*>(mapper->getNativeKeyMapper());
         }
 
-        QList<unsigned int> tempList;
+        QList<KeystrokeProgram::CharacterStroke> strokes;
         for (int i=0; i < maintext.size(); i++)
         {
-            tempList.clear();
-
             QtUInputKeyMapper::charKeyInformation temp;
             temp.virtualkey = 0;
             temp.modifiers = Qt::NoModifier;
@@ -556,50 +699,45 @@ void UInputEventHandler::sendTextEntryEvent(QString maintext)
 
             if (temp.virtualkey > KEY_RESERVED)
             {
-                if (temp.modifiers != Qt::NoModifier)
+                KeystrokeProgram::CharacterStroke stroke;
+                stroke.keycode = temp.virtualkey;
+
+                if (temp.modifiers.testFlag(Qt::ShiftModifier))
                 {
-                    if (temp.modifiers.testFlag(Qt::ShiftModifier))
-                    {
-                        tempList.append(KEY_LEFTSHIFT);
-                        write_uinput_event(keyboardFileHandler, EV_KEY, KEY_LEFTSHIFT, 1, false);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::ControlModifier))
-                    {
-                        tempList.append(KEY_LEFTCTRL);
-                        write_uinput_event(keyboardFileHandler, EV_KEY, KEY_LEFTCTRL, 1, false);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::AltModifier))
-                    {
-                        tempList.append(KEY_LEFTALT);
-                        write_uinput_event(keyboardFileHandler, EV_KEY, KEY_LEFTALT, 1, false);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::MetaModifier))
-                    {
-                        tempList.append(KEY_LEFTMETA);
-                        write_uinput_event(keyboardFileHandler, EV_KEY, KEY_LEFTMETA, 1, false);
-                    }
+                    stroke.modifiers.append(KEY_LEFTSHIFT);
                 }
 
-                tempList.append(static_cast<unsigned int>(temp.virtualkey));
-                write_uinput_event(keyboardFileHandler, EV_KEY, temp.virtualkey, 1, true);
-            }
+                if (temp.modifiers.testFlag(Qt::ControlModifier))
+                {
+                    stroke.modifiers.append(KEY_LEFTCTRL);
+                }
 
-            if (tempList.size() > 0)
-            {
-                QListIterator<unsigned int> tempiter(tempList);
-                tempiter.toBack();
-                while (tempiter.hasPrevious())
+                if (temp.modifiers.testFlag(Qt::AltModifier))
                 {
-                    unsigned int currentcode = tempiter.previous();
-                    bool sync = !tempiter.hasPrevious() ? true : false;
-                    write_uinput_event(keyboardFileHandler, EV_KEY, static_cast<int>(currentcode), 0, sync);
+                    stroke.modifiers.append(KEY_LEFTALT);
                 }
+
+                if (temp.modifiers.testFlag(Qt::MetaModifier))
+                {
+                    stroke.modifiers.append(KEY_LEFTMETA);
+                }
+
+                strokes.append(stroke);
             }
         }
+
+        program = KeystrokeProgram::compile(strokes);
     }
+
+    return program;
+}
+
+void UInputEventHandler::sendKeystrokeStep(quint32 step)
+{
+    write_uinput_event(keyboardFileHandler, EV_KEY,
+                       KeystrokeProgram::stepKeycode(step),
+                       KeystrokeProgram::stepPressed(step) ? 1 : 0,
+                       KeystrokeProgram::stepSync(step));
 }
 
 int UInputEventHandler::getKeyboardFileHandler() {
@@ -42,12 +42,17 @@ public:
     virtual void sendMouseSpringEvent(int xDis, int yDis,
                                       int width, int height); // unsigned, unsigned, unsigned, unsigned
     virtual void sendMouseSpringEvent(int xDis, int yDis);
+    virtual bool hasHighResolutionWheel();
+    virtual void sendMouseWheelEvent(int vertical, int horizontal);
 
     virtual QString getName();
     virtual QString getIdentifier();
     virtual void printPostMessages();
 
     virtual void sendTextEntryEvent(QString maintext);
+    virtual KeystrokeProgram::Steps compileTextEntry(QString maintext);
+    virtual void sendKeystrokeStep(quint32 step);
+    virtual int getKeyCodeRange();
 
     int getKeyboardFileHandler();
     int getMouseFileHandler();
@@ -55,17 +60,21 @@ public:
     const QString getUinputDeviceLocation();
 
 protected:
+    bool hasDevices();
+    bool createDevices();
     int openUInputHandle();
     void setKeyboardEvents(int filehandle);
     void setRelMouseEvents(int filehandle);
     void setSpringMouseEvents(int filehandle);
     void populateKeyCodes(int filehandle);
+    void setupUInputDevice(int filehandle, const QString &name, bool absoluteAxes);
     void createUInputKeyboardDevice(int filehandle);
     void createUInputMouseDevice(int filehandle);
     void createUInputSpringMouseDevice(int filehandle);
     void closeUInputDevice(int filehandle);
     void write_uinput_event(int filehandle, int type,
                             int code, int value, bool syn=true); // .., .., unsigned, unsigned, .., ..
+    void writeWheelAxis(bool vertical, int units);
 
 private slots:
 #ifdef WITH_X11
@@ -77,6 +86,8 @@ private:
     int mouseFileHandler;
     int springMouseFileHandler;
     QString uinputDeviceLocation;
+    int wheelRemainderVertical;
+    int wheelRemainderHorizontal;
 
 };
 
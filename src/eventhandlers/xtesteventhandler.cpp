@@ -127,6 +127,26 @@ QString XTestEventHandler::getIdentifier()
 void XTestEventHandler::sendTextEntryEvent(QString maintext)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    KeystrokeProgram::Steps program = compileTextEntry(maintext);
+
+    for (int i = 0; i < program.size(); i++)
+    {
+        sendKeystrokeStep(program.at(i));
+    }
+}
+
+/**
+ * @brief Resolve every character of a text entry to X11 key codes and
+ *     build a keystroke program from them.
+ * @param Text to compile
+ * @return Keystroke program
+ */
+KeystrokeProgram::Steps XTestEventHandler::compileTextEntry(QString maintext)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    KeystrokeProgram::Steps program;
     AntKeyMapper *mapper = AntKeyMapper::getInstance();
 
     if ((mapper != nullptr) && mapper->getKeyMapper())
@@ -134,92 +154,63 @@ void XTestEventHandler::sendTextEntryEvent(QString maintext)
         Display* display = X11Extras::getInstance()->display();
         QtX11KeyMapper *keymapper = qobject_cast<QtX11KeyMapper*>(mapper->getKeyMapper()); // static_cast
 
+        int shiftcode = XKeysymToKeycode(display, XK_Shift_L);
+        int controlcode = XKeysymToKeycode(display, XK_Control_L);
+        int altcode = XKeysymToKeycode(display, XK_Alt_L);
+        int metacode = XKeysymToKeycode(display, XK_Meta_L);
+
+        QList<KeystrokeProgram::CharacterStroke> strokes;
         for (int i=0; i < maintext.size(); i++)
         {
             QtX11KeyMapper::charKeyInformation temp = keymapper->getCharKeyInformation(maintext.at(i));
             int tempcode = XKeysymToKeycode(display, static_cast<unsigned long>(temp.virtualkey));
             if (tempcode > 0)
             {
-                QList<int> tempList;
+                KeystrokeProgram::CharacterStroke stroke;
+                stroke.keycode = tempcode;
 
-                if (temp.modifiers != Qt::NoModifier)
+                if (temp.modifiers.testFlag(Qt::ShiftModifier))
                 {
-                    if (temp.modifiers.testFlag(Qt::ShiftModifier))
-                    {
-                        int shiftcode = 0;
-
-                        if (shiftcode == 0)
-                        {
-                            shiftcode = XKeysymToKeycode(display, XK_Shift_L);
-                        }
-
-                        int modifiercode = shiftcode;
-                        XTestFakeKeyEvent(display, static_cast<unsigned int>(modifiercode), 1, 0);
-                        tempList.append(modifiercode);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::ControlModifier))
-                    {
-                        int controlcode = 0;
-
-                        if (controlcode == 0)
-                        {
-                            controlcode = XKeysymToKeycode(display, XK_Control_L);
-                        }
-
-                        int modifiercode = controlcode;
-                        XTestFakeKeyEvent(display, static_cast<unsigned int>(modifiercode), 1, 0);
-                        tempList.append(modifiercode);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::AltModifier))
-                    {
-                        int altcode = 0;
-
-                        if (altcode == 0)
-                        {
-                            altcode = XKeysymToKeycode(display, XK_Alt_L);
-                        }
-
-                        int modifiercode = altcode;
-                        XTestFakeKeyEvent(display, static_cast<unsigned int>(modifiercode), 1, 0);
-                        tempList.append(modifiercode);
-                    }
-
-                    if (temp.modifiers.testFlag(Qt::MetaModifier))
-                    {
-                        int metacode = 0;
-
-                        if (metacode == 0)
-                        {
-                            metacode = XKeysymToKeycode(display, XK_Meta_L);
-                        }
-
-                        int modifiercode = metacode;
-                        XTestFakeKeyEvent(display, static_cast<unsigned int>(modifiercode), 1, 0);
-                        tempList.append(modifiercode);
-                    }
+                    stroke.modifiers.append(shiftcode);
                 }
 
-                XTestFakeKeyEvent(display, static_cast<unsigned int>(tempcode), 1, 0);
-                tempList.append(tempcode);
+                if (temp.modifiers.testFlag(Qt::ControlModifier))
+                {
+                    stroke.modifiers.append(controlcode);
+                }
 
-                XFlush(display);
+                if (temp.modifiers.testFlag(Qt::AltModifier))
+                {
+                    stroke.modifiers.append(altcode);
+                }
 
-                if (tempList.size() > 0)
+                if (temp.modifiers.testFlag(Qt::MetaModifier))
                 {
-                    QListIterator<int> tempiter(tempList);
-                    tempiter.toBack();
-                    while (tempiter.hasPrevious())
-                    {
-                        int currentcode = tempiter.previous();
-                        XTestFakeKeyEvent(display, static_cast<unsigned int>(currentcode), 0, 0);
-                    }
-
-                    XFlush(display);
+                    stroke.modifiers.append(metacode);
                 }
+
+                strokes.append(stroke);
             }
         }
+
+        program = KeystrokeProgram::compile(strokes);
+    }
+
+    return program;
+}
+
+void XTestEventHandler::sendKeystrokeStep(quint32 step)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    Display* display = X11Extras::getInstance()->display();
+    XTestFakeKeyEvent(display,
+                      static_cast<unsigned int>(KeystrokeProgram::stepKeycode(step)),
+                      KeystrokeProgram::stepPressed(step) ? 1 : 0, 0);
+
+    if (KeystrokeProgram::stepSync(step))
+    {
+        XFlush(display);
     }
 }
 
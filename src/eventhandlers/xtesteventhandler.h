@@ -44,6 +44,8 @@ public:
     void sendMouseSpringEvent(int xDis, int yDis) override;
 
     void sendTextEntryEvent(QString maintext) override;
+    KeystrokeProgram::Steps compileTextEntry(QString maintext) override;
+    void sendKeystrokeStep(quint32 step) override;
 
     QString getName() override;
     QString getIdentifier() override;
@@ -23,9 +23,12 @@
 #include "joycontrolstick.h"
 #include "joybuttontypes/joycontrolstickbutton.h"
 #include "common.h"
+#include "event.h"
 #include "messagehandler.h"
 //#include "logger.h"
 
+#include <SDL2/SDL_version.h>
+
 #include <cmath>
 
 #include <QXmlStreamReader>
@@ -36,6 +39,10 @@
 
 const QString GameController::xmlName = "gamecontroller";
 
+// Largest difference in microseconds between an estimated sensor sample
+// time and the event time before the estimate is dropped.
+static const qint64 MAXSENSORTIMESTAMPDRIFT = 20000;
+
 GameController::GameController(SDL_GameController *controller, int deviceIndex,
                                AntiMicroSettings *settings, QObject *parent) :
     InputDevice(deviceIndex, settings, parent)
@@ -45,6 +52,11 @@ GameController::GameController(SDL_GameController *controller, int deviceIndex,
     SDL_Joystick *joyhandle = SDL_GameControllerGetJoystick(controller);
     joystickID = SDL_JoystickInstanceID(joyhandle);
 
+    sensorRate = 0.0f;
+    sensorTimestamps[0] = sensorTimestamps[1] = 0;
+
+    refreshBindTables();
+
     for (int i = 0; i < NUMBER_JOYSETS; i++)
     {
         GameControllerSet *controllerset = new GameControllerSet(this, i, this);
@@ -67,6 +79,10 @@ QString GameController::getSDLName()
     {
         temp = SDL_GameControllerName(controller);
     }
+    else
+    {
+        temp = detachedSDLName;
+    }
 
     return temp;
 }
@@ -94,6 +110,10 @@ QString GameController::getRawGUIDString()
             temp = QString(guidString);
         }
     }
+    else
+    {
+        temp = detachedGUIDString;
+    }
 
     return temp;
 }
@@ -114,6 +134,37 @@ void GameController::closeSDLDevice()
     }
 }
 
+void GameController::detachSDLDevice()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    detachedGUIDString = getRawGUIDString();
+    detachedSDLName = getSDLName();
+
+    // Handle has to be closed even though the device is no longer attached.
+    if (controller != nullptr)
+    {
+        SDL_GameControllerClose(controller);
+        controller = nullptr;
+    }
+}
+
+void GameController::rebindSDLDevice(SDL_GameController *controller, int deviceIndex)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    this->controller = controller;
+    joystickID = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller));
+    setIndex(deviceIndex);
+    refreshBindTables();
+
+    detachedGUIDString = QString();
+    detachedSDLName = QString();
+
+    motion.resetState();
+    refreshSensorState();
+}
+
 int GameController::getNumberRawButtons()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -144,54 +195,6 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
     {
         transferReset();
 
-        QHash<int, SDL_GameControllerButton> buttons;
-        QHash<int, SDL_GameControllerAxis> axes;
-        QList<SDL_GameControllerButtonBind> hatButtons;
-
-        for (int i = 0; i < SDL_JoystickNumHats(this->joyhandle); i++)
-        {
-
-            SDL_GameControllerButton currentButton = static_cast<SDL_GameControllerButton>(i);
-            SDL_GameControllerButtonBind bound = SDL_GameControllerGetBindForButton(this->controller, currentButton);
-
-            #ifndef QT_DEBUG_NO_OUTPUT
-            qDebug() << "Hat " << (i + 1);
-            #endif
-
-            if (bound.bindType == SDL_CONTROLLER_BINDTYPE_HAT)
-            {
-                hatButtons.append(bound);
-            }
-        }
-
-        for (int i = 0; i < SDL_JoystickNumButtons(this->joyhandle); i++)
-        {
-            #ifndef QT_DEBUG_NO_OUTPUT
-            qDebug() << "Button " << (i + 1);
-            #endif
-
-            SDL_GameControllerButton currentButton = static_cast<SDL_GameControllerButton>(i);
-            SDL_GameControllerButtonBind bound = SDL_GameControllerGetBindForButton(this->controller, currentButton);
-            if (bound.bindType == SDL_CONTROLLER_BINDTYPE_BUTTON)
-            {
-                buttons.insert(bound.value.button, currentButton);
-            }
-        }
-
-        for (int i = 0; i < SDL_JoystickNumAxes(this->joyhandle); i++)
-        {
-            #ifndef QT_DEBUG_NO_OUTPUT
-            qDebug() << "Axis " << (i + 1);
-            #endif
-
-            SDL_GameControllerAxis currentAxis = static_cast<SDL_GameControllerAxis>(i);
-            SDL_GameControllerButtonBind bound = SDL_GameControllerGetBindForAxis(this->controller, currentAxis);
-            if (bound.bindType == SDL_CONTROLLER_BINDTYPE_AXIS)
-            {
-                axes.insert(bound.value.axis, currentAxis);
-            }
-        }
-
         xml->readNextStartElement();
         while (!xml->atEnd() && (!xml->isEndElement() && (xml->name() != "joystick")))
         {
@@ -208,7 +211,7 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                         if ((index >= 0) && (index < getJoystick_sets().size()))
                         {
                             GameControllerSet *currentSet = qobject_cast<GameControllerSet*>(getJoystick_sets().value(index)); // static_cast
-                            currentSet->readJoystickConfig(xml, buttons, axes, hatButtons);
+                            currentSet->readJoystickConfig(xml, this);
                         }
                     }
                     else
@@ -235,8 +238,8 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                         index = index - 1;
                         if ((index >= 0) && !temp.isEmpty())
                         {
-                            SDL_GameControllerButton current = buttons.value(index);
-                            if (current)
+                            int current = getButtonForRawButton(index);
+                            if (current >= 0)
                             {
                                 setButtonName(current, temp);
                             }
@@ -251,8 +254,8 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                         buttonIndex = buttonIndex - 1;
                         if ((index >= 0) && !temp.isEmpty())
                         {
-                            SDL_GameControllerAxis current = axes.value(index);
-                            if (current)
+                            int current = getAxisForRawAxis(index);
+                            if (current >= 0)
                             {
                                 if (current == SDL_CONTROLLER_AXIS_LEFTX)
                                 {
@@ -300,18 +303,7 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                         index = index - 1;
                         if ((index >= 0) && !temp.isEmpty())
                         {
-                            bool found = false;
-                            QListIterator<SDL_GameControllerButtonBind> iter(hatButtons);
-                            SDL_GameControllerButtonBind current;
-                            while (iter.hasNext())
-                            {
-                                current = iter.next();
-                                if (current.value.hat.hat == index)
-                                {
-                                    found = true;
-                                    iter.toBack();
-                                }
-                            }
+                            bool found = isRawHatBound(index);
 
                             if (found)
                             {
@@ -335,18 +327,7 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                         index = index - 1;
                         if ((index >= 0) && !temp.isEmpty())
                         {
-                            bool found = false;
-                            QListIterator<SDL_GameControllerButtonBind> iter(hatButtons);
-                            SDL_GameControllerButtonBind current;
-                            while (iter.hasNext())
-                            {
-                                current = iter.next();
-                                if (current.value.hat.hat == index)
-                                {
-                                    found = true;
-                                    iter.toBack();
-                                }
-                            }
+                            bool found = isRawHatBound(index);
 
                             if (found)
                             {
@@ -369,10 +350,10 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                         index = index - 1;
                         if ((index >= 0) && !temp.isEmpty())
                         {
-                            if (axes.contains(index))
+                            int current = getAxisForRawAxis(index);
+                            if (current >= 0)
                             {
-                                SDL_GameControllerAxis current = axes.value(index);
-                                setAxisName(static_cast<int>(current), temp);
+                                setAxisName(current, temp);
                             }
                         }
                     }
@@ -393,18 +374,7 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                         index = index - 1;
                         if ((index >= 0) && !temp.isEmpty() && !vdpadNameExists)
                         {
-                            bool found = false;
-                            QListIterator<SDL_GameControllerButtonBind> iter(hatButtons);
-                            SDL_GameControllerButtonBind current;
-                            while (iter.hasNext())
-                            {
-                                current = iter.next();
-                                if (current.value.hat.hat == index)
-                                {
-                                    found = true;
-                                    iter.toBack();
-                                }
-                            }
+                            bool found = isRawHatBound(index);
 
                             if (found)
                             {
@@ -428,18 +398,7 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                         index = index - 1;
                         if ((index >= 0) && !temp.isEmpty() && !dpadNameExists)
                         {
-                            bool found = false;
-                            QListIterator<SDL_GameControllerButtonBind> iter(hatButtons);
-                            SDL_GameControllerButtonBind current;
-                            while (iter.hasNext())
-                            {
-                                current = iter.next();
-                                if (current.value.hat.hat == index)
-                                {
-                                    found = true;
-                                    iter.toBack();
-                                }
-                            }
+                            bool found = isRawHatBound(index);
 
                             if (found)
                             {
@@ -631,6 +590,11 @@ void GameController::readConfig(QXmlStreamReader *xml)
                 QString temptext = xml->readElementText();
                 this->setProfileName(temptext);
             }
+            else if ((xml->name() == GameControllerMotion::xmlName) && xml->isStartElement())
+            {
+                motion.readConfig(xml);
+                refreshSensorState();
+            }
             else
             {
                 // If none of the above, skip the element
@@ -781,6 +745,8 @@ void GameController::writeConfig(QXmlStreamWriter *xml)
         xml->writeTextElement("keyPressTime", QString::number(keyPressTime));
     }
 
+    motion.writeConfig(xml);
+
     xml->writeStartElement("sets");
     for (int i=0; i < getJoystick_sets().size(); i++)
     {
@@ -795,9 +761,7 @@ QString GameController::getBindStringForAxis(int index, bool)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
     QString temp = QString();
-    SDL_GameControllerButtonBind bind =
-            SDL_GameControllerGetBindForAxis(controller,
-                                             static_cast<SDL_GameControllerAxis>(index));
+    SDL_GameControllerButtonBind bind = getBindForAxis(index);
     if (bind.bindType != SDL_CONTROLLER_BINDTYPE_NONE)
     {
 
@@ -817,9 +781,7 @@ QString GameController::getBindStringForButton(int index, bool trueIndex)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
     QString temp = QString();
-    SDL_GameControllerButtonBind bind =
-            SDL_GameControllerGetBindForButton(controller,
-                                               static_cast<SDL_GameControllerButton>(index));
+    SDL_GameControllerButtonBind bind = getBindForButton(index);
 
     if (bind.bindType != SDL_CONTROLLER_BINDTYPE_NONE)
     {
@@ -845,17 +807,165 @@ QString GameController::getBindStringForButton(int index, bool trueIndex)
 SDL_GameControllerButtonBind GameController::getBindForAxis(int index)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
-    SDL_GameControllerButtonBind bind = SDL_GameControllerGetBindForAxis(controller, static_cast<SDL_GameControllerAxis>(index));
+    SDL_GameControllerButtonBind bind;
+    bind.bindType = SDL_CONTROLLER_BINDTYPE_NONE;
+
+    if ((index >= 0) && (index < SDL_CONTROLLER_AXIS_MAX))
+    {
+        bind = axisBinds[index];
+    }
+
     return bind;
 }
 
 SDL_GameControllerButtonBind GameController::getBindForButton(int index)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
-    SDL_GameControllerButtonBind bind = SDL_GameControllerGetBindForButton(controller, static_cast<SDL_GameControllerButton>(index));
+    SDL_GameControllerButtonBind bind;
+    bind.bindType = SDL_CONTROLLER_BINDTYPE_NONE;
+
+    if ((index >= 0) && (index < SDL_CONTROLLER_BUTTON_MAX))
+    {
+        bind = buttonBinds[index];
+    }
+
     return bind;
 }
 
+/**
+ * @brief Resolve the bind map of the current controller mapping into flat
+ *     lookup tables. Needs to be called whenever the SDL handle or the
+ *     mapping of the device changes.
+ */
+void GameController::refreshBindTables()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    int numRawButtons = 0;
+    int numRawAxes = 0;
+    int numRawHats = 0;
+
+    SDL_Joystick *joyhandle = nullptr;
+    if (controller != nullptr)
+    {
+        joyhandle = SDL_GameControllerGetJoystick(controller);
+    }
+
+    if (joyhandle != nullptr)
+    {
+        numRawButtons = SDL_JoystickNumButtons(joyhandle);
+        numRawAxes = SDL_JoystickNumAxes(joyhandle);
+        numRawHats = SDL_JoystickNumHats(joyhandle);
+    }
+
+    for (int i = 0; i < SDL_CONTROLLER_BUTTON_MAX; i++)
+    {
+        buttonBinds[i].bindType = SDL_CONTROLLER_BINDTYPE_NONE;
+        if (controller != nullptr)
+        {
+            buttonBinds[i] = SDL_GameControllerGetBindForButton(controller, static_cast<SDL_GameControllerButton>(i));
+        }
+
+        if (buttonBinds[i].bindType == SDL_CONTROLLER_BINDTYPE_BUTTON)
+        {
+            numRawButtons = qMax(numRawButtons, buttonBinds[i].value.button + 1);
+        }
+        else if (buttonBinds[i].bindType == SDL_CONTROLLER_BINDTYPE_HAT)
+        {
+            numRawHats = qMax(numRawHats, buttonBinds[i].value.hat.hat + 1);
+        }
+    }
+
+    for (int i = 0; i < SDL_CONTROLLER_AXIS_MAX; i++)
+    {
+        axisBinds[i].bindType = SDL_CONTROLLER_BINDTYPE_NONE;
+        if (controller != nullptr)
+        {
+            axisBinds[i] = SDL_GameControllerGetBindForAxis(controller, static_cast<SDL_GameControllerAxis>(i));
+        }
+
+        if (axisBinds[i].bindType == SDL_CONTROLLER_BINDTYPE_AXIS)
+        {
+            numRawAxes = qMax(numRawAxes, axisBinds[i].value.axis + 1);
+        }
+    }
+
+    rawButtonBinds.fill(-1, numRawButtons);
+    rawAxisBinds.fill(-1, numRawAxes);
+    rawHatMasks.fill(0, numRawHats);
+
+    for (int i = 0; i < SDL_CONTROLLER_BUTTON_MAX; i++)
+    {
+        SDL_GameControllerButtonBind &bind = buttonBinds[i];
+        if (bind.bindType == SDL_CONTROLLER_BINDTYPE_BUTTON)
+        {
+            rawButtonBinds[bind.value.button] = i;
+        }
+        else if (bind.bindType == SDL_CONTROLLER_BINDTYPE_HAT)
+        {
+            rawHatMasks[bind.value.hat.hat] |= bind.value.hat.hat_mask;
+        }
+    }
+
+    for (int i = 0; i < SDL_CONTROLLER_AXIS_MAX; i++)
+    {
+        SDL_GameControllerButtonBind &bind = axisBinds[i];
+        if (bind.bindType == SDL_CONTROLLER_BINDTYPE_AXIS)
+        {
+            rawAxisBinds[bind.value.axis] = i;
+        }
+    }
+}
+
+/**
+ * @brief Get the controller button bound to a raw joystick button.
+ * @param Raw button index
+ * @return SDL_GameControllerButton value or -1 if the raw button is unbound
+ */
+int GameController::getButtonForRawButton(int rawButton)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    int result = -1;
+    if ((rawButton >= 0) && (rawButton < rawButtonBinds.size()))
+    {
+        result = rawButtonBinds.at(rawButton);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Get the controller axis bound to a raw joystick axis.
+ * @param Raw axis index
+ * @return SDL_GameControllerAxis value or -1 if the raw axis is unbound
+ */
+int GameController::getAxisForRawAxis(int rawAxis)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    int result = -1;
+    if ((rawAxis >= 0) && (rawAxis < rawAxisBinds.size()))
+    {
+        result = rawAxisBinds.at(rawAxis);
+    }
+
+    return result;
+}
+
+bool GameController::isRawHatBound(int rawHat)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    bool result = false;
+    if ((rawHat >= 0) && (rawHat < rawHatMasks.size()))
+    {
+        result = rawHatMasks.at(rawHat) != 0;
+    }
+
+    return result;
+}
+
 void GameController::buttonClickEvent(int buttonindex)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -1010,6 +1120,115 @@ void GameController::rawDPadEvent(int index, int value)
     }
 }
 
+/**
+ * @brief Pass a sensor sample to the gyro mouse. Gyro movement is sent
+ *     right away instead of waiting for the mouse event timer.
+ * @param SDL_SensorType of the sample
+ * @param Sensor values
+ * @param Sample time in microseconds
+ * @param Whether the sample time comes from the sensor. Event times only
+ *     have millisecond resolution, so samples are spaced by the sensor
+ *     rate instead while the event time stays close.
+ */
+void GameController::rawSensorEvent(int sensor, const float *data, quint64 timestamp, bool preciseTimestamp)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    if ((sensor == SDL_SENSOR_ACCEL) || (sensor == SDL_SENSOR_GYRO))
+    {
+        quint64 &lastTimestamp = sensorTimestamps[(sensor == SDL_SENSOR_GYRO) ? 1 : 0];
+        if (!preciseTimestamp && (sensorRate > 0.0f) && (lastTimestamp != 0))
+        {
+            quint64 estimate = lastTimestamp + static_cast<quint64>(1000000.0f / sensorRate);
+            if (qAbs(static_cast<qint64>(timestamp) - static_cast<qint64>(estimate)) < MAXSENSORTIMESTAMPDRIFT)
+            {
+                timestamp = estimate;
+            }
+        }
+
+        lastTimestamp = timestamp;
+
+        if (sensor == SDL_SENSOR_ACCEL)
+        {
+            motion.accelerometerSample(data, timestamp);
+        }
+        else
+        {
+            int mouseX = 0;
+            int mouseY = 0;
+            if (motion.gyroSample(data, timestamp, mouseX, mouseY))
+            {
+                PadderCommon::OutputStageLocker outputLocker;
+                sendevent(mouseX, mouseY);
+            }
+        }
+    }
+#else
+    Q_UNUSED(sensor);
+    Q_UNUSED(data);
+    Q_UNUSED(timestamp);
+    Q_UNUSED(preciseTimestamp);
+#endif
+}
+
+GameControllerMotion* GameController::getMotion()
+{
+    return &motion;
+}
+
+void GameController::setMotionEnabled(bool enabled)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    motion.setEnabled(enabled);
+    refreshSensorState();
+}
+
+/**
+ * @brief Turn the controller sensors on while the gyro mouse is enabled.
+ *     Sensors are off by default since they raise the event rate of the
+ *     device considerably.
+ */
+void GameController::refreshSensorState()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    sensorRate = 0.0f;
+    sensorTimestamps[0] = sensorTimestamps[1] = 0;
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    if (controller != nullptr)
+    {
+        SDL_bool state = motion.isEnabled() ? SDL_TRUE : SDL_FALSE;
+
+        if (SDL_GameControllerHasSensor(controller, SDL_SENSOR_GYRO))
+        {
+            SDL_GameControllerSetSensorEnabled(controller, SDL_SENSOR_GYRO, state);
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+            sensorRate = SDL_GameControllerGetSensorDataRate(controller, SDL_SENSOR_GYRO);
+#endif
+        }
+
+        if (SDL_GameControllerHasSensor(controller, SDL_SENSOR_ACCEL))
+        {
+            SDL_GameControllerSetSensorEnabled(controller, SDL_SENSOR_ACCEL, state);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Reset the gyro mouse along with the sets so a profile that does
+ *     not mention it turns it off.
+ */
+void GameController::transferReset()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    InputDevice::transferReset();
+
+    motion.reset();
+    refreshSensorState();
+}
 
 QHash<int, bool> const& GameController::getRawbuttons()  {
 
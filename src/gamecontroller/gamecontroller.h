@@ -20,6 +20,9 @@
 
 #include <SDL2/SDL_gamecontroller.h>
 #include <inputdevice.h>
+#include "gamecontrollermotion.h"
+
+#include <QVector>
 
 
 class QXmlStreamReader;
@@ -44,6 +47,8 @@ public:
     virtual QString getXmlName();
     virtual bool isGameController();
     virtual void closeSDLDevice();
+    virtual void detachSDLDevice();
+    void rebindSDLDevice(SDL_GameController *controller, int deviceIndex);
     virtual SDL_JoystickID getSDLJoystickID();
 
     virtual int getNumberRawButtons();
@@ -56,10 +61,20 @@ public:
     SDL_GameControllerButtonBind getBindForAxis(int index);
     SDL_GameControllerButtonBind getBindForButton(int index);
 
+    void refreshBindTables();
+    int getButtonForRawButton(int rawButton);
+    int getAxisForRawAxis(int rawAxis);
+    bool isRawHatBound(int rawHat);
+
     bool isRelevantGUID(QString tempGUID);
     void rawButtonEvent(int index, bool pressed);
     void rawAxisEvent(int index, int value);
     void rawDPadEvent(int index, int value);
+    void rawSensorEvent(int sensor, const float *data, quint64 timestamp, bool preciseTimestamp);
+
+    GameControllerMotion* getMotion();
+    void setMotionEnabled(bool enabled);
+    void refreshSensorState();
 
     QHash<int, bool> const& getRawbuttons();
     QHash<int, int> const& getAxisvalues();
@@ -75,6 +90,7 @@ protected:
 public slots:
     virtual void readConfig(QXmlStreamReader *xml);
     virtual void writeConfig(QXmlStreamWriter *xml);
+    virtual void transferReset();
 
 protected slots:
     virtual void axisActivatedEvent(int setindex, int axisindex, int value);
@@ -89,6 +105,25 @@ private:
     SDL_JoystickID joystickID;
     SDL_GameController *controller;
 
+    // Bind tables resolved once per mapping. Logical to raw binds are
+    // indexed by SDL_GameControllerButton and SDL_GameControllerAxis.
+    // Raw to logical tables hold -1 for unbound raw elements.
+    SDL_GameControllerButtonBind buttonBinds[SDL_CONTROLLER_BUTTON_MAX];
+    SDL_GameControllerButtonBind axisBinds[SDL_CONTROLLER_AXIS_MAX];
+    QVector<int> rawButtonBinds;
+    QVector<int> rawAxisBinds;
+    QVector<int> rawHatMasks;
+
+    // Gyro mouse and the state used to time samples when SDL does not
+    // provide sensor timestamps.
+    GameControllerMotion motion;
+    float sensorRate;
+    quint64 sensorTimestamps[2];
+
+    // Identity of a detached device. Used while waiting for a reconnect.
+    QString detachedGUIDString;
+    QString detachedSDLName;
+
 };
 
 #endif // GAMECONTROLLER_H
@@ -0,0 +1,508 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gamecontrollermotion.h"
+
+#include <QMutexLocker>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#include <cmath>
+
+// Sensitivity is in pixels per degree of rotation.
+const double GameControllerMotion::DEFAULTSENSITIVITY = 8.0;
+const double GameControllerMotion::MAXSENSITIVITY = 100.0;
+
+// Dead zone and smoothing threshold are in degrees per second.
+const double GameControllerMotion::DEFAULTDEADZONE = 0.0;
+const double GameControllerMotion::DEFAULTSMOOTHINGTHRESHOLD = 5.0;
+const double GameControllerMotion::MAXANGULARSPEED = 360.0;
+
+const GameControllerMotion::HorizontalAxis GameControllerMotion::DEFAULTHORIZONTALAXIS =
+        GameControllerMotion::PlayerSpaceAxis;
+const QString GameControllerMotion::xmlName = "gyromouse";
+
+static const double RADTODEG = 57.29577951308232;
+
+// Samples further apart than this are treated as a gap in the stream.
+static const double MAXSAMPLEINTERVAL = 0.05;
+
+// Time constants in seconds of the gravity estimate and of the
+// smoothing applied to slow rotation.
+static const double GRAVITYTIME = 0.25;
+static const double SMOOTHINGTIME = 0.125;
+
+// Allow player space yaw to pick up some roll so turning does not feel
+// damped when the controller is held at an angle.
+static const double YAWRELAXFACTOR = 1.41;
+
+
+GameControllerMotion::GameControllerMotion()
+{
+    reset();
+}
+
+/**
+ * @brief Restore the default settings and forget the sensor state.
+ */
+void GameControllerMotion::reset()
+{
+    QMutexLocker locker(&mutex);
+
+    enabled = false;
+    sensitivityX = DEFAULTSENSITIVITY;
+    sensitivityY = DEFAULTSENSITIVITY;
+    invertX = false;
+    invertY = false;
+    horizontalAxis = DEFAULTHORIZONTALAXIS;
+    deadZone = DEFAULTDEADZONE;
+    smoothingThreshold = DEFAULTSMOOTHINGTHRESHOLD;
+
+    resetStateLocked();
+}
+
+/**
+ * @brief Forget the sensor state. Used when the device reconnects so the
+ *     first samples are not measured against an old timestamp.
+ */
+void GameControllerMotion::resetState()
+{
+    QMutexLocker locker(&mutex);
+
+    resetStateLocked();
+}
+
+void GameControllerMotion::resetStateLocked()
+{
+    gravity[0] = 0.0;
+    gravity[1] = 1.0;
+    gravity[2] = 0.0;
+    gravityValid = false;
+    lastAccelTimestamp = 0;
+    lastGyroTimestamp = 0;
+    gyroTimestampValid = false;
+    smoothedX = 0.0;
+    smoothedY = 0.0;
+    accumulatorX.reset();
+    accumulatorY.reset();
+}
+
+bool GameControllerMotion::isDefault()
+{
+    QMutexLocker locker(&mutex);
+
+    return !enabled &&
+           qFuzzyCompare(sensitivityX, DEFAULTSENSITIVITY) &&
+           qFuzzyCompare(sensitivityY, DEFAULTSENSITIVITY) &&
+           !invertX && !invertY &&
+           (horizontalAxis == DEFAULTHORIZONTALAXIS) &&
+           qFuzzyCompare(deadZone + 1.0, DEFAULTDEADZONE + 1.0) &&
+           qFuzzyCompare(smoothingThreshold + 1.0, DEFAULTSMOOTHINGTHRESHOLD + 1.0);
+}
+
+bool GameControllerMotion::isEnabled()
+{
+    QMutexLocker locker(&mutex);
+
+    return enabled;
+}
+
+void GameControllerMotion::setEnabled(bool enabled)
+{
+    QMutexLocker locker(&mutex);
+
+    this->enabled = enabled;
+    resetStateLocked();
+}
+
+double GameControllerMotion::getSensitivityX()
+{
+    QMutexLocker locker(&mutex);
+
+    return sensitivityX;
+}
+
+void GameControllerMotion::setSensitivityX(double value)
+{
+    QMutexLocker locker(&mutex);
+
+    if ((value > 0.0) && (value <= MAXSENSITIVITY))
+    {
+        sensitivityX = value;
+    }
+}
+
+double GameControllerMotion::getSensitivityY()
+{
+    QMutexLocker locker(&mutex);
+
+    return sensitivityY;
+}
+
+void GameControllerMotion::setSensitivityY(double value)
+{
+    QMutexLocker locker(&mutex);
+
+    if ((value > 0.0) && (value <= MAXSENSITIVITY))
+    {
+        sensitivityY = value;
+    }
+}
+
+bool GameControllerMotion::isInvertedX()
+{
+    QMutexLocker locker(&mutex);
+
+    return invertX;
+}
+
+void GameControllerMotion::setInvertedX(bool inverted)
+{
+    QMutexLocker locker(&mutex);
+
+    invertX = inverted;
+}
+
+bool GameControllerMotion::isInvertedY()
+{
+    QMutexLocker locker(&mutex);
+
+    return invertY;
+}
+
+void GameControllerMotion::setInvertedY(bool inverted)
+{
+    QMutexLocker locker(&mutex);
+
+    invertY = inverted;
+}
+
+GameControllerMotion::HorizontalAxis GameControllerMotion::getHorizontalAxis()
+{
+    QMutexLocker locker(&mutex);
+
+    return horizontalAxis;
+}
+
+void GameControllerMotion::setHorizontalAxis(HorizontalAxis axis)
+{
+    QMutexLocker locker(&mutex);
+
+    horizontalAxis = axis;
+}
+
+double GameControllerMotion::getDeadZone()
+{
+    QMutexLocker locker(&mutex);
+
+    return deadZone;
+}
+
+void GameControllerMotion::setDeadZone(double value)
+{
+    QMutexLocker locker(&mutex);
+
+    if ((value >= 0.0) && (value <= MAXANGULARSPEED))
+    {
+        deadZone = value;
+    }
+}
+
+double GameControllerMotion::getSmoothingThreshold()
+{
+    QMutexLocker locker(&mutex);
+
+    return smoothingThreshold;
+}
+
+void GameControllerMotion::setSmoothingThreshold(double value)
+{
+    QMutexLocker locker(&mutex);
+
+    if ((value >= 0.0) && (value <= MAXANGULARSPEED))
+    {
+        smoothingThreshold = value;
+    }
+}
+
+/**
+ * @brief Update the gravity estimate with an accelerometer sample. The
+ *     estimate is low pass filtered so short movements of the controller
+ *     do not tilt it.
+ * @param Acceleration along the X, Y and Z axes in m/s^2
+ * @param Sample time in microseconds
+ */
+void GameControllerMotion::accelerometerSample(const float data[3], quint64 timestamp)
+{
+    QMutexLocker locker(&mutex);
+
+    double length = sqrt((static_cast<double>(data[0]) * data[0]) +
+                         (static_cast<double>(data[1]) * data[1]) +
+                         (static_cast<double>(data[2]) * data[2]));
+
+    if (length > 0.001)
+    {
+        double alpha = 1.0;
+        if (gravityValid && (timestamp > lastAccelTimestamp))
+        {
+            double elapsed = qMin((timestamp - lastAccelTimestamp) / 1000000.0, MAXSAMPLEINTERVAL);
+            alpha = 1.0 - exp(-elapsed / GRAVITYTIME);
+        }
+        else if (gravityValid)
+        {
+            alpha = 0.0;
+        }
+
+        double gravityLength = 0.0;
+        for (int i = 0; i < 3; i++)
+        {
+            gravity[i] += ((data[i] / length) - gravity[i]) * alpha;
+            gravityLength += gravity[i] * gravity[i];
+        }
+
+        gravityLength = sqrt(gravityLength);
+        if (gravityLength > 0.001)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                gravity[i] /= gravityLength;
+            }
+        }
+
+        gravityValid = true;
+        lastAccelTimestamp = timestamp;
+    }
+}
+
+/**
+ * @brief Turn a gyroscope sample into mouse movement. Rotation is
+ *     integrated over the time since the previous sample, so the output
+ *     does not depend on the sample rate.
+ * @param Angular velocity around the X (pitch), Y (yaw) and Z (roll)
+ *     axes in radians per second. Counter-clockwise is positive.
+ * @param Sample time in microseconds
+ * @param [out] Horizontal movement in pixels
+ * @param [out] Vertical movement in pixels
+ * @return Whether the sample produced movement
+ */
+bool GameControllerMotion::gyroSample(const float data[3], quint64 timestamp, int &mouseX, int &mouseY)
+{
+    QMutexLocker locker(&mutex);
+
+    mouseX = 0;
+    mouseY = 0;
+
+    if (!enabled)
+    {
+        return false;
+    }
+
+    if (gyroTimestampValid && (timestamp > lastGyroTimestamp) &&
+        (((timestamp - lastGyroTimestamp) / 1000000.0) <= MAXSAMPLEINTERVAL))
+    {
+        double elapsed = (timestamp - lastGyroTimestamp) / 1000000.0;
+        double pitch = data[0] * RADTODEG;
+        double yaw = data[1] * RADTODEG;
+        double roll = data[2] * RADTODEG;
+
+        // Rates in degrees per second. Right and down are positive like
+        // on screen.
+        double rateX = -yaw;
+        double rateY = -pitch;
+
+        if (horizontalAxis == RollAxis)
+        {
+            rateX = -roll;
+        }
+        else if (horizontalAxis == PlayerSpaceAxis)
+        {
+            // Rotation around the up vector, regardless of how far the
+            // controller is tilted towards the player.
+            double worldYaw = (gravity[1] * yaw) + (gravity[2] * roll);
+            double magnitude = qMin(fabs(worldYaw) * YAWRELAXFACTOR,
+                                    sqrt((yaw * yaw) + (roll * roll)));
+            rateX = (worldYaw < 0.0) ? magnitude : -magnitude;
+        }
+
+        double speed = sqrt((rateX * rateX) + (rateY * rateY));
+
+        // Scale down instead of cutting off so slow aiming is not lost
+        // entirely.
+        if ((deadZone > 0.0) && (speed < deadZone))
+        {
+            double scale = speed / deadZone;
+            rateX *= scale;
+            rateY *= scale;
+            speed *= scale;
+        }
+
+        // Slow rotation is mostly sensor noise. Blend it towards a
+        // smoothed value and pass fast rotation through directly.
+        if (smoothingThreshold > 0.0)
+        {
+            double lower = smoothingThreshold * 0.5;
+            double directWeight = qBound(0.0, (speed - lower) / (smoothingThreshold - lower), 1.0);
+            double blend = 1.0 - exp(-elapsed / SMOOTHINGTIME);
+
+            smoothedX += ((rateX * (1.0 - directWeight)) - smoothedX) * blend;
+            smoothedY += ((rateY * (1.0 - directWeight)) - smoothedY) * blend;
+            rateX = (rateX * directWeight) + smoothedX;
+            rateY = (rateY * directWeight) + smoothedY;
+        }
+
+        double distanceX = rateX * elapsed * sensitivityX;
+        double distanceY = rateY * elapsed * sensitivityY;
+
+        mouseX = accumulatorX.add(invertX ? -distanceX : distanceX);
+        mouseY = accumulatorY.add(invertY ? -distanceY : distanceY);
+    }
+
+    lastGyroTimestamp = timestamp;
+    gyroTimestampValid = true;
+
+    return (mouseX != 0) || (mouseY != 0);
+}
+
+void GameControllerMotion::readConfig(QXmlStreamReader *xml)
+{
+    if (xml->isStartElement() && (xml->name() == xmlName))
+    {
+        xml->readNextStartElement();
+        while (!xml->atEnd() && (!xml->isEndElement() && (xml->name() != xmlName)))
+        {
+            if ((xml->name() == "enabled") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                setEnabled(temptext == "true");
+            }
+            else if ((xml->name() == "sensitivityx") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                setSensitivityX(temptext.toDouble());
+            }
+            else if ((xml->name() == "sensitivityy") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                setSensitivityY(temptext.toDouble());
+            }
+            else if ((xml->name() == "invertx") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                setInvertedX(temptext == "true");
+            }
+            else if ((xml->name() == "inverty") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                setInvertedY(temptext == "true");
+            }
+            else if ((xml->name() == "horizontalaxis") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                if (temptext == "yaw")
+                {
+                    setHorizontalAxis(YawAxis);
+                }
+                else if (temptext == "roll")
+                {
+                    setHorizontalAxis(RollAxis);
+                }
+                else if (temptext == "playerspace")
+                {
+                    setHorizontalAxis(PlayerSpaceAxis);
+                }
+            }
+            else if ((xml->name() == "deadzone") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                setDeadZone(temptext.toDouble());
+            }
+            else if ((xml->name() == "smoothingthreshold") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                setSmoothingThreshold(temptext.toDouble());
+            }
+            else
+            {
+                // If none of the above, skip the element
+                xml->skipCurrentElement();
+            }
+
+            xml->readNextStartElement();
+        }
+    }
+}
+
+void GameControllerMotion::writeConfig(QXmlStreamWriter *xml)
+{
+    if (!isDefault())
+    {
+        QMutexLocker locker(&mutex);
+
+        xml->writeStartElement(xmlName);
+
+        xml->writeTextElement("enabled", enabled ? "true" : "false");
+
+        if (!qFuzzyCompare(sensitivityX, DEFAULTSENSITIVITY))
+        {
+            xml->writeTextElement("sensitivityx", QString::number(sensitivityX));
+        }
+
+        if (!qFuzzyCompare(sensitivityY, DEFAULTSENSITIVITY))
+        {
+            xml->writeTextElement("sensitivityy", QString::number(sensitivityY));
+        }
+
+        if (invertX)
+        {
+            xml->writeTextElement("invertx", "true");
+        }
+
+        if (invertY)
+        {
+            xml->writeTextElement("inverty", "true");
+        }
+
+        if (horizontalAxis != DEFAULTHORIZONTALAXIS)
+        {
+            if (horizontalAxis == YawAxis)
+            {
+                xml->writeTextElement("horizontalaxis", "yaw");
+            }
+            else if (horizontalAxis == RollAxis)
+            {
+                xml->writeTextElement("horizontalaxis", "roll");
+            }
+            else
+            {
+                xml->writeTextElement("horizontalaxis", "playerspace");
+            }
+        }
+
+        if (!qFuzzyCompare(deadZone + 1.0, DEFAULTDEADZONE + 1.0))
+        {
+            xml->writeTextElement("deadzone", QString::number(deadZone));
+        }
+
+        if (!qFuzzyCompare(smoothingThreshold + 1.0, DEFAULTSMOOTHINGTHRESHOLD + 1.0))
+        {
+            xml->writeTextElement("smoothingthreshold", QString::number(smoothingThreshold));
+        }
+
+        xml->writeEndElement();
+    }
+}
@@ -0,0 +1,108 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GAMECONTROLLERMOTION_H
+#define GAMECONTROLLERMOTION_H
+
+#include "subpixelaccumulator.h"
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QString>
+
+class QXmlStreamReader;
+class QXmlStreamWriter;
+
+
+/**
+ * @brief Gyro mouse element of a game controller. Turns gyroscope samples
+ *     into relative mouse movement as they arrive, independent of the
+ *     mouse event timer. The accelerometer is used to track gravity so
+ *     horizontal movement can follow the turn of the player instead of a
+ *     fixed controller axis. Samples carry their own timestamps so a
+ *     recorded sensor stream produces the same output as the device.
+ */
+class GameControllerMotion
+{
+public:
+    enum HorizontalAxis {YawAxis=0, RollAxis, PlayerSpaceAxis};
+
+    GameControllerMotion();
+
+    void reset();
+    void resetState();
+    bool isDefault();
+
+    bool isEnabled();
+    void setEnabled(bool enabled);
+    double getSensitivityX();
+    void setSensitivityX(double value);
+    double getSensitivityY();
+    void setSensitivityY(double value);
+    bool isInvertedX();
+    void setInvertedX(bool inverted);
+    bool isInvertedY();
+    void setInvertedY(bool inverted);
+    HorizontalAxis getHorizontalAxis();
+    void setHorizontalAxis(HorizontalAxis axis);
+    double getDeadZone();
+    void setDeadZone(double value);
+    double getSmoothingThreshold();
+    void setSmoothingThreshold(double value);
+
+    void accelerometerSample(const float data[3], quint64 timestamp);
+    bool gyroSample(const float data[3], quint64 timestamp, int &mouseX, int &mouseY);
+
+    void readConfig(QXmlStreamReader *xml);
+    void writeConfig(QXmlStreamWriter *xml);
+
+    static const double DEFAULTSENSITIVITY;
+    static const double MAXSENSITIVITY;
+    static const double DEFAULTDEADZONE;
+    static const double DEFAULTSMOOTHINGTHRESHOLD;
+    static const double MAXANGULARSPEED;
+    static const HorizontalAxis DEFAULTHORIZONTALAXIS;
+    static const QString xmlName;
+
+private:
+    void resetStateLocked();
+
+    QMutex mutex;
+
+    bool enabled;
+    double sensitivityX;
+    double sensitivityY;
+    bool invertX;
+    bool invertY;
+    HorizontalAxis horizontalAxis;
+    double deadZone;
+    double smoothingThreshold;
+
+    // Normalized up vector in controller space.
+    double gravity[3];
+    bool gravityValid;
+    quint64 lastAccelTimestamp;
+    quint64 lastGyroTimestamp;
+    bool gyroTimestampValid;
+    double smoothedX;
+    double smoothedY;
+    SubPixelAccumulator accumulatorX;
+    SubPixelAccumulator accumulatorY;
+};
+
+#endif // GAMECONTROLLERMOTION_H
@@ -18,6 +18,7 @@
 #include "gamecontrollerset.h"
 
 #include "messagehandler.h"
+#include "gamecontroller.h"
 #include "gamecontrollerdpad.h"
 #include "gamecontrollertrigger.h"
 #include "inputdevice.h"
@@ -85,10 +86,7 @@ void GameControllerSet::populateSticksDPad()
     getJoyAxis(SDL_CONTROLLER_AXIS_TRIGGERRIGHT)->setDefaultAxisName(trUtf8("R Trigger"));
 }
 
-void GameControllerSet::readJoystickConfig(QXmlStreamReader *xml,
-                                           QHash<int, SDL_GameControllerButton> &buttons,
-                                           QHash<int, SDL_GameControllerAxis> &axes,
-                                           QList<SDL_GameControllerButtonBind> &hatButtons)
+void GameControllerSet::readJoystickConfig(QXmlStreamReader *xml, GameController *controller)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
@@ -105,9 +103,9 @@ void GameControllerSet::readJoystickConfig(QXmlStreamReader *xml,
             {
                 int index = xml->attributes().value("index").toString().toInt();
                 JoyButton *button = nullptr;
-                if (buttons.contains(index-1))
+                int current = controller->getButtonForRawButton(index-1);
+                if (current >= 0)
                 {
-                    SDL_GameControllerButton current = buttons.value(index-1);
                     button = getJoyButton(current);
                 }
 
@@ -124,10 +122,10 @@ void GameControllerSet::readJoystickConfig(QXmlStreamReader *xml,
             {
                 int index = xml->attributes().value("index").toString().toInt();
                 GameControllerTrigger *trigger = nullptr;
-                if (axes.contains(index-1))
+                int current = controller->getAxisForRawAxis(index-1);
+                if (current >= 0)
                 {
-                    SDL_GameControllerAxis current = axes.value(index-1);
-                    trigger = qobject_cast<GameControllerTrigger*>(getJoyAxis(static_cast<int>(current)));
+                    trigger = qobject_cast<GameControllerTrigger*>(getJoyAxis(current));
                 }
 
                 if (trigger != nullptr)
@@ -143,18 +141,7 @@ void GameControllerSet::readJoystickConfig(QXmlStreamReader *xml,
             {
                 int index = xml->attributes().value("index").toString().toInt();
                 index = index - 1;
-                bool found = false;
-                QListIterator<SDL_GameControllerButtonBind> iter(hatButtons);
-                SDL_GameControllerButtonBind current;
-                while (iter.hasNext())
-                {
-                    current = iter.next();
-                    if (current.value.hat.hat == index)
-                    {
-                        found = true;
-                        iter.toBack();
-                    }
-                }
+                bool found = controller->isRawHatBound(index);
 
                 VDPad *dpad = nullptr;
                 if (found)
@@ -198,18 +185,7 @@ void GameControllerSet::readJoystickConfig(QXmlStreamReader *xml,
             {
                 int index = xml->attributes().value("index").toString().toInt();
                 index = index - 1;
-                bool found = false;
-                QListIterator<SDL_GameControllerButtonBind> iter(hatButtons);
-                SDL_GameControllerButtonBind current;
-                while (iter.hasNext())
-                {
-                    current = iter.next();
-                    if (current.value.hat.hat == index)
-                    {
-                        found = true;
-                        iter.toBack();
-                    }
-                }
+                bool found = controller->isRawHatBound(index);
 
                 VDPad *dpad = nullptr;
                 if (found)
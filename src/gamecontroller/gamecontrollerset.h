@@ -27,6 +27,7 @@
 
 class QXmlStreamReader;
 class InputDevice;
+class GameController;
 
 class GameControllerSet : public SetJoystick
 {
@@ -38,10 +39,7 @@ public:
     virtual void refreshAxes();
 
     virtual void readConfig(QXmlStreamReader *xml);
-    virtual void readJoystickConfig(QXmlStreamReader *xml,
-                            QHash<int, SDL_GameControllerButton> &buttons,
-                            QHash<int, SDL_GameControllerAxis> &axes,
-                            QList<SDL_GameControllerButtonBind> &hatButtons); // .., .., QHash<unsigned int..., QHash<unsigned int
+    virtual void readJoystickConfig(QXmlStreamReader *xml, GameController *controller);
 
 protected:
     void populateSticksDPad();
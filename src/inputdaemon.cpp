@@ -26,6 +26,10 @@
 #include "antimicrosettings.h"
 #include "inputdevicebitarraystatus.h"
 
+#ifdef USE_DEVICE_WORKERS
+  #include "deviceworkerpool.h"
+#endif
+
 #include <QDebug>
 #include <QTime>
 #include <QTimer>
@@ -33,16 +37,20 @@
 #include <QMapIterator>
 #include <QThread>
 
+#include <SDL2/SDL_version.h>
+
 #define USE_NEW_REFRESH
 
 const int InputDaemon::GAMECONTROLLERTRIGGERRELEASE = 16384;
+const int InputDaemon::RECONNECTGRACEPERIOD = 10000;
 
 
 InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks,
                          AntiMicroSettings *settings,
                          bool graphical, QObject *parent) :
     QObject(parent),
-    pollResetTimer(this)
+    pollResetTimer(this),
+    reconnectExpireTimer(this)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
@@ -51,7 +59,22 @@ InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks,
     this->graphical = graphical;
     this->settings = settings;
 
+    reconnectClock.start();
+    reconnectExpireTimer.setInterval(500);
+    connect(&reconnectExpireTimer, &QTimer::timeout, this, &InputDaemon::expireReconnectCache);
+
     eventWorker = new SDLEventReader(joysticks, settings);
+
+#ifdef USE_DEVICE_WORKERS
+    deviceWorkers = nullptr;
+    if (graphical)
+    {
+        deviceWorkers = new DeviceWorkerPool(&InputDaemon::processDeviceEvent, 0, this);
+        Logger::LogInfo(QString("Processing devices on %1 worker threads")
+                        .arg(deviceWorkers->getNumberWorkers()));
+    }
+#endif
+
     refreshJoysticks();
 
     sdlWorkerThread = nullptr;
@@ -167,6 +190,7 @@ void InputDaemon::refreshJoysticks()
         InputDevice *joystick = iter.next().value();
         if (joystick != nullptr)
         {
+            releaseDeviceWorker(joystick);
             delete joystick;
             joystick = nullptr;
         }
@@ -208,11 +232,16 @@ void InputDaemon::refreshJoysticks()
                     // Check if user has designated device Joystick mode.
                     if (!disableGameController)
                     {
-                        GameController *damncontroller = new GameController(controller, index, settings, this);
-                        connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
-                        joysticks->insert(tempJoystickID, damncontroller);
-                        trackcontrollers.insert(tempJoystickID, damncontroller);
+                        GameController *damncontroller = reattachCachedController(controller, index);
+                        if (damncontroller == nullptr)
+                        {
+                            damncontroller = new GameController(controller, index, settings, this);
+                            connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
+                            joysticks->insert(tempJoystickID, damncontroller);
+                            trackcontrollers.insert(tempJoystickID, damncontroller);
+                        }
 
+                        assignDeviceWorker(damncontroller);
                         emit deviceAdded(damncontroller);
                     }
                     else
@@ -220,6 +249,7 @@ void InputDaemon::refreshJoysticks()
                         Joystick *joystick = openJoystickDevice(index);
                         if (joystick != nullptr)
                         {
+                            assignDeviceWorker(joystick);
                             emit deviceAdded(joystick);
                         }
 
@@ -237,6 +267,7 @@ void InputDaemon::refreshJoysticks()
             Joystick *joystick = openJoystickDevice(index);
             if (joystick != nullptr)
             {
+                assignDeviceWorker(joystick);
                 emit deviceAdded(joystick);
             }
         }
@@ -293,6 +324,7 @@ void InputDaemon::deleteJoysticks()
         InputDevice *joystick = iter.next().value();
         if (joystick != nullptr)
         {
+            releaseDeviceWorker(joystick);
             delete joystick;
             joystick = nullptr;
         }
@@ -302,6 +334,7 @@ void InputDaemon::deleteJoysticks()
     getTrackjoysticksLocal().clear();
     trackcontrollers.clear();
 
+    flushReconnectCache();
 }
 
 void InputDaemon::stop()
@@ -320,6 +353,14 @@ void InputDaemon::refresh()
 
     Logger::LogInfo("Refreshing joystick list");
 
+    // Keep current devices and their profiles so they can be bound
+    // again once SDL has been restarted.
+    QListIterator<InputDevice*> detachIter(joysticks->values());
+    while (detachIter.hasNext())
+    {
+        detachDevice(detachIter.next());
+    }
+
     QEventLoop q;
     connect(eventWorker, &SDLEventReader::sdlStarted, &q, &QEventLoop::quit);
     QMetaObject::invokeMethod(eventWorker, "refresh", Qt::BlockingQueuedConnection);
@@ -340,6 +381,10 @@ void InputDaemon::refresh()
     q.exec();
 
     refreshJoysticks();
+
+    // Devices that did not come back after the refresh are gone for good.
+    flushReconnectCache();
+
     QTimer::singleShot(100, eventWorker, SLOT(performWork()));
 
     stopped = false;
@@ -349,7 +394,14 @@ void InputDaemon::refreshJoystick(InputDevice *joystick)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    joystick->reset();
+    if (joystick->thread() != QThread::currentThread())
+    {
+        QMetaObject::invokeMethod(joystick, "reset", Qt::BlockingQueuedConnection);
+    }
+    else
+    {
+        joystick->reset();
+    }
 
     emit joystickRefreshed(joystick);
 }
@@ -402,6 +454,12 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                 // Mapping string updated. Perform basic refresh
                 QByteArray tempbarray = mapping.toUtf8();
                 SDL_GameControllerAddMapping(tempbarray.data());
+
+                GameController *controller = qobject_cast<GameController*>(device);
+                if (controller != nullptr)
+                {
+                    controller->refreshBindTables();
+                }
             }
             else
             {
@@ -424,6 +482,7 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                     joystickID = SDL_JoystickInstanceID(sdlStick);
                     joysticks->insert(joystickID, damncontroller);
                     trackcontrollers.insert(joystickID, damncontroller);
+                    assignDeviceWorker(damncontroller);
                     emit deviceUpdated(i, damncontroller);
                 }
             }
@@ -471,6 +530,220 @@ void InputDaemon::refreshIndexes()
     }
 }
 
+/**
+ * @brief Build the key used to recognise a device when it is plugged back
+ *     in. SDL assigns a new instance ID on every connection so the GUID
+ *     is combined with the serial number when SDL can provide one.
+ * @param SDL joystick handle
+ * @param Whether the device is being used as a game controller
+ * @return Reconnect key
+ */
+QString InputDaemon::createReconnectKey(SDL_Joystick *joystick, bool gameController)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(joystick);
+    char guidString[65] = {'0'};
+    SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
+
+    QString serial = QString();
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    const char *tempSerial = SDL_JoystickGetSerial(joystick);
+    if (tempSerial != nullptr)
+    {
+        serial = QString(tempSerial);
+    }
+#endif
+
+    return QString("%1:%2:%3").arg(gameController ? "gc" : "js")
+                              .arg(QString(guidString)).arg(serial);
+}
+
+/**
+ * @brief Take an unplugged device out of the active device lists and keep
+ *     it in the reconnect cache. The device is only destroyed if it has
+ *     not reconnected before RECONNECTGRACEPERIOD expires.
+ * @param Device that was unplugged
+ */
+void InputDaemon::detachDevice(InputDevice *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (device != nullptr)
+    {
+        SDL_JoystickID deviceID = device->getSDLJoystickID();
+        SDL_Joystick *sdlStick = SDL_JoystickFromInstanceID(deviceID);
+
+        if (sdlStick != nullptr)
+        {
+            QString reconnectKey = createReconnectKey(sdlStick, device->isGameController());
+
+            joysticks->remove(deviceID);
+            getTrackjoysticksLocal().remove(deviceID);
+            trackcontrollers.remove(deviceID);
+            pendingReconnectLatency.remove(device);
+
+            device->detachSDLDevice();
+
+            reconnectCache.insert(reconnectKey, device);
+            reconnectDetachTimes.insert(device, reconnectClock.elapsed());
+
+            if (!reconnectExpireTimer.isActive())
+            {
+                reconnectExpireTimer.start();
+            }
+        }
+        else
+        {
+            removeDevice(device);
+        }
+    }
+}
+
+InputDevice* InputDaemon::takeCachedDevice(QString key)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    InputDevice *device = reconnectCache.value(key, nullptr);
+
+    if (device != nullptr)
+    {
+        reconnectCache.remove(key, device);
+        reconnectDetachTimes.remove(device);
+    }
+
+    if (reconnectCache.isEmpty())
+    {
+        reconnectExpireTimer.stop();
+    }
+
+    return device;
+}
+
+/**
+ * @brief Bind a newly opened game controller to a cached device object
+ *     with the same identity. The cached device keeps its profile, active
+ *     set and tab.
+ * @return Reattached device or nullptr if no cached device matches.
+ */
+GameController* InputDaemon::reattachCachedController(SDL_GameController *controller, int index)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    GameController *damncontroller = nullptr;
+
+    if (!reconnectCache.isEmpty())
+    {
+        QElapsedTimer bindTimer;
+        bindTimer.start();
+
+        QString reconnectKey = createReconnectKey(SDL_GameControllerGetJoystick(controller), true);
+        damncontroller = qobject_cast<GameController*>(takeCachedDevice(reconnectKey));
+
+        if (damncontroller != nullptr)
+        {
+            damncontroller->rebindSDLDevice(controller, index);
+
+            SDL_JoystickID tempJoystickID = damncontroller->getSDLJoystickID();
+            joysticks->insert(tempJoystickID, damncontroller);
+            trackcontrollers.insert(tempJoystickID, damncontroller);
+            pendingReconnectLatency.insert(damncontroller, bindTimer);
+
+            Logger::LogInfo(QString("Reattached joystick #%1 in %2 ms [%3]")
+                            .arg(damncontroller->getRealJoyNumber())
+                            .arg(bindTimer.nsecsElapsed() / 1000000.0, 0, 'f', 3)
+                            .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
+        }
+    }
+
+    return damncontroller;
+}
+
+/**
+ * @brief Joystick counterpart of reattachCachedController.
+ * @return Reattached device or nullptr if no cached device matches.
+ */
+Joystick* InputDaemon::reattachCachedJoystick(SDL_Joystick *joystick, int index)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    Joystick *curJoystick = nullptr;
+
+    if (!reconnectCache.isEmpty())
+    {
+        QElapsedTimer bindTimer;
+        bindTimer.start();
+
+        QString reconnectKey = createReconnectKey(joystick, false);
+        curJoystick = qobject_cast<Joystick*>(takeCachedDevice(reconnectKey));
+
+        if (curJoystick != nullptr)
+        {
+            curJoystick->rebindSDLDevice(joystick, index);
+
+            SDL_JoystickID tempJoystickID = curJoystick->getSDLJoystickID();
+            joysticks->insert(tempJoystickID, curJoystick);
+            getTrackjoysticksLocal().insert(tempJoystickID, curJoystick);
+            pendingReconnectLatency.insert(curJoystick, bindTimer);
+
+            Logger::LogInfo(QString("Reattached joystick #%1 in %2 ms [%3]")
+                            .arg(curJoystick->getRealJoyNumber())
+                            .arg(bindTimer.nsecsElapsed() / 1000000.0, 0, 'f', 3)
+                            .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
+        }
+    }
+
+    return curJoystick;
+}
+
+void InputDaemon::expireReconnectCache()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    qint64 currentTime = reconnectClock.elapsed();
+
+    QMutableHashIterator<QString, InputDevice*> iter(reconnectCache);
+    while (iter.hasNext())
+    {
+        iter.next();
+        InputDevice *device = iter.value();
+
+        if ((currentTime - reconnectDetachTimes.value(device, currentTime)) >= RECONNECTGRACEPERIOD)
+        {
+            iter.remove();
+            reconnectDetachTimes.remove(device);
+
+            // Tab removal will call finalRemoval on the device.
+            emit deviceRemoved(device->getSDLJoystickID());
+        }
+    }
+
+    if (reconnectCache.isEmpty())
+    {
+        reconnectExpireTimer.stop();
+    }
+}
+
+void InputDaemon::flushReconnectCache()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QListIterator<InputDevice*> iter(reconnectCache.values());
+    while (iter.hasNext())
+    {
+        InputDevice *device = iter.next();
+        releaseDeviceWorker(device);
+        delete device;
+        device = nullptr;
+    }
+
+    reconnectCache.clear();
+    reconnectDetachTimes.clear();
+    pendingReconnectLatency.clear();
+    reconnectExpireTimer.stop();
+}
+
 void InputDaemon::addInputDevice(int index)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -514,6 +787,7 @@ void InputDaemon::addInputDevice(int index)
                                     .arg(index+1)
                                     .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
 
+                    assignDeviceWorker(damncontroller);
                     emit deviceAdded(damncontroller);
                 }
                 else
@@ -527,6 +801,7 @@ void InputDaemon::addInputDevice(int index)
                                         .arg(index+1)
                                         .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
 
+                        assignDeviceWorker(joystick);
                         emit deviceAdded(joystick);
                     }
 
@@ -548,6 +823,7 @@ void InputDaemon::addInputDevice(int index)
                             .arg(index+1)
                             .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
 
+            assignDeviceWorker(joystick);
             emit deviceAdded(joystick);
         }
     }
@@ -582,15 +858,32 @@ void InputDaemon::addInputDevice(int index)
                     SDL_JoystickID tempJoystickID = SDL_JoystickInstanceID(sdlStick);
                     if (!joysticks->contains(tempJoystickID))
                     {
-                        GameController *damncontroller = new GameController(controller, index, settings, this);
-                        connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
-                        joysticks->insert(tempJoystickID, damncontroller);
-                        trackcontrollers.insert(tempJoystickID, damncontroller);
+                        // A reattached device still has its tab. Only new
+                        // devices have to be announced.
+                        GameController *damncontroller = reattachCachedController(controller, index);
+                        if (damncontroller != nullptr)
+                        {
+                            settings->endGroup();
+                            settings->getLock()->unlock();
+                        }
+                        else
+                        {
+                            damncontroller = new GameController(controller, index, settings, this);
+                            connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
+                            joysticks->insert(tempJoystickID, damncontroller);
+                            trackcontrollers.insert(tempJoystickID, damncontroller);
 
+                            settings->endGroup();
+                            settings->getLock()->unlock();
+
+                            assignDeviceWorker(damncontroller);
+                            emit deviceAdded(damncontroller);
+                        }
+                    }
+                    else
+                    {
                         settings->endGroup();
                         settings->getLock()->unlock();
-
-                        emit deviceAdded(damncontroller);
                     }
                 }
                 else
@@ -601,14 +894,24 @@ void InputDaemon::addInputDevice(int index)
             }
             else
             {
-                Joystick *curJoystick = new Joystick(joystick, index, settings, this);
-                joysticks->insert(tempJoystickID, curJoystick);
-                getTrackjoysticksLocal().insert(tempJoystickID, curJoystick);
+                Joystick *curJoystick = reattachCachedJoystick(joystick, index);
+                if (curJoystick != nullptr)
+                {
+                    settings->endGroup();
+                    settings->getLock()->unlock();
+                }
+                else
+                {
+                    curJoystick = new Joystick(joystick, index, settings, this);
+                    joysticks->insert(tempJoystickID, curJoystick);
+                    getTrackjoysticksLocal().insert(tempJoystickID, curJoystick);
 
-                settings->endGroup();
-                settings->getLock()->unlock();
+                    settings->endGroup();
+                    settings->getLock()->unlock();
 
-                emit deviceAdded(curJoystick);
+                    assignDeviceWorker(curJoystick);
+                    emit deviceAdded(curJoystick);
+                }
             }
         }
         else
@@ -629,12 +932,15 @@ Joystick *InputDaemon::openJoystickDevice(int index)
     Joystick *curJoystick = nullptr;
     if (joystick != nullptr)
     {
-        SDL_JoystickID tempJoystickID = SDL_JoystickInstanceID(joystick);
-
-        curJoystick = new Joystick(joystick, index, settings, this);
-        joysticks->insert(tempJoystickID, curJoystick);
-        getTrackjoysticksLocal().insert(tempJoystickID, curJoystick);
+        curJoystick = reattachCachedJoystick(joystick, index);
+        if (curJoystick == nullptr)
+        {
+            SDL_JoystickID tempJoystickID = SDL_JoystickInstanceID(joystick);
 
+            curJoystick = new Joystick(joystick, index, settings, this);
+            joysticks->insert(tempJoystickID, curJoystick);
+            getTrackjoysticksLocal().insert(tempJoystickID, curJoystick);
+        }
     }
 
     return curJoystick;
@@ -797,6 +1103,17 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                 break;
             }
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+            case SDL_CONTROLLERSENSORUPDATE:
+            {
+                if (trackcontrollers.contains(event.csensor.which))
+                {
+                    sdlEventQueue->append(event);
+                }
+
+                break;
+            }
+#endif
             case SDL_JOYDEVICEREMOVED:
             case SDL_JOYDEVICEADDED:
             {
@@ -982,184 +1299,484 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
         {
             case SDL_JOYBUTTONDOWN:
             case SDL_JOYBUTTONUP:
+            case SDL_JOYAXISMOTION:
+            case SDL_JOYHATMOTION:
+            case SDL_CONTROLLERAXISMOTION:
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP:
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+            case SDL_CONTROLLERSENSORUPDATE:
+#endif
             {
-
-                InputDevice *joy = getTrackjoysticksLocal().value(event.jbutton.which);
+                InputDevice *joy = eventDevice(event);
 
                 if (joy != nullptr)
                 {
-                    SetJoystick* set = joy->getActiveSetJoystick();
-                    JoyButton *button = set->getJoyButton(event.jbutton.button);
+#ifdef USE_DEVICE_WORKERS
+                    if (deviceWorkers != nullptr)
+                    {
+                        // Demultiplex only. The worker of the device
+                        // does the rest at the end of the pass.
+                        logReconnectLatency(joy);
+                        deviceWorkers->queueEvent(joy, event);
+                        break;
+                    }
+#endif
 
-                    if (button != nullptr)
+#ifdef USE_AXIS_BATCH
+                    // Keep event order for an axis that already has a
+                    // deferred value.
+                    JoyAxis *axis = eventAxis(joy, event);
+                    if ((axis != nullptr) && axis->hasPendingEvent())
                     {
-                        button->queuePendingEvent(event.type == SDL_JOYBUTTONDOWN ? true : false);
+                        activatePendingDeviceEvents(activeDevices);
+                    }
+#endif
 
-                        if (!activeDevices.contains(event.jbutton.which))
-                        {
-                            activeDevices.insert(event.jbutton.which, joy);
-                        }
+                    if (dispatchDeviceEvent(joy, event) &&
+                        !activeDevices.contains(joy->getSDLJoystickID()))
+                    {
+                        activeDevices.insert(joy->getSDLJoystickID(), joy);
                     }
                 }
-                else if (trackcontrollers.contains(event.jbutton.which))
-                {
-                    GameController *gamepad = trackcontrollers.value(event.jbutton.which);
-                    gamepad->rawButtonEvent(event.jbutton.button, event.type == SDL_JOYBUTTONDOWN ? true : false);
-                }
 
                 break;
             }
 
-            case SDL_JOYAXISMOTION:
+            case SDL_JOYDEVICEREMOVED:
             {
-
-                InputDevice *joy = getTrackjoysticksLocal().value(event.jaxis.which);
-
-                if (joy != nullptr)
+                InputDevice *device = joysticks->value(event.jdevice.which);
+                if (device != nullptr)
                 {
-                    SetJoystick* set = joy->getActiveSetJoystick();
-                    JoyAxis *axis = set->getJoyAxis(event.jaxis.axis);
-                    if (axis != nullptr)
-                    {
-                        axis->queuePendingEvent(event.jaxis.value);
+                    Logger::LogInfo(QString("Removing joystick #%1 [%2]")
+                                    .arg(device->getRealJoyNumber())
+                                    .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
 
-                        if (!activeDevices.contains(event.jaxis.which))
-                        {
-                            activeDevices.insert(event.jaxis.which, joy);
-                        }
+#ifdef USE_DEVICE_WORKERS
+                    // Events queued before the removal have to be
+                    // processed while the device is still attached.
+                    // Releasing the device waits for its worker only and
+                    // lets the detach run on this thread.
+                    if (deviceWorkers != nullptr)
+                    {
+                        deviceWorkers->processQueuedEvents();
+                        releaseDeviceWorker(device);
                     }
+#endif
 
-                    joy->rawAxisEvent(event.jaxis.which, event.jaxis.value);
-                }
-                else if (trackcontrollers.contains(event.jaxis.which))
-                {
-                    GameController *gamepad = trackcontrollers.value(event.jaxis.which);
-                    gamepad->rawAxisEvent(event.jaxis.axis, event.jaxis.value);
+                    detachDevice(device);
+                    refreshIndexes();
                 }
 
                 break;
             }
 
-            case SDL_JOYHATMOTION:
+            case SDL_JOYDEVICEADDED:
             {
-                InputDevice *joy = getTrackjoysticksLocal().value(event.jhat.which);
-
-                if (joy != nullptr)
-                {
-                    SetJoystick* set = joy->getActiveSetJoystick();
-                    JoyDPad *dpad = set->getJoyDPad(event.jhat.hat);
-                    if (dpad != nullptr)
-                    {
-                        dpad->joyEvent(event.jhat.value);
+                addInputDevice(event.jdevice.which);
+                break;
+            }
 
-                        if (!activeDevices.contains(event.jhat.which))
-                        {
-                            activeDevices.insert(event.jhat.which, joy);
-                        }
-                    }
-                }
-                else if (trackcontrollers.contains(event.jhat.which))
-                {
-                    GameController *gamepad = trackcontrollers.value(event.jaxis.which);
-                    gamepad->rawDPadEvent(event.jhat.hat, event.jhat.value);
-                }
+            case SDL_QUIT:
+            {
+                stopped = true;
+                break;
+            }
 
+            default:
                 break;
+        }
+
+#ifdef USE_DEVICE_WORKERS
+        if (deviceWorkers != nullptr)
+        {
+            continue;
+        }
+#endif
+
+#ifdef USE_AXIS_BATCH
+        // Consecutive axis events are deferred so their values go
+        // through the batch kernel together.
+        bool deferActivation = ((event.type == SDL_JOYAXISMOTION) || (event.type == SDL_CONTROLLERAXISMOTION)) &&
+                               !sdlEventQueue->isEmpty() &&
+                               ((sdlEventQueue->head().type == SDL_JOYAXISMOTION) ||
+                                (sdlEventQueue->head().type == SDL_CONTROLLERAXISMOTION));
+
+        if (!deferActivation)
+        {
+            activatePendingDeviceEvents(activeDevices);
+        }
+#else
+        activatePendingDeviceEvents(activeDevices);
+#endif
+
+        if (JoyButton::shouldInvokeMouseEvents())
+        {
+            // Do not wait for next event loop run. Execute immediately.
+            JoyButton::invokeMouseEvents();
+        }
+    }
+
+#ifdef USE_DEVICE_WORKERS
+    if (deviceWorkers != nullptr)
+    {
+        // Devices on different workers are processed in parallel and
+        // the pass does not wait for them. Mouse output they produce is
+        // picked up by the mouse event timer.
+        deviceWorkers->processQueuedEvents();
+
+        if (JoyButton::shouldInvokeMouseEvents())
+        {
+            JoyButton::invokeMouseEvents();
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Find the device an element event belongs to. Joystick events of
+ *     a game controller are passed on as raw events.
+ * @param SDL event
+ * @return Device or nullptr if the device is not tracked
+ */
+InputDevice* InputDaemon::eventDevice(const SDL_Event &event)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    InputDevice *device = nullptr;
+
+    switch (event.type)
+    {
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+        {
+            device = getTrackjoysticksLocal().value(event.jbutton.which);
+            if (device == nullptr)
+            {
+                device = trackcontrollers.value(event.jbutton.which);
             }
 
-            case SDL_CONTROLLERAXISMOTION:
+            break;
+        }
+        case SDL_JOYAXISMOTION:
+        {
+            device = getTrackjoysticksLocal().value(event.jaxis.which);
+            if (device == nullptr)
             {
-                InputDevice *joy = trackcontrollers.value(event.caxis.which);
-                if (joy != nullptr)
-                {
-                    SetJoystick* set = joy->getActiveSetJoystick();
-                    JoyAxis *axis = set->getJoyAxis(event.caxis.axis);
-                    if (axis != nullptr)
-                    {
-                        axis->queuePendingEvent(event.caxis.value);
+                device = trackcontrollers.value(event.jaxis.which);
+            }
 
-                        if (!activeDevices.contains(event.caxis.which))
-                        {
-                            activeDevices.insert(event.caxis.which, joy);
-                        }
-                    }
-                }
-                break;
+            break;
+        }
+        case SDL_JOYHATMOTION:
+        {
+            device = getTrackjoysticksLocal().value(event.jhat.which);
+            if (device == nullptr)
+            {
+                device = trackcontrollers.value(event.jhat.which);
             }
 
-            case SDL_CONTROLLERBUTTONDOWN:
-            case SDL_CONTROLLERBUTTONUP:
+            break;
+        }
+        case SDL_CONTROLLERAXISMOTION:
+        {
+            device = trackcontrollers.value(event.caxis.which);
+            break;
+        }
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        {
+            device = trackcontrollers.value(event.cbutton.which);
+            break;
+        }
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+        case SDL_CONTROLLERSENSORUPDATE:
+        {
+            device = trackcontrollers.value(event.csensor.which);
+            break;
+        }
+#endif
+    }
+
+    return device;
+}
+
+/**
+ * @brief Pass an element event on to the active set of a device. Safe to
+ *     call from the thread the device lives in.
+ * @param Device that produced the event
+ * @param SDL event
+ * @return Whether an element of the device has a pending event now
+ */
+bool InputDaemon::dispatchDeviceEvent(InputDevice *device, const SDL_Event &event)
+{
+    bool queued = false;
+    SetJoystick *set = device->getActiveSetJoystick();
+
+    switch (event.type)
+    {
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+        {
+            if (!device->isGameController())
             {
-                InputDevice *joy = trackcontrollers.value(event.cbutton.which);
-                if (joy != nullptr)
+                JoyButton *button = set->getJoyButton(event.jbutton.button);
+                if (button != nullptr)
                 {
-                    SetJoystick* set = joy->getActiveSetJoystick();
-                    JoyButton *button = set->getJoyButton(event.cbutton.button);
-
-                    if (button != nullptr)
-                    {
-                        button->queuePendingEvent(event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
+                    button->queuePendingEvent(event.type == SDL_JOYBUTTONDOWN ? true : false);
+                    queued = true;
+                }
+            }
+            else
+            {
+                GameController *gamepad = static_cast<GameController*>(device);
+                gamepad->rawButtonEvent(event.jbutton.button, event.type == SDL_JOYBUTTONDOWN ? true : false);
+            }
 
-                        if (!activeDevices.contains(event.cbutton.which))
-                        {
-                            activeDevices.insert(event.cbutton.which, joy);
-                        }
-                    }
+            break;
+        }
+        case SDL_JOYAXISMOTION:
+        {
+            if (!device->isGameController())
+            {
+                JoyAxis *axis = set->getJoyAxis(event.jaxis.axis);
+                if (axis != nullptr)
+                {
+                    axis->queuePendingEvent(event.jaxis.value);
+                    queued = true;
                 }
 
-                break;
+                device->rawAxisEvent(event.jaxis.which, event.jaxis.value);
+            }
+            else
+            {
+                GameController *gamepad = static_cast<GameController*>(device);
+                gamepad->rawAxisEvent(event.jaxis.axis, event.jaxis.value);
             }
 
-            case SDL_JOYDEVICEREMOVED:
+            break;
+        }
+        case SDL_JOYHATMOTION:
+        {
+            if (!device->isGameController())
             {
-                InputDevice *device = joysticks->value(event.jdevice.which);
-                if (device != nullptr)
+                JoyDPad *dpad = set->getJoyDPad(event.jhat.hat);
+                if (dpad != nullptr)
                 {
-                    Logger::LogInfo(QString("Removing joystick #%1 [%2]")
-                                    .arg(device->getRealJoyNumber())
-                                    .arg(QTime::currentTime().toString("hh:mm:ss.zzz")));
-
-                    removeDevice(device);
+                    dpad->joyEvent(event.jhat.value);
+                    queued = true;
                 }
-
-                break;
+            }
+            else
+            {
+                GameController *gamepad = static_cast<GameController*>(device);
+                gamepad->rawDPadEvent(event.jhat.hat, event.jhat.value);
             }
 
-            case SDL_JOYDEVICEADDED:
+            break;
+        }
+        case SDL_CONTROLLERAXISMOTION:
+        {
+            JoyAxis *axis = set->getJoyAxis(event.caxis.axis);
+            if (axis != nullptr)
             {
-                addInputDevice(event.jdevice.which);
-                break;
+                axis->queuePendingEvent(event.caxis.value);
+                queued = true;
             }
 
-            case SDL_QUIT:
+            break;
+        }
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        {
+            JoyButton *button = set->getJoyButton(event.cbutton.button);
+            if (button != nullptr)
             {
-                stopped = true;
-                break;
+                button->queuePendingEvent(event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
+                queued = true;
             }
 
-            default:
-                break;
+            break;
         }
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+        case SDL_CONTROLLERSENSORUPDATE:
+        {
+            // Motion goes straight to the mouse output so nothing is
+            // left pending for the activation pass.
+            GameController *gamepad = static_cast<GameController*>(device);
+#if SDL_VERSION_ATLEAST(2, 26, 0)
+            gamepad->rawSensorEvent(event.csensor.sensor, event.csensor.data,
+                                    event.csensor.timestamp_us, true);
+#else
+            gamepad->rawSensorEvent(event.csensor.sensor, event.csensor.data,
+                                    event.csensor.timestamp * Q_UINT64_C(1000), false);
+#endif
+            break;
+        }
+#endif
+    }
+
+    return queued;
+}
 
-        // Active possible queued events.
-        QHashIterator<SDL_JoystickID, InputDevice*> activeDevIter(activeDevices);
-        while (activeDevIter.hasNext())
+/**
+ * @brief Event function of the device workers. Runs on the worker thread
+ *     of the device.
+ * @param Device that produced the event
+ * @param SDL event
+ */
+void InputDaemon::processDeviceEvent(QObject *device, const SDL_Event &event)
+{
+    InputDevice *tempDevice = static_cast<InputDevice*>(device);
+
+    if (dispatchDeviceEvent(tempDevice, event))
+    {
+        tempDevice->activatePossiblePendingEvents();
+    }
+}
+
+#ifdef USE_AXIS_BATCH
+/**
+ * @brief Find the axis an event is meant for. Raw axis events of a game
+ *     controller do not have one.
+ */
+JoyAxis* InputDaemon::eventAxis(InputDevice *device, const SDL_Event &event)
+{
+    JoyAxis *axis = nullptr;
+
+    if ((event.type == SDL_JOYAXISMOTION) && !device->isGameController())
+    {
+        axis = device->getActiveSetJoystick()->getJoyAxis(event.jaxis.axis);
+    }
+    else if (event.type == SDL_CONTROLLERAXISMOTION)
+    {
+        axis = device->getActiveSetJoystick()->getJoyAxis(event.caxis.axis);
+    }
+
+    return axis;
+}
+#endif
+
+void InputDaemon::activatePendingDeviceEvents(QHash<SDL_JoystickID, InputDevice*> &activeDevices)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+#ifdef USE_AXIS_BATCH
+    processAxisBatch(activeDevices);
+#endif
+
+    // Active possible queued events.
+    QHashIterator<SDL_JoystickID, InputDevice*> activeDevIter(activeDevices);
+    while (activeDevIter.hasNext())
+    {
+        InputDevice *tempDevice = activeDevIter.next().value();
+
+        logReconnectLatency(tempDevice);
+
+        tempDevice->activatePossibleControlStickEvents();
+        tempDevice->activatePossibleAxisEvents();
+        tempDevice->activatePossibleDPadEvents();
+        tempDevice->activatePossibleVDPadEvents();
+        tempDevice->activatePossibleButtonEvents();
+    }
+}
+
+void InputDaemon::logReconnectLatency(InputDevice *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (!pendingReconnectLatency.isEmpty() && pendingReconnectLatency.contains(device))
+    {
+        Logger::LogInfo(QString("Joystick #%1 produced its first event %2 ms after reconnecting")
+                        .arg(device->getRealJoyNumber())
+                        .arg(pendingReconnectLatency.take(device).nsecsElapsed() / 1000000.0, 0, 'f', 3));
+    }
+}
+
+/**
+ * @brief Hand a new device to the worker pool when devices are processed
+ *     on worker threads.
+ * @param New device
+ */
+void InputDaemon::assignDeviceWorker(InputDevice *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+#ifdef USE_DEVICE_WORKERS
+    if (deviceWorkers != nullptr)
+    {
+        deviceWorkers->assignDevice(device);
+    }
+#else
+    Q_UNUSED(device);
+#endif
+}
+
+/**
+ * @brief Bring a device back from its worker before it is deleted or
+ *     detached.
+ * @param Device about to be deleted or detached
+ */
+void InputDaemon::releaseDeviceWorker(InputDevice *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+#ifdef USE_DEVICE_WORKERS
+    if ((deviceWorkers != nullptr) && deviceWorkers->hasDevice(device))
+    {
+        deviceWorkers->releaseDevice(device);
+        device->setParent(this);
+    }
+#else
+    Q_UNUSED(device);
+#endif
+}
+
+#ifdef USE_AXIS_BATCH
+/**
+ * @brief Gather the pending values of all axes on active devices and
+ *     compute throttle, dead zone and distance for them in one kernel
+ *     call. Axes that are part of a control stick are not deferred and
+ *     never have a pending value.
+ */
+void InputDaemon::processAxisBatch(QHash<SDL_JoystickID, InputDevice*> &activeDevices)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    axisBatch.clear();
+    axisBatchAxes.clear();
+
+    QHashIterator<SDL_JoystickID, InputDevice*> activeDevIter(activeDevices);
+    while (activeDevIter.hasNext())
+    {
+        SetJoystick *currentSet = activeDevIter.next().value()->getActiveSetJoystick();
+        for (int i = 0; i < currentSet->getNumberAxes(); i++)
         {
-            InputDevice *tempDevice = activeDevIter.next().value();
-            tempDevice->activatePossibleControlStickEvents();
-            tempDevice->activatePossibleAxisEvents();
-            tempDevice->activatePossibleDPadEvents();
-            tempDevice->activatePossibleVDPadEvents();
-            tempDevice->activatePossibleButtonEvents();
+            JoyAxis *axis = currentSet->getJoyAxis(i);
+            if ((axis != nullptr) && axis->hasPendingEvent())
+            {
+                axisBatch.append(axis->getPendingValue(), axis->getThrottle(),
+                                 axis->getDeadZone(), axis->getMaxZoneValue(),
+                                 axis->getAxisMinCal(), axis->getAxisMaxCal());
+                axisBatchAxes.append(axis);
+            }
         }
+    }
 
-        if (JoyButton::shouldInvokeMouseEvents())
+    if (axisBatch.size() > 0)
+    {
+        AxisBatchKernel::process(axisBatch);
+
+        for (int i = 0; i < axisBatchAxes.size(); i++)
         {
-            // Do not wait for next event loop run. Execute immediately.
-            JoyButton::invokeMouseEvents();
+            axisBatchAxes.at(i)->setPendingBatchResult(axisBatch.clampedValues.at(i),
+                                                       axisBatch.throttledValues.at(i),
+                                                       axisBatch.deadZoneFlags.at(i) != 0,
+                                                       axisBatch.distances.at(i));
         }
     }
 }
+#endif
 
 void InputDaemon::clearBitArrayStatusInstances()
 {
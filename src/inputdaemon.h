@@ -19,12 +19,20 @@
 #define INPUTDAEMONTHREAD_H
 
 #include "gamecontroller/gamecontroller.h"
+
+#ifdef USE_AXIS_BATCH
+  #include "axisbatchkernel.h"
+#endif
+
 #include <SDL2/SDL_joystick.h>
 #include <SDL2/SDL_events.h>
 
 #include <QHash>
+#include <QMultiHash>
 #include <QMap>
 #include <QQueue>
+#include <QTimer>
+#include <QElapsedTimer>
 
 class InputDevice;
 class AntiMicroSettings;
@@ -33,6 +41,8 @@ class Joystick;
 class GameController;
 class SDLEventReader;
 class QThread;
+class JoyAxis;
+class DeviceWorkerPool;
 
 class InputDaemon : public QObject
 {
@@ -56,8 +66,30 @@ protected:
     Joystick* openJoystickDevice(int index);
 
     void clearBitArrayStatusInstances();
+    void activatePendingDeviceEvents(QHash<SDL_JoystickID, InputDevice*> &activeDevices);
+    void logReconnectLatency(InputDevice *device);
+    InputDevice* eventDevice(const SDL_Event &event);
+
+    static bool dispatchDeviceEvent(InputDevice *device, const SDL_Event &event);
+    static void processDeviceEvent(QObject *device, const SDL_Event &event);
+
+#ifdef USE_AXIS_BATCH
+    void processAxisBatch(QHash<SDL_JoystickID, InputDevice*> &activeDevices);
+    static JoyAxis* eventAxis(InputDevice *device, const SDL_Event &event);
+#endif
+
+    void assignDeviceWorker(InputDevice *device);
+    void releaseDeviceWorker(InputDevice *device);
+
+    QString createReconnectKey(SDL_Joystick *joystick, bool gameController);
+    void detachDevice(InputDevice *device);
+    InputDevice* takeCachedDevice(QString key);
+    GameController* reattachCachedController(SDL_GameController *controller, int index);
+    Joystick* reattachCachedJoystick(SDL_Joystick *joystick, int index);
+    void flushReconnectCache();
 
     static const int GAMECONTROLLERTRIGGERRELEASE;
+    static const int RECONNECTGRACEPERIOD;
 
 signals:
     void joystickRefreshed (InputDevice *joystick);
@@ -87,6 +119,7 @@ private slots:
     void stop();
     void resetActiveButtonMouseDistances();
     void updatePollResetRate(int tempPollRate); //.., unsigned
+    void expireReconnectCache();
 
 private:
     QHash<SDL_JoystickID, Joystick*>& getTrackjoysticksLocal();
@@ -100,6 +133,26 @@ private:
     QHash<InputDevice*, InputDeviceBitArrayStatus*> releaseEventsGenerated;
     QHash<InputDevice*, InputDeviceBitArrayStatus*> pendingEventValues;
 
+    // Unplugged devices kept with their loaded profile until they
+    // reconnect or the grace period runs out. Keyed by GUID and serial.
+    QMultiHash<QString, InputDevice*> reconnectCache;
+    QHash<InputDevice*, qint64> reconnectDetachTimes;
+    QHash<InputDevice*, QElapsedTimer> pendingReconnectLatency;
+    QElapsedTimer reconnectClock;
+    QTimer reconnectExpireTimer;
+
+#ifdef USE_AXIS_BATCH
+    // Buffers reused by every polling pass.
+    AxisBatchKernel::AxisBatch axisBatch;
+    QList<JoyAxis*> axisBatchAxes;
+#endif
+
+#ifdef USE_DEVICE_WORKERS
+    // Runs per device processing on worker threads. Only created for
+    // graphical sessions.
+    DeviceWorkerPool *deviceWorkers;
+#endif
+
     bool stopped;
     bool graphical;
 
@@ -2446,6 +2446,26 @@ void InputDevice::haltServices()
     emit requestWait();
 }
 
+/**
+ * @brief Release the SDL handle of a device that was unplugged while
+ *     keeping the object and its loaded profile around so it can be
+ *     bound to the device again if it reconnects.
+ */
+void InputDevice::detachSDLDevice()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    // The device object outlives the unplug, so nothing it holds may stay
+    // pressed or keep the cursor moving while it waits for a reconnect.
+    for (int i = 0; i < NUMBER_JOYSETS; i++)
+    {
+        getJoystick_sets().value(i)->detachReset();
+    }
+
+    resetButtonDownCount();
+    closeSDLDevice();
+}
+
 void InputDevice::finalRemoval()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
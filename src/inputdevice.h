@@ -66,6 +66,7 @@ public:
     virtual QString getStringIdentifier();
     virtual QString getXmlName() = 0;
     virtual void closeSDLDevice() = 0;
+    virtual void detachSDLDevice();
     virtual SDL_JoystickID getSDLJoystickID() = 0;
     QString getSDLPlatform();
     virtual bool isGameController();
@@ -166,7 +167,7 @@ signals:
 
 public slots:
     void reset();
-    void transferReset();
+    virtual void transferReset();
     void reInitButtons();
     void resetButtonDownCount();
     void setActiveSetNumber(int index);
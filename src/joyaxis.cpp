@@ -79,6 +79,7 @@ void JoyAxis::queuePendingEvent(int value, bool ignoresets, bool updateLastValue
     pendingEvent = false;
     pendingValue = 0;
     pendingIgnoreSets = false;
+    pendingBatchResult = false;
 
     if (this->stick != nullptr)
     {
@@ -103,6 +104,7 @@ void JoyAxis::activatePendingEvent()
         pendingEvent = false;
         pendingValue = false;
         pendingIgnoreSets = false;
+        pendingBatchResult = false;
     }
 }
 
@@ -120,6 +122,38 @@ void JoyAxis::clearPendingEvent()
     pendingEvent = false;
     pendingValue = false;
     pendingIgnoreSets = false;
+    pendingBatchResult = false;
+}
+
+int JoyAxis::getPendingValue()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return pendingValue;
+}
+
+/**
+ * @brief Store values for the pending event that were computed in a batch
+ *     together with other axes. They are used by the next activation of
+ *     the pending event instead of computing them again.
+ * @param Raw value limited to the calibrated range
+ * @param Throttled value
+ * @param Whether the raw value is inside the dead zone
+ * @param Distance from the dead zone for the throttled value
+ */
+void JoyAxis::setPendingBatchResult(int clampedValue, int throttledValue,
+                                    bool inDeadZone, double distance)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (pendingEvent)
+    {
+        pendingBatchResult = true;
+        batchClampedValue = clampedValue;
+        batchThrottledValue = throttledValue;
+        batchInDeadZone = inDeadZone;
+        batchDistance = distance;
+    }
 }
 
 void JoyAxis::stickPassEvent(int value, bool ignoresets, bool updateLastValues)
@@ -179,10 +213,26 @@ void JoyAxis::joyEvent(int value, bool ignoresets, bool updateLastValues)
             lastKnownRawValue = currentRawValue;
         }
 
-        setCurrentRawValue(value);
+        bool safezone = false;
 
-        bool safezone = !inDeadZone(currentRawValue);
-        currentThrottledValue = calculateThrottledValue(value);
+        if (pendingEvent && pendingBatchResult)
+        {
+            currentRawValue = batchClampedValue;
+            safezone = !batchInDeadZone;
+            currentThrottledValue = batchThrottledValue;
+
+            cachedDistanceValid = true;
+            cachedDistanceThrottledValue = batchThrottledValue;
+            cachedDistance = batchDistance;
+            pendingBatchResult = false;
+        }
+        else
+        {
+            setCurrentRawValue(value);
+
+            safezone = !inDeadZone(currentRawValue);
+            currentThrottledValue = calculateThrottledValue(value);
+        }
 
         // If in joystick mode and this is the first detected event,
         // use the current value as the axis center point. If the value
@@ -424,11 +474,23 @@ void JoyAxis::createDeskEvent(bool ignoresets)
     }
 }
 
+/**
+ * @brief Buttons keep the mouse distance of the last sample. Make them
+ *     pick up a zone change while the axis is held still.
+ */
+void JoyAxis::invalidateButtonMouseDistances()
+{
+    paxisbutton->invalidateMouseDistance();
+    naxisbutton->invalidateMouseDistance();
+}
+
 void JoyAxis::setDeadZone(int value)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     deadZone = abs(value);
+    cachedDistanceValid = false;
+    invalidateButtonMouseDistances();
     emit propertyUpdated();
 }
 
@@ -444,6 +506,9 @@ void JoyAxis::setMaxZoneValue(int value)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     value = abs(value);
+    cachedDistanceValid = false;
+    invalidateButtonMouseDistances();
+
     if (value >=getAxisMaxCal())
     {
         maxZoneValue = getAxisMaxCal();
@@ -485,6 +550,7 @@ void JoyAxis::setThrottle(int value)
 
             throttle = value;
             adjustRange();
+            invalidateButtonMouseDistances();
             emit throttleChanged();
             emit propertyUpdated();
         }
@@ -506,6 +572,7 @@ void JoyAxis::setInitialThrottle(int value)
         {
             throttle = value;
             adjustRange();
+            invalidateButtonMouseDistances();
             emit throttleChanged();
         }
     }
@@ -765,6 +832,11 @@ void JoyAxis::reset()
     pendingEvent = false;
     pendingValue = currentRawValue;
     pendingIgnoreSets = false;
+    pendingBatchResult = false;
+
+    cachedDistanceValid = false;
+    cachedDistanceThrottledValue = 0;
+    cachedDistance = 0.0;
 }
 
 void JoyAxis::reset(int index)
@@ -829,7 +901,18 @@ double JoyAxis::getDistanceFromDeadZone()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    return getDistanceFromDeadZone(currentThrottledValue);
+    double distance = 0.0;
+
+    if (cachedDistanceValid && (cachedDistanceThrottledValue == currentThrottledValue))
+    {
+        distance = cachedDistance;
+    }
+    else
+    {
+        distance = getDistanceFromDeadZone(currentThrottledValue);
+    }
+
+    return distance;
 }
 
 double JoyAxis::getDistanceFromDeadZone(int value)
@@ -841,11 +924,11 @@ double JoyAxis::getDistanceFromDeadZone(int value)
 
     if (currentValue >= deadZone)
     {
-        distance = static_cast<double>((currentValue - deadZone)/(maxZoneValue - deadZone));
+        distance = static_cast<double>(currentValue - deadZone) / (maxZoneValue - deadZone);
     }
     else if (currentValue <= -deadZone)
     {
-        distance = static_cast<double>((currentValue + deadZone)/( (-maxZoneValue) + deadZone));
+        distance = static_cast<double>(currentValue + deadZone) / ((-maxZoneValue) + deadZone);
     }
 
     distance = qBound(0.0, distance, 1.0);
@@ -1349,6 +1432,7 @@ void JoyAxis::copyAssignments(JoyAxis *destAxis)
     destAxis->reset();
     destAxis->deadZone = deadZone;
     destAxis->maxZoneValue = maxZoneValue;
+    destAxis->cachedDistanceValid = false;
     destAxis->axisName = axisName;
     paxisbutton->copyAssignments(destAxis->paxisbutton);
     naxisbutton->copyAssignments(destAxis->naxisbutton);
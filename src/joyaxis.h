@@ -54,6 +54,9 @@ public:
     void activatePendingEvent();
     bool hasPendingEvent();
     void clearPendingEvent();
+    int getPendingValue();
+    void setPendingBatchResult(int clampedValue, int throttledValue,
+                               bool inDeadZone, double distance);
     bool inDeadZone(int value);
 
     virtual QString getName(bool forceFullFormat=false, bool displayNames=false);
@@ -173,6 +176,7 @@ protected:
 
     void performCalibration(int value);
     void stickPassEvent(int value, bool ignoresets=false, bool updateLastValues=true);
+    void invalidateButtonMouseDistances();
 
     virtual bool readMainConfig(QXmlStreamReader *xml);
     virtual bool readButtonConfig(QXmlStreamReader *xml);
@@ -237,6 +241,18 @@ private:
     bool pendingEvent;
     bool pendingIgnoreSets;
 
+    // Values for the pending event precomputed by the axis batch kernel.
+    bool pendingBatchResult;
+    int batchClampedValue;
+    int batchThrottledValue;
+    bool batchInDeadZone;
+    double batchDistance;
+
+    // Distance for the throttled value it was computed for.
+    bool cachedDistanceValid;
+    int cachedDistanceThrottledValue;
+    double cachedDistance;
+
 };
 
 #endif // JOYAXIS_H
@@ -18,11 +18,14 @@
 #include "joybutton.h"
 
 #include "messagehandler.h"
+#include "common.h"
 #include "setjoystick.h"
 #include "inputdevice.h"
 #include "vdpad.h"
 #include "event.h"
+#include "eventhandlers/baseeventhandler.h"
 #include "logger.h"
+#include "textentrystreamer.h"
 #include "SDL2/SDL_events.h"
 
 #ifdef Q_OS_WIN
@@ -38,6 +41,8 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QSharedPointer>
+#include <QMetaMethod>
+#include <QMutexLocker>
 
 const QString JoyButton::xmlName = "button";
 
@@ -89,8 +94,10 @@ JoyButton::DEFAULTEXTRAACCELCURVE = JoyButton::LinearAccelCurve;
 const int JoyButton::DEFAULTSPRINGRELEASERADIUS = 0;
 
 // Keep references to active keys and mouse buttons.
-QHash<int, int> JoyButton::activeKeys;
-QHash<int, int> JoyButton::activeMouseButtons;
+// Key codes are sized from the event backend at startup. Mouse button
+// codes are small on every backend.
+PressedKeyState JoyButton::activeKeys;
+PressedKeyState JoyButton::activeMouseButtons(32);
 JoyButtonSlot* JoyButton::lastActiveKey = nullptr;
 
 // Keep track of active Mouse Speed Mod slots.
@@ -112,15 +119,24 @@ QTime JoyButton::testOldMouseTime;
 JoyButtonMouseHelper JoyButton::mouseHelper;
 
 QTimer JoyButton::staticMouseEventTimer;
+MouseTickPacer JoyButton::mouseTickPacer;
 QList<JoyButton*> JoyButton::pendingMouseButtons;
 
+// Buttons with active wheel slots that scroll smoothly from the shared
+// mouse event timer.
+QList<JoyButton*> JoyButton::pendingWheelButtons;
+bool JoyButton::highResolutionWheel = false;
+double JoyButton::wheelUnitsVertical = 0.0;
+double JoyButton::wheelUnitsHorizontal = 0.0;
+QElapsedTimer JoyButton::highResolutionWheelTime;
+
 // History buffers used for mouse smoothing routine.
 QList<double> JoyButton::mouseHistoryX;
 QList<double> JoyButton::mouseHistoryY;
 
 // Carry over remainder of a cursor move for the next mouse event.
-double JoyButton::cursorRemainderX = 0.0;
-double JoyButton::cursorRemainderY = 0.0;
+SubPixelAccumulator JoyButton::cursorAccumulatorX;
+SubPixelAccumulator JoyButton::cursorAccumulatorY;
 
 double JoyButton::weightModifier = 0;
 int JoyButton::mouseHistorySize = 1;
@@ -185,6 +201,17 @@ JoyButton::JoyButton(int index, int originset, SetJoystick *parentSet,
     // Will only matter on the first call
     establishMouseTimerConnections();
 
+    activeZoneStringDirty = false;
+    slotsSummaryValid = false;
+    slotFeatureFlags.store(ProfileFeatures::NoFeatures);
+    slotsStringValid = false;
+    nameCacheValidMask = 0;
+
+    mouseDistanceSerial = -1;
+    sampledMouseDistance = 0.0;
+    curvedMouseDistance = 0.0;
+    curvedMouseDistanceValid = false;
+
     // Make sure to call before calling reset
     this->resetProperties();
 
@@ -282,6 +309,8 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    invalidateMouseDistance();
+
     if ((this->vdpad != nullptr) && !pendingEvent)
     {
         vdpadPassEvent(pressed, ignoresets);
@@ -409,7 +438,7 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
                         lastDistance = getMouseDistanceFromDeadZone();
                     }
 
-                    activeZoneTimer.start();
+                    scheduleActiveZoneSummaryUpdate();
                 }
             }
             // Toogle is enabled and a controller button change has occurred.
@@ -488,10 +517,18 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
         }
         else if (!useTurbo && isButtonPressed)
         {
-            resetAccelerationDistances();
-            currentAccelerationDistance = getAccelerationDistance();
+            int flags = getFeatureFlags();
+
+            // Held buttons without mouse or distance slots have nothing
+            // to update between events.
+            if ((flags & ProfileFeatures::MouseMovementFeatures) != 0)
+            {
+                resetAccelerationDistances();
+                currentAccelerationDistance = getAccelerationDistance();
+                wakeMouseEventTimer();
+            }
 
-            if (!setChangeTimer.isActive())
+            if (((flags & ProfileFeatures::DistanceFeature) != 0) && !setChangeTimer.isActive())
             {
                 bool releasedCalled = distanceEvent();
                 if (releasedCalled)
@@ -544,6 +581,7 @@ void JoyButton::setJoyNumber(int index)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     this->index = index;
+    invalidateNameCache();
 }
 
 void JoyButton::setToggle(bool toggle)
@@ -591,6 +629,7 @@ void JoyButton::reset()
     holdTimer.stop();
     mouseWheelVerticalEventTimer.stop();
     mouseWheelHorizontalEventTimer.stop();
+    removePendingWheelButton();
     setChangeTimer.stop();
     keyPressTimer.stop();
     delayTimer.stop();
@@ -603,8 +642,8 @@ void JoyButton::reset()
 
     if (slotiter != nullptr)
     {
-        delete slotiter;
         slotiter = nullptr;
+        sequenceIterator.clear();
     }
 
     releaseActiveSlots();
@@ -625,6 +664,7 @@ void JoyButton::reset(int index)
 
     JoyButton::reset();
     this->index = index;
+    invalidateNameCache();
 }
 
 bool JoyButton::getToggleState()
@@ -697,7 +737,7 @@ bool JoyButton::distanceEvent()
 
     bool released = false;
 
-    if (slotiter != nullptr)
+    if ((slotiter != nullptr) && ((getFeatureFlags() & ProfileFeatures::DistanceFeature) != 0))
     {
         QReadLocker tempLocker(&assignmentsLock);
 
@@ -819,8 +859,9 @@ void JoyButton::createDeskEvent()
     if (slotiter == nullptr)
     {
         assignmentsLock.lockForRead();
-        slotiter = new QListIterator<JoyButtonSlot*>(*getAssignedSlots());
+        sequenceIterator = JoyButtonSlotIterator(slotRecords);
         assignmentsLock.unlock();
+        slotiter = &sequenceIterator;
 
         distanceEvent();
     }
@@ -855,6 +896,7 @@ void JoyButton::activateSlots()
 
     if (slotiter != nullptr)
     {
+        PadderCommon::OutputStageLocker outputLocker;
         QWriteLocker tempLocker(&activeZoneLock);
 
         bool exit = false;
@@ -866,9 +908,11 @@ void JoyButton::activateSlots()
         int i = 0;
         while (slotiter->hasNext() && !exit)
         {
-            JoyButtonSlot *slot = slotiter->next();
-            int tempcode = slot->getSlotCode();
-            JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
+            // Copy the record since the sequence may be reset below.
+            JoyButtonSlotIterator::Record record = slotiter->nextRecord();
+            JoyButtonSlot *slot = record.slot;
+            int tempcode = record.code;
+            JoyButtonSlot::JoySlotInputAction mode = static_cast<JoyButtonSlot::JoySlotInputAction>(record.mode);
 
             if (mode == JoyButtonSlot::JoyKeyboard)
             {
@@ -879,10 +923,9 @@ void JoyButton::activateSlots()
                 #endif
 
                 sendevent(slot, true);
-                getActiveSlotsLocal().append(slot);
-                int oldvalue = activeKeys.value(tempcode, 0) + 1;
-                activeKeys.insert(tempcode, oldvalue);
-                if (!slot->isModifierKey())
+                appendActiveSlot(record);
+                activeKeys.press(tempcode);
+                if (!(record.flags & JoyButtonSlotIterator::ModifierKeyFlag))
                 {
                     #ifndef QT_DEBUG_NO_OUTPUT
                     qDebug() << "There has been assigned a lastActiveKey";
@@ -914,13 +957,20 @@ void JoyButton::activateSlots()
                 qDebug() << i << ": It's a JoyMouseButton with code: " << tempcode << " and name: " << slot->getSlotString();
                 #endif
 
-                if ((tempcode == static_cast<int>(JoyButtonSlot::MouseWheelUp)) ||
-                    (tempcode == static_cast<int>(JoyButtonSlot::MouseWheelDown)))
+                if (((tempcode >= static_cast<int>(JoyButtonSlot::MouseWheelUp)) &&
+                     (tempcode <= static_cast<int>(JoyButtonSlot::MouseWheelRight))) &&
+                    isHighResolutionWheelActive())
+                {
+                    appendActiveSlot(record);
+                    startHighResolutionWheel(tempcode);
+                }
+                else if ((tempcode == static_cast<int>(JoyButtonSlot::MouseWheelUp)) ||
+                         (tempcode == static_cast<int>(JoyButtonSlot::MouseWheelDown)))
                 {
                     slot->getMouseInterval()->restart();
                     wheelVerticalTime.restart();
                     currentWheelVerticalEvent = slot;
-                    getActiveSlotsLocal().append(slot);
+                    appendActiveSlot(record);
                     wheelEventVertical();
                     currentWheelVerticalEvent = nullptr;
                 }
@@ -930,16 +980,15 @@ void JoyButton::activateSlots()
                     slot->getMouseInterval()->restart();
                     wheelHorizontalTime.restart();
                     currentWheelHorizontalEvent = slot;
-                    getActiveSlotsLocal().append(slot);
+                    appendActiveSlot(record);
                     wheelEventHorizontal();
                     currentWheelHorizontalEvent = nullptr;
                 }
                 else
                 {
                     sendevent(slot, true);
-                    getActiveSlotsLocal().append(slot);
-                    int oldvalue = activeMouseButtons.value(tempcode, 0) + 1;
-                    activeMouseButtons.insert(tempcode, oldvalue);
+                    appendActiveSlot(record);
+                    activeMouseButtons.press(tempcode);
                 }
             }
             else if (mode == JoyButtonSlot::JoyMouseMovement)
@@ -952,7 +1001,7 @@ void JoyButton::activateSlots()
 
                 slot->getMouseInterval()->restart();
 
-                getActiveSlotsLocal().append(slot);
+                appendActiveSlot(record);
 
                 if (pendingMouseButtons.size() == 0)
                 {
@@ -969,10 +1018,17 @@ void JoyButton::activateSlots()
                     if (!staticMouseEventTimer.isActive() || (staticMouseEventTimer.interval() == IDLEMOUSEREFRESHRATE))
                     {
                         int tempRate = qBound(0, mouseRefreshRate - gamepadRefreshRate, MAXIMUMMOUSEREFRESHRATE);
-                        staticMouseEventTimer.start(tempRate);
+                        mouseTickPacer.wake();
+                        startStaticMouseEventTimer(tempRate);
                         testOldMouseTime.restart();
                         accelExtraDurationTime.restart();
                     }
+                    else if (staticMouseEventTimer.interval() > mouseRefreshRate)
+                    {
+                        // Timer backed off while other elements were steady.
+                        mouseTickPacer.wake();
+                        startStaticMouseEventTimer(mouseRefreshRate);
+                    }
                 }
             }
             else if (mode == JoyButtonSlot::JoyPause)
@@ -1106,7 +1162,7 @@ void JoyButton::activateSlots()
 
                 mouseSpeedModifier = tempcode * 0.01;
                 mouseSpeedModList.append(slot);
-                getActiveSlotsLocal().append(slot);
+                appendActiveSlot(record);
             }
             else if (mode == JoyButtonSlot::JoyKeyPress)
             {
@@ -1170,7 +1226,7 @@ void JoyButton::activateSlots()
                 qDebug() << i << ": It's a JoySetChange with code: " << tempcode << " and name: " << slot->getSlotString();
                 #endif
 
-                getActiveSlotsLocal().append(slot);
+                appendActiveSlot(record);
             }
             else if (mode == JoyButtonSlot::JoyTextEntry)
             {
@@ -1181,6 +1237,17 @@ void JoyButton::activateSlots()
                 #endif
 
                 sendevent(slot, true);
+
+                // Text is streamed in the background. Hold the rest of the
+                // sequence back like a pause until the text has been typed.
+                if (slotiter->hasNext() && TextEntryStreamer::getInstance()->isStreaming())
+                {
+                    currentPause = slot;
+                    pauseHold.restart();
+                    inpauseHold.restart();
+                    pauseWaitTimer.start(0);
+                    exit = true;
+                }
             }
             else if (mode == JoyButtonSlot::JoyExecute)
             {
@@ -1226,7 +1293,7 @@ void JoyButton::activateSlots()
         }
 #endif
 
-        activeZoneTimer.start();
+        scheduleActiveZoneSummaryUpdate();
     }
 }
 
@@ -1294,398 +1361,265 @@ void JoyButton::mouseEvent()
             int mousedirection = buttonslot->getSlotCode();
             JoyButton::JoyMouseMovementMode mousemode = getMouseMode();
 
-            bool isActive = getActiveSlots().contains(buttonslot);
-            if (isActive)
+            // Queued slots are always active. releaseActiveSlots clears
+            // the queue together with the active slots.
+            int mousespeed = 0;
+
+            if (mousemode == JoyButton::MouseCursor)
             {
-                int mousespeed = 0;
+                if (mousedirection == static_cast<int>(JoyButtonSlot::MouseRight))
+                {
+                    mousespeed = mouseSpeedX;
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseLeft))
+                {
+                    mousespeed = mouseSpeedX;
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseDown))
+                {
+                    mousespeed = mouseSpeedY;
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseUp))
+                {
+                    mousespeed = mouseSpeedY;
+                }
+
+                double difference = getCurvedMouseDistance(buttonslot);
+
+                double mouse1 = 0;
+                double mouse2 = 0;
+                double sumDist = buttonslot->getMouseDistance();
 
-                if (mousemode == JoyButton::MouseCursor)
+                double distance = 0;
+                difference = (mouseSpeedModifier == 1.0) ? difference : (difference * mouseSpeedModifier);
+
+                double mintravel = minMouseDistanceAccelThreshold * 0.01;
+                double minstop = qMax(0.05, mintravel);
+                //double currentTravel = getAccelerationDistance() - lastAccelerationDistance;
+
+                // Last check ensures that acceleration is only applied for the same direction.
+                if (extraAccelerationEnabled && isPartRealAxis() &&
+                    (fabs(getAccelerationDistance() - lastAccelerationDistance) >= mintravel) &&
+                    (((getAccelerationDistance() - lastAccelerationDistance) >= 0) == (getAccelerationDistance() >= 0)))
                 {
-                    if (mousedirection == static_cast<int>(JoyButtonSlot::MouseRight))
+                    double magfactor = extraAccelerationMultiplier;
+                    double minfactor = qMax((DEFAULTSTARTACCELMULTIPLIER * 0.001) + 1.0, magfactor * (startAccelMultiplier * 0.01));
+                    double maxtravel = maxMouseDistanceAccelThreshold * 0.01;
+                    double slope = (magfactor - minfactor)/(maxtravel - mintravel);
+                    double intercept = minfactor - (slope * mintravel);
+
+                    double intermediateTravel = qMin(maxtravel, fabs(getAccelerationDistance() - lastAccelerationDistance));
+                    if ((currentAccelMulti > 1.0) && (oldAccelMulti == 0.0))
                     {
-                        mousespeed = mouseSpeedX;
+                        intermediateTravel = qMin(maxtravel, intermediateTravel + mintravel);
                     }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseLeft))
+
+                    double currentAccelMultiTemp = (slope * intermediateTravel + intercept);
+                    if (extraAccelCurve == EaseOutSineCurve)
                     {
-                        mousespeed = mouseSpeedX;
+                        double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
+                        currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * sin(getMultiDiff2 * (PI/2.0)) + minfactor;
                     }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseDown))
+                    else if (extraAccelCurve == EaseOutQuadAccelCurve)
                     {
-                        mousespeed = mouseSpeedY;
+                        double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
+                        currentAccelMultiTemp = -(extraAccelerationMultiplier - minfactor) * (getMultiDiff2 * (getMultiDiff2 - 2)) + minfactor;
                     }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseUp))
+                    else if (extraAccelCurve == EaseOutCubicAccelCurve)
                     {
-                        mousespeed = mouseSpeedY;
+                        double getMultiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor)) - 1;
+                        currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * ((getMultiDiff) * (getMultiDiff) * (getMultiDiff) + 1) + minfactor;
                     }
 
-                    double difference = getMouseDistanceFromDeadZone();
+                    difference = difference * currentAccelMultiTemp;
+                    currentAccelMulti = currentAccelMultiTemp;
+                    updateOldAccelMulti = currentAccelMulti;
+                    accelTravel = intermediateTravel;
+                    accelExtraDurationTime.restart();
+                }
+                else if (extraAccelerationEnabled && isPartRealAxis() && (accelDuration > 0.0) &&
+                         (currentAccelMulti > 0.0) &&
+                         (fabs(getAccelerationDistance() - startingAccelerationDistance) < minstop))
+                {
+                    #ifndef QT_DEBUG_NO_OUTPUT
+                    qDebug() << "Keep Trying: " << fabs(getAccelerationDistance() - lastAccelerationDistance);
+                    qDebug() << "MIN TRAVEL: " << mintravel;
+                    #endif
 
-                    double mouse1 = 0;
-                    double mouse2 = 0;
-                    double sumDist = buttonslot->getMouseDistance();
-                    JoyMouseCurve currentCurve = getMouseCurve();
+                    updateStartingMouseDistance = true;
+                    double magfactor = extraAccelerationMultiplier;
+                    double minfactor = qMax((DEFAULTSTARTACCELMULTIPLIER * 0.001) + 1.0, magfactor * (startAccelMultiplier * 0.01));
+                    double maxtravel = maxMouseDistanceAccelThreshold * 0.01;
+                    double slope = (magfactor - minfactor)/(maxtravel - mintravel);
+                    double intercept = minfactor - (slope * mintravel);
 
-                    switch (currentCurve)
-                    {
-                        case LinearCurve:
-                        {
-                            break;
-                        }
-                        case QuadraticCurve:
-                        {
-                            difference = difference * difference;
-                            break;
-                        }
-                        case CubicCurve:
-                        {
-                            difference = difference * difference * difference;
-                            break;
-                        }
-                        case QuadraticExtremeCurve:
-                        {
-                            double temp = difference;
-                            difference = difference * difference;
-                            difference = (temp >= 0.95) ? (difference * 1.5) : difference;
-                            break;
-                        }
-                        case PowerCurve:
-                        {
-                            double tempsensitive = qMin(qMax(sensitivity, 1.0e-3), 1.0e+3);
-                            double temp = qMin(qMax(pow(difference, 1.0 / tempsensitive), 0.0), 1.0);
-                            difference = temp;
-                            break;
-                        }
-                        case EnhancedPrecisionCurve:
-                        {
-                            // Perform different forms of acceleration depending on
-                            // the range of the element from its assigned dead zone.
-                            // Useful for more precise controls with an axis.
-                            double temp = difference;
-                            if (temp <= 0.4)
-                            {
-                                // Low slope value for really slow acceleration
-                                difference = (difference * 0.37);
-                            }
-                            else if (temp <= 0.75)
-                            {
-                                // Perform Linear accleration with an appropriate
-                                // offset.
-                                difference = (difference - 0.252);
-                            }
-                            else if (temp > 0.75)
-                            {
-                                // Perform mouse acceleration. Make up the difference
-                                // due to the previous two segments. Maxes out at 1.0.
-                                difference = (difference * 2.008) - 1.008;
-                            }
+                    int elapsedElapsed = accelExtraDurationTime.elapsed();
 
-                            break;
-                        }
-                        case EasingQuadraticCurve:
-                        case EasingCubicCurve:
-                        {
-                            // Perform different forms of acceleration depending on
-                            // the range of the element from its assigned dead zone.
-                            // Useful for more precise controls with an axis.
-                            double temp = difference;
-                            if (temp <= 0.4)
-                            {
-                                // Low slope value for really slow acceleration
-                                difference = (difference * 0.38);
-
-                                // Out of high end. Reset easing status.
-                                if (buttonslot->isEasingActive())
-                                {
-                                    buttonslot->setEasingStatus(false);
-                                    buttonslot->getEasingTime()->restart();
-                                }
-                            }
-                            else if (temp <= 0.75)
-                            {
-                                // Perform Linear accleration with an appropriate
-                                // offset.
-                                difference = (difference - 0.248);
-
-                                // Out of high end. Reset easing status.
-                                if (buttonslot->isEasingActive())
-                                {
-                                    buttonslot->setEasingStatus(false);
-                                    buttonslot->getEasingTime()->restart();
-                                }
-                            }
-                            else if (temp > 0.75)
-                            {
-                                // Gradually increase the mouse speed until the specified elapsed duration
-                                // time has passed.
-                                int easingElapsed = buttonslot->getEasingTime()->elapsed();
-                                double easingDuration = this->easingDuration; // Time in seconds
-                                if (!buttonslot->isEasingActive())
-                                {
-                                    buttonslot->setEasingStatus(true);
-                                    buttonslot->getEasingTime()->restart();
-                                    easingElapsed = 0;
-                                }
-
-                                // Determine the multiplier to use for the current maximum mouse speed
-                                // based on how much time has passed.
-                                double elapsedDiff = 1.0;
-                                if ((easingDuration > 0.0) && ((easingElapsed * .001) < easingDuration))
-                                {
-                                    elapsedDiff = ((easingElapsed * .001) / easingDuration);
-                                    if (currentCurve == EasingQuadraticCurve)
-                                    {
-                                        elapsedDiff = (1.5 - 1.0) * elapsedDiff * elapsedDiff + 1.0;
-                                    }
-                                    else
-                                    {
-                                        elapsedDiff = (1.5 - 1.0) * (elapsedDiff * elapsedDiff
-                                                     * elapsedDiff) + 1.0;
-                                    }
-                                }
-                                else
-                                {
-                                    elapsedDiff = 1.5;
-                                }
-
-                                // Allow gradient control on the high end of an axis.
-                                difference = (elapsedDiff * difference);
-                                difference = (difference * 1.33067 - 0.496005);
-                            }
-                            break;
-                        }
+                    double intermediateTravel = accelTravel;
+                    if (((getAccelerationDistance() - startingAccelerationDistance) >= 0) != (getAccelerationDistance() >= 0))
+                    {
+                        // Travelling towards dead zone. Decrease acceleration and duration.
+                        intermediateTravel = qMax(intermediateTravel - fabs(getAccelerationDistance() - startingAccelerationDistance), mintravel);
                     }
 
-                    double distance = 0;
-                    difference = (mouseSpeedModifier == 1.0) ? difference : (difference * mouseSpeedModifier);
-
-                    double mintravel = minMouseDistanceAccelThreshold * 0.01;
-                    double minstop = qMax(0.05, mintravel);
-                    //double currentTravel = getAccelerationDistance() - lastAccelerationDistance;
+                    // Linear case
+                    double currentAccelMultiTemp = (slope * intermediateTravel + intercept);
+                    double elapsedDuration = accelDuration *
+                            ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
 
-                    // Last check ensures that acceleration is only applied for the same direction.
-                    if (extraAccelerationEnabled && isPartRealAxis() &&
-                        (fabs(getAccelerationDistance() - lastAccelerationDistance) >= mintravel) &&
-                        (((getAccelerationDistance() - lastAccelerationDistance) >= 0) == (getAccelerationDistance() >= 0)))
+                    if (extraAccelCurve == EaseOutSineCurve)
                     {
-                        double magfactor = extraAccelerationMultiplier;
-                        double minfactor = qMax((DEFAULTSTARTACCELMULTIPLIER * 0.001) + 1.0, magfactor * (startAccelMultiplier * 0.01));
-                        double maxtravel = maxMouseDistanceAccelThreshold * 0.01;
-                        double slope = (magfactor - minfactor)/(maxtravel - mintravel);
-                        double intercept = minfactor - (slope * mintravel);
-
-                        double intermediateTravel = qMin(maxtravel, fabs(getAccelerationDistance() - lastAccelerationDistance));
-                        if ((currentAccelMulti > 1.0) && (oldAccelMulti == 0.0))
-                        {
-                            intermediateTravel = qMin(maxtravel, intermediateTravel + mintravel);
-                        }
-
-                        double currentAccelMultiTemp = (slope * intermediateTravel + intercept);
-                        if (extraAccelCurve == EaseOutSineCurve)
-                        {
-                            double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * sin(getMultiDiff2 * (PI/2.0)) + minfactor;
-                        }
-                        else if (extraAccelCurve == EaseOutQuadAccelCurve)
-                        {
-                            double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            currentAccelMultiTemp = -(extraAccelerationMultiplier - minfactor) * (getMultiDiff2 * (getMultiDiff2 - 2)) + minfactor;
-                        }
-                        else if (extraAccelCurve == EaseOutCubicAccelCurve)
-                        {
-                            double getMultiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor)) - 1;
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * ((getMultiDiff) * (getMultiDiff) * (getMultiDiff) + 1) + minfactor;
-                        }
-
-                        difference = difference * currentAccelMultiTemp;
-                        currentAccelMulti = currentAccelMultiTemp;
-                        updateOldAccelMulti = currentAccelMulti;
-                        accelTravel = intermediateTravel;
-                        accelExtraDurationTime.restart();
+                        double multiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
+                        double temp = sin(multiDiff * (PI/2.0));
+                        elapsedDuration = accelDuration * temp + 0;
+                        currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * sin(multiDiff * (PI/2.0)) + minfactor;
                     }
-                    else if (extraAccelerationEnabled && isPartRealAxis() && (accelDuration > 0.0) &&
-                             (currentAccelMulti > 0.0) &&
-                             (fabs(getAccelerationDistance() - startingAccelerationDistance) < minstop))
+                    else if (extraAccelCurve == EaseOutQuadAccelCurve)
                     {
-                        #ifndef QT_DEBUG_NO_OUTPUT
-                        qDebug() << "Keep Trying: " << fabs(getAccelerationDistance() - lastAccelerationDistance);
-                        qDebug() << "MIN TRAVEL: " << mintravel;
-                        #endif
-
-                        updateStartingMouseDistance = true;
-                        double magfactor = extraAccelerationMultiplier;
-                        double minfactor = qMax((DEFAULTSTARTACCELMULTIPLIER * 0.001) + 1.0, magfactor * (startAccelMultiplier * 0.01));
-                        double maxtravel = maxMouseDistanceAccelThreshold * 0.01;
-                        double slope = (magfactor - minfactor)/(maxtravel - mintravel);
-                        double intercept = minfactor - (slope * mintravel);
-
-                        int elapsedElapsed = accelExtraDurationTime.elapsed();
-
-                        double intermediateTravel = accelTravel;
-                        if (((getAccelerationDistance() - startingAccelerationDistance) >= 0) != (getAccelerationDistance() >= 0))
-                        {
-                            // Travelling towards dead zone. Decrease acceleration and duration.
-                            intermediateTravel = qMax(intermediateTravel - fabs(getAccelerationDistance() - startingAccelerationDistance), mintravel);
-                        }
-
-                        // Linear case
-                        double currentAccelMultiTemp = (slope * intermediateTravel + intercept);
-                        double elapsedDuration = accelDuration *
-                                ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-
-                        if (extraAccelCurve == EaseOutSineCurve)
-                        {
-                            double multiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            double temp = sin(multiDiff * (PI/2.0));
-                            elapsedDuration = accelDuration * temp + 0;
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * sin(multiDiff * (PI/2.0)) + minfactor;
-                        }
-                        else if (extraAccelCurve == EaseOutQuadAccelCurve)
-                        {
-                            double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
-                            double temp = (getMultiDiff2 * (getMultiDiff2 - 2));
-                            elapsedDuration = -accelDuration * temp + 0;
-                            currentAccelMultiTemp = -(extraAccelerationMultiplier - minfactor) * temp + minfactor;
-                        }
-                        else if (extraAccelCurve == EaseOutCubicAccelCurve)
-                        {
-                            double getMultiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor)) - 1;
-                            double temp = ((getMultiDiff) * (getMultiDiff) * (getMultiDiff) + 1);
-                            elapsedDuration = accelDuration * temp + 0;
-                            currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * temp + minfactor;
-                        }
+                        double getMultiDiff2 = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor));
+                        double temp = (getMultiDiff2 * (getMultiDiff2 - 2));
+                        elapsedDuration = -accelDuration * temp + 0;
+                        currentAccelMultiTemp = -(extraAccelerationMultiplier - minfactor) * temp + minfactor;
+                    }
+                    else if (extraAccelCurve == EaseOutCubicAccelCurve)
+                    {
+                        double getMultiDiff = ((currentAccelMultiTemp - minfactor) / (extraAccelerationMultiplier - minfactor)) - 1;
+                        double temp = ((getMultiDiff) * (getMultiDiff) * (getMultiDiff) + 1);
+                        elapsedDuration = accelDuration * temp + 0;
+                        currentAccelMultiTemp = (extraAccelerationMultiplier - minfactor) * temp + minfactor;
+                    }
 
-                        double tempAccel = currentAccelMultiTemp;
-                        double elapsedDiff = 1.0;
-                        if ((elapsedDuration > 0.0) && ((elapsedElapsed * 0.001) < elapsedDuration))
-                        {
-                            elapsedDiff = ((elapsedElapsed * 0.001) / elapsedDuration);
-                            elapsedDiff = (1.0 - tempAccel) * (elapsedDiff * elapsedDiff * elapsedDiff) + tempAccel;
+                    double tempAccel = currentAccelMultiTemp;
+                    double elapsedDiff = 1.0;
+                    if ((elapsedDuration > 0.0) && ((elapsedElapsed * 0.001) < elapsedDuration))
+                    {
+                        elapsedDiff = ((elapsedElapsed * 0.001) / elapsedDuration);
+                        elapsedDiff = (1.0 - tempAccel) * (elapsedDiff * elapsedDiff * elapsedDiff) + tempAccel;
 
-                            difference = elapsedDiff * difference;
+                        difference = elapsedDiff * difference;
 
-                            // As acceleration is applied, do not update last
-                            // distance values when not necessary.
-                            updateStartingMouseDistance = false;
-                            updateOldAccelMulti = currentAccelMulti;
-                        }
-                        else
-                        {
-                            elapsedDiff = 1.0;
-                            currentAccelMulti = 0.0;
-                            updateOldAccelMulti = 0.0;
-                            accelTravel = 0.0;
-                        }
+                        // As acceleration is applied, do not update last
+                        // distance values when not necessary.
+                        updateStartingMouseDistance = false;
+                        updateOldAccelMulti = currentAccelMulti;
                     }
-                    else if (extraAccelerationEnabled && isPartRealAxis())
+                    else
                     {
+                        elapsedDiff = 1.0;
                         currentAccelMulti = 0.0;
-                        updateStartingMouseDistance = true;
-                        oldAccelMulti = updateOldAccelMulti = 0.0;
+                        updateOldAccelMulti = 0.0;
                         accelTravel = 0.0;
                     }
+                }
+                else if (extraAccelerationEnabled && isPartRealAxis())
+                {
+                    currentAccelMulti = 0.0;
+                    updateStartingMouseDistance = true;
+                    oldAccelMulti = updateOldAccelMulti = 0.0;
+                    accelTravel = 0.0;
+                }
 
-                    sumDist += difference * (mousespeed * JoyButtonSlot::JOYSPEED * timeElapsed) * 0.001;
-                    distance = sumDist;
+                sumDist += difference * (mousespeed * JoyButtonSlot::JOYSPEED * timeElapsed) * 0.001;
+                distance = sumDist;
 
-                    if (mousedirection == static_cast<int>(JoyButtonSlot::MouseRight))
-                    {
-                        mouse1 = distance;
-                    }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseLeft))
-                    {
-                        mouse1 = -distance;
-                    }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseDown))
-                    {
-                        mouse2 = distance;
-                    }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseUp))
-                    {
-                        mouse2 = -distance;
-                    }
+                if (mousedirection == static_cast<int>(JoyButtonSlot::MouseRight))
+                {
+                    mouse1 = distance;
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseLeft))
+                {
+                    mouse1 = -distance;
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseDown))
+                {
+                    mouse2 = distance;
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseUp))
+                {
+                    mouse2 = -distance;
+                }
 
-                    mouseCursorInfo infoX;
-                    infoX.code = mouse1;
-                    infoX.slot = buttonslot;
-                    cursorXSpeeds.append(infoX);
+                mouseCursorInfo infoX;
+                infoX.code = mouse1;
+                infoX.slot = buttonslot;
+                cursorXSpeeds.append(infoX);
 
-                    mouseCursorInfo infoY;
-                    infoY.code = mouse2;
-                    infoY.slot = buttonslot;
-                    cursorYSpeeds.append(infoY);
-                    sumDist = 0;
+                mouseCursorInfo infoY;
+                infoY.code = mouse2;
+                infoY.slot = buttonslot;
+                cursorYSpeeds.append(infoY);
+                sumDist = 0;
 
-                    buttonslot->setDistance(sumDist);
-                }
-                else if (mousemode == JoyButton::MouseSpring)
-                {
-                    double mouse1 = -2.0;
-                    double mouse2 = -2.0;
-                    double difference = getMouseDistanceFromDeadZone();
+                buttonslot->setDistance(sumDist);
+            }
+            else if (mousemode == JoyButton::MouseSpring)
+            {
+                double mouse1 = -2.0;
+                double mouse2 = -2.0;
+                double difference = getSampledMouseDistance();
 
-                    if (mousedirection == static_cast<int>(JoyButtonSlot::MouseRight))
+                if (mousedirection == static_cast<int>(JoyButtonSlot::MouseRight))
+                {
+                    mouse1 = difference;
+                    if (mouseHelper.getFirstSpringStatus())
                     {
-                        mouse1 = difference;
-                        if (mouseHelper.getFirstSpringStatus())
-                        {
-                            mouse2 = 0.0;
-                            mouseHelper.setFirstSpringStatus(false);
-                        }
+                        mouse2 = 0.0;
+                        mouseHelper.setFirstSpringStatus(false);
                     }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseLeft))
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseLeft))
+                {
+                    mouse1 = -difference;
+                    if (mouseHelper.getFirstSpringStatus())
                     {
-                        mouse1 = -difference;
-                        if (mouseHelper.getFirstSpringStatus())
-                        {
-                            mouse2 = 0.0;
-                            mouseHelper.setFirstSpringStatus(false);
-                        }
+                        mouse2 = 0.0;
+                        mouseHelper.setFirstSpringStatus(false);
                     }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseDown))
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseDown))
+                {
+                    if (mouseHelper.getFirstSpringStatus())
                     {
-                        if (mouseHelper.getFirstSpringStatus())
-                        {
-                            mouse1 = 0.0;
-                            mouseHelper.setFirstSpringStatus(false);
-                        }
-
-                        mouse2 = difference;
+                        mouse1 = 0.0;
+                        mouseHelper.setFirstSpringStatus(false);
                     }
-                    else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseUp))
-                    {
-                        if (mouseHelper.getFirstSpringStatus())
-                        {
-                            mouse1 = 0.0;
-                            mouseHelper.setFirstSpringStatus(false);
-                        }
 
-                        mouse2 = -difference;
+                    mouse2 = difference;
+                }
+                else if (mousedirection == static_cast<int>(JoyButtonSlot::MouseUp))
+                {
+                    if (mouseHelper.getFirstSpringStatus())
+                    {
+                        mouse1 = 0.0;
+                        mouseHelper.setFirstSpringStatus(false);
                     }
 
-                    PadderCommon::springModeInfo infoX;
-                    infoX.displacementX = mouse1;
-                    infoX.springDeadX = 0.0;
-                    infoX.width = springWidth;
-                    infoX.height = springHeight;
-                    infoX.relative = relativeSpring;
-                    infoX.screen = springModeScreen;
-                    springXSpeeds.append(infoX);
+                    mouse2 = -difference;
+                }
 
-                    PadderCommon::springModeInfo infoY;
-                    infoY.displacementY = mouse2;
-                    infoY.springDeadY = 0.0;
-                    infoY.width = springWidth;
-                    infoY.height = springHeight;
-                    infoY.relative = relativeSpring;
-                    infoY.screen = springModeScreen;
-                    springYSpeeds.append(infoY);
+                PadderCommon::springModeInfo infoX;
+                infoX.displacementX = mouse1;
+                infoX.springDeadX = 0.0;
+                infoX.width = springWidth;
+                infoX.height = springHeight;
+                infoX.relative = relativeSpring;
+                infoX.screen = springModeScreen;
+                springXSpeeds.append(infoX);
 
-                    mouseInterval->restart();
-                }
+                PadderCommon::springModeInfo infoY;
+                infoY.displacementY = mouse2;
+                infoY.springDeadY = 0.0;
+                infoY.width = springWidth;
+                infoY.height = springHeight;
+                infoY.relative = relativeSpring;
+                infoY.screen = springModeScreen;
+                springYSpeeds.append(infoY);
 
-                tempQueue.enqueue(buttonslot);
+                mouseInterval->restart();
             }
 
+            tempQueue.enqueue(buttonslot);
+
             if (!mouseEventQueue.isEmpty() && !singleShot)
             {
                 buttonslot = mouseEventQueue.dequeue();
@@ -1707,10 +1641,212 @@ void JoyButton::mouseEvent()
     }
 }
 
+/**
+ * @brief Mark the mouse distance as stale. Called when a new input sample
+ *     arrives or a property used by the mouse curve or by the distance of
+ *     the parent element changes.
+ */
+void JoyButton::invalidateMouseDistance()
+{
+    mouseSampleSerial.fetchAndAddRelaxed(1);
+}
+
+/**
+ * @brief Get the distance from the dead zone of the last input sample.
+ *     The distance is only calculated again after a new sample arrived.
+ * @return Distance factor that should be used for mouse movement
+ */
+double JoyButton::getSampledMouseDistance()
+{
+    int serial = mouseSampleSerial.load();
+    if (serial != mouseDistanceSerial)
+    {
+        mouseDistanceSerial = serial;
+        sampledMouseDistance = getMouseDistanceFromDeadZone();
+        curvedMouseDistanceValid = false;
+    }
+
+    return sampledMouseDistance;
+}
+
+/**
+ * @brief Get the distance of the last input sample with the mouse curve
+ *     applied. Easing curves depend on how long a slot stays in the
+ *     high end so they are evaluated on every call.
+ * @param Slot that the distance is used for
+ * @return Distance factor after the mouse curve
+ */
+double JoyButton::getCurvedMouseDistance(JoyButtonSlot *buttonslot)
+{
+    double difference = getSampledMouseDistance();
+    JoyMouseCurve currentCurve = getMouseCurve();
+
+    if ((currentCurve == EasingQuadraticCurve) || (currentCurve == EasingCubicCurve))
+    {
+        difference = applyMouseCurve(currentCurve, difference, buttonslot);
+    }
+    else
+    {
+        if (!curvedMouseDistanceValid)
+        {
+            curvedMouseDistance = applyMouseCurve(currentCurve, difference, buttonslot);
+            curvedMouseDistanceValid = true;
+        }
+
+        difference = curvedMouseDistance;
+    }
+
+    return difference;
+}
+
+/**
+ * @brief Apply a mouse curve to a distance from the dead zone.
+ * @param Curve to apply
+ * @param Distance from the dead zone
+ * @param Slot used to track easing state
+ * @return Distance factor after the mouse curve
+ */
+double JoyButton::applyMouseCurve(JoyMouseCurve currentCurve, double difference, JoyButtonSlot *buttonslot)
+{
+    switch (currentCurve)
+    {
+        case LinearCurve:
+        {
+            break;
+        }
+        case QuadraticCurve:
+        {
+            difference = difference * difference;
+            break;
+        }
+        case CubicCurve:
+        {
+            difference = difference * difference * difference;
+            break;
+        }
+        case QuadraticExtremeCurve:
+        {
+            double temp = difference;
+            difference = difference * difference;
+            difference = (temp >= 0.95) ? (difference * 1.5) : difference;
+            break;
+        }
+        case PowerCurve:
+        {
+            double tempsensitive = qMin(qMax(sensitivity, 1.0e-3), 1.0e+3);
+            double temp = qMin(qMax(pow(difference, 1.0 / tempsensitive), 0.0), 1.0);
+            difference = temp;
+            break;
+        }
+        case EnhancedPrecisionCurve:
+        {
+            // Perform different forms of acceleration depending on
+            // the range of the element from its assigned dead zone.
+            // Useful for more precise controls with an axis.
+            double temp = difference;
+            if (temp <= 0.4)
+            {
+                // Low slope value for really slow acceleration
+                difference = (difference * 0.37);
+            }
+            else if (temp <= 0.75)
+            {
+                // Perform Linear accleration with an appropriate
+                // offset.
+                difference = (difference - 0.252);
+            }
+            else if (temp > 0.75)
+            {
+                // Perform mouse acceleration. Make up the difference
+                // due to the previous two segments. Maxes out at 1.0.
+                difference = (difference * 2.008) - 1.008;
+            }
+
+            break;
+        }
+        case EasingQuadraticCurve:
+        case EasingCubicCurve:
+        {
+            // Perform different forms of acceleration depending on
+            // the range of the element from its assigned dead zone.
+            // Useful for more precise controls with an axis.
+            double temp = difference;
+            if (temp <= 0.4)
+            {
+                // Low slope value for really slow acceleration
+                difference = (difference * 0.38);
+
+                // Out of high end. Reset easing status.
+                if (buttonslot->isEasingActive())
+                {
+                    buttonslot->setEasingStatus(false);
+                    buttonslot->getEasingTime()->restart();
+                }
+            }
+            else if (temp <= 0.75)
+            {
+                // Perform Linear accleration with an appropriate
+                // offset.
+                difference = (difference - 0.248);
+
+                // Out of high end. Reset easing status.
+                if (buttonslot->isEasingActive())
+                {
+                    buttonslot->setEasingStatus(false);
+                    buttonslot->getEasingTime()->restart();
+                }
+            }
+            else if (temp > 0.75)
+            {
+                // Gradually increase the mouse speed until the specified elapsed duration
+                // time has passed.
+                int easingElapsed = buttonslot->getEasingTime()->elapsed();
+                double easingDuration = this->easingDuration; // Time in seconds
+                if (!buttonslot->isEasingActive())
+                {
+                    buttonslot->setEasingStatus(true);
+                    buttonslot->getEasingTime()->restart();
+                    easingElapsed = 0;
+                }
+
+                // Determine the multiplier to use for the current maximum mouse speed
+                // based on how much time has passed.
+                double elapsedDiff = 1.0;
+                if ((easingDuration > 0.0) && ((easingElapsed * .001) < easingDuration))
+                {
+                    elapsedDiff = ((easingElapsed * .001) / easingDuration);
+                    if (currentCurve == EasingQuadraticCurve)
+                    {
+                        elapsedDiff = (1.5 - 1.0) * elapsedDiff * elapsedDiff + 1.0;
+                    }
+                    else
+                    {
+                        elapsedDiff = (1.5 - 1.0) * (elapsedDiff * elapsedDiff
+                                     * elapsedDiff) + 1.0;
+                    }
+                }
+                else
+                {
+                    elapsedDiff = 1.5;
+                }
+
+                // Allow gradient control on the high end of an axis.
+                difference = (elapsedDiff * difference);
+                difference = (difference * 1.33067 - 0.496005);
+            }
+            break;
+        }
+    }
+
+    return difference;
+}
+
 void JoyButton::wheelEventVertical()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    PadderCommon::OutputStageLocker outputLocker;
+
     JoyButtonSlot *buttonslot = nullptr;
     if (currentWheelVerticalEvent != nullptr)
     {
@@ -1767,6 +1903,8 @@ void JoyButton::wheelEventHorizontal()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    PadderCommon::OutputStageLocker outputLocker;
+
     JoyButtonSlot *buttonslot = nullptr;
     if (currentWheelHorizontalEvent != nullptr)
     {
@@ -2491,29 +2629,38 @@ QString JoyButton::getPartialName(bool forceFullFormat, bool displayNames) const
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    QString temp = QString();
-    if (!buttonName.isEmpty() && displayNames)
+    int cacheIndex = (forceFullFormat ? 2 : 0) | (displayNames ? 1 : 0);
+    QMutexLocker tempNameLocker(&nameCacheLock);
+
+    if ((nameCacheValidMask & (1 << cacheIndex)) == 0)
     {
-        if (forceFullFormat)
+        QString temp = QString();
+        if (!buttonName.isEmpty() && displayNames)
         {
-            temp.append(trUtf8("Button")).append(" ");
+            if (forceFullFormat)
+            {
+                temp.append(trUtf8("Button")).append(" ");
+            }
+            temp.append(buttonName);
         }
-        temp.append(buttonName);
-    }
-    else if (!defaultButtonName.isEmpty())
-    {
-        if (forceFullFormat)
+        else if (!defaultButtonName.isEmpty())
         {
-            temp.append(trUtf8("Button")).append(" ");
+            if (forceFullFormat)
+            {
+                temp.append(trUtf8("Button")).append(" ");
+            }
+            temp.append(defaultButtonName);
         }
-        temp.append(defaultButtonName);
-    }
-    else
-    {
-        temp.append(trUtf8("Button")).append(" ").append(QString::number(getRealJoyNumber()));
+        else
+        {
+            temp.append(trUtf8("Button")).append(" ").append(QString::number(getRealJoyNumber()));
+        }
+
+        partialNameCache[cacheIndex] = temp;
+        nameCacheValidMask |= (1 << cacheIndex);
     }
 
-    return temp;
+    return partialNameCache[cacheIndex];
 }
 
 /**
@@ -2525,36 +2672,43 @@ QString JoyButton::getSlotsSummary()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    QString newlabel = QString();
-    int slotCount = getAssignedSlots()->size();
-
-    if (slotCount > 0)
+    QMutexLocker tempSlotStringsLocker(&slotStringsLock);
+    if (!slotsSummaryValid)
     {
-        QListIterator<JoyButtonSlot*> iter(*getAssignedSlots());
-        QStringList stringlist = QStringList();
+        QString newlabel = QString();
+        int slotCount = getAssignedSlots()->size();
 
-        int i = 0;
-        while (iter.hasNext())
+        if (slotCount > 0)
         {
-            JoyButtonSlot *slot = iter.next();
-            stringlist.append(slot->getSlotString());
-            i++;
+            QListIterator<JoyButtonSlot*> iter(*getAssignedSlots());
+            QStringList stringlist = QStringList();
 
-            if ((i > 4) && iter.hasNext())
+            int i = 0;
+            while (iter.hasNext())
             {
-                stringlist.append(" ...");
-                iter.toBack();
+                JoyButtonSlot *slot = iter.next();
+                stringlist.append(slot->getSlotString());
+                i++;
+
+                if ((i > 4) && iter.hasNext())
+                {
+                    stringlist.append(" ...");
+                    iter.toBack();
+                }
             }
+
+            newlabel = stringlist.join(", ");
+        }
+        else
+        {
+            newlabel = newlabel.append(trUtf8("[NO KEY]"));
         }
 
-        newlabel = stringlist.join(", ");
-    }
-    else
-    {
-        newlabel = newlabel.append(trUtf8("[NO KEY]"));
+        slotsSummaryCache = newlabel;
+        slotsSummaryValid = true;
     }
 
-    return newlabel;
+    return slotsSummaryCache;
 }
 
 /**
@@ -2571,28 +2725,66 @@ QString JoyButton::getActiveZoneSummary()
     return temp;
 }
 
+/**
+ * @brief Get the active zone string. A stale string is rebuilt when
+ *     called from the thread that owns the button. Other threads get
+ *     the last built string and a rebuild is queued which will emit
+ *     activeZoneChanged once it is done.
+ * @return Active zone string
+ */
 QString JoyButton::getCalculatedActiveZoneSummary()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    activeZoneStringLock.lockForRead();
-    QString temp = this->activeZoneString;
-    activeZoneStringLock.unlock();
+    QString temp = QString();
+
+    if (thread() == QThread::currentThread())
+    {
+        activeZoneStringLock.lockForWrite();
+        if (activeZoneStringDirty)
+        {
+            this->activeZoneString = getActiveZoneSummary();
+            activeZoneStringDirty = false;
+        }
+
+        temp = this->activeZoneString;
+        activeZoneStringLock.unlock();
+    }
+    else
+    {
+        activeZoneStringLock.lockForRead();
+        temp = this->activeZoneString;
+        bool dirty = activeZoneStringDirty;
+        activeZoneStringLock.unlock();
+
+        if (dirty && activeZoneRefreshQueued.testAndSetOrdered(0, 1))
+        {
+            QMetaObject::invokeMethod(this, "refreshActiveZoneSummary", Qt::QueuedConnection);
+        }
+    }
+
     return temp;
 }
 
 /**
- * @brief Generate active zone string and notify other objects.
+ * @brief Generate active zone string and notify other objects. The string
+ *     is only marked as stale when nothing is connected to activeZoneChanged.
  */
 void JoyButton::buildActiveZoneSummaryString()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    activeZoneStringLock.lockForWrite();
-    this->activeZoneString = getActiveZoneSummary();
-    activeZoneStringLock.unlock();
-
-    emit activeZoneChanged();
+    if (isActiveZoneObserved())
+    {
+        localBuildActiveZoneSummaryString();
+        emit activeZoneChanged();
+    }
+    else
+    {
+        activeZoneStringLock.lockForWrite();
+        activeZoneStringDirty = true;
+        activeZoneStringLock.unlock();
+    }
 }
 
 /**
@@ -2604,9 +2796,64 @@ void JoyButton::localBuildActiveZoneSummaryString()
 
     activeZoneStringLock.lockForWrite();
     this->activeZoneString = getActiveZoneSummary();
+    activeZoneStringDirty = false;
     activeZoneStringLock.unlock();
 }
 
+void JoyButton::refreshActiveZoneSummary()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    activeZoneRefreshQueued.storeRelease(0);
+    localBuildActiveZoneSummaryString();
+    emit activeZoneChanged();
+}
+
+/**
+ * @brief Update the active zone string after the active slots changed.
+ *     Building the string is skipped entirely while no widget displays it.
+ */
+void JoyButton::scheduleActiveZoneSummaryUpdate()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (isActiveZoneObserved())
+    {
+        activeZoneTimer.start();
+    }
+    else
+    {
+        activeZoneStringLock.lockForWrite();
+        activeZoneStringDirty = true;
+        activeZoneStringLock.unlock();
+    }
+}
+
+bool JoyButton::isActiveZoneObserved()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    static const QMetaMethod activeZoneSignal = QMetaMethod::fromSignal(&JoyButton::activeZoneChanged);
+    return isSignalConnected(activeZoneSignal);
+}
+
+void JoyButton::invalidateSlotStrings()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker tempSlotStringsLocker(&slotStringsLock);
+    slotsSummaryValid = false;
+    slotsStringValid = false;
+}
+
+void JoyButton::invalidateNameCache()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker tempNameLocker(&nameCacheLock);
+    nameCacheValidMask = 0;
+}
+
 QString JoyButton::buildActiveZoneSummary(QList<JoyButtonSlot *> &tempList)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -2865,35 +3112,42 @@ QString JoyButton::getSlotsString()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    QString label = QString();
-
-    if (getAssignedSlots()->size() > 0)
+    QMutexLocker tempSlotStringsLocker(&slotStringsLock);
+    if (!slotsStringValid)
     {
-        #ifndef QT_DEBUG_NO_OUTPUT
-        qDebug() << "There is more assignments than 0 in getSlotsString(): " << getAssignedSlots()->count();
-        #endif
-
-        QListIterator<JoyButtonSlot*> iter(*getAssignedSlots());
-        QStringList stringlist = QStringList();
+        QString label = QString();
 
-        while (iter.hasNext())
+        if (getAssignedSlots()->size() > 0)
         {
-            JoyButtonSlot *slot = iter.next();
-            stringlist.append(slot->getSlotString());
+            #ifndef QT_DEBUG_NO_OUTPUT
+            qDebug() << "There is more assignments than 0 in getSlotsString(): " << getAssignedSlots()->count();
+            #endif
+
+            QListIterator<JoyButtonSlot*> iter(*getAssignedSlots());
+            QStringList stringlist = QStringList();
+
+            while (iter.hasNext())
+            {
+                JoyButtonSlot *slot = iter.next();
+                stringlist.append(slot->getSlotString());
+            }
+
+            label = stringlist.join(", ");
         }
+        else
+        {
+            #ifndef QT_DEBUG_NO_OUTPUT
+            qDebug() << "There is no assignments for button in getSlotsString()";
+            #endif
 
-        label = stringlist.join(", ");
-    }
-    else
-    {
-        #ifndef QT_DEBUG_NO_OUTPUT
-        qDebug() << "There is no assignments for button in getSlotsString()";
-        #endif
+            label = label.append(trUtf8("[NO KEY]"));
+        }
 
-        label = label.append(trUtf8("[NO KEY]"));
+        slotsStringCache = label;
+        slotsStringValid = true;
     }
 
-    return label;
+    return slotsStringCache;
 }
 
 
@@ -2933,6 +3187,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
             {
                 assignmentsLock.lockForWrite();
                 getAssignmentsLocal().append(slot);
+                updateSlotRecordsLocked();
                 assignmentsLock.unlock();
 
                 buildActiveZoneSummaryString();
@@ -2944,6 +3199,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        updateSlotRecordsLocked();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2992,6 +3248,7 @@ bool JoyButton::setAssignedSlot(int code, int alias,
             {
                 assignmentsLock.lockForWrite();
                 getAssignmentsLocal().append(slot);
+                updateSlotRecordsLocked();
                 assignmentsLock.unlock();
 
                 buildActiveZoneSummaryString();
@@ -3003,6 +3260,7 @@ bool JoyButton::setAssignedSlot(int code, int alias,
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        updateSlotRecordsLocked();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -3085,6 +3343,7 @@ bool JoyButton::setAssignedSlot(int code, int alias, int index,
             getAssignmentsLocal().append(slot);
         }
 
+        updateSlotRecordsLocked();
         checkTurboCondition(slot);
         assignmentsLock.unlock();
 
@@ -3160,6 +3419,7 @@ bool JoyButton::insertAssignedSlot(int code, int alias, int index,
         qDebug() << "assignments variable in joybutton has now: " << getAssignedSlots()->count() << " input slots";
         #endif
 
+        updateSlotRecordsLocked();
         checkTurboCondition(slot);
         assignmentsLock.unlock();
 
@@ -3218,8 +3478,9 @@ bool JoyButton::insertAssignedSlot(JoyButtonSlot *newSlot, bool updateActiveStri
     if (permitSlot)
     {
         assignmentsLock.lockForWrite();
-        checkTurboCondition(newSlot);
         getAssignmentsLocal().append(newSlot);
+        updateSlotRecordsLocked();
+        checkTurboCondition(newSlot);
         assignmentsLock.unlock();
 
         if (updateActiveString)
@@ -3296,6 +3557,7 @@ bool JoyButton::setAssignedSlot(JoyButtonSlot *otherSlot, int index)
             getAssignmentsLocal().append(newslot);
         }
 
+        updateSlotRecordsLocked();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -3499,7 +3761,19 @@ void JoyButton::pauseWaitEvent()
             releaseDeskTimer.stop();
         }
 
-        if (inpauseHold.elapsed() < currentPause->getSlotCode())
+        if (currentPause->getSlotMode() == JoyButtonSlot::JoyTextEntry)
+        {
+            // Wait for the text entry stream instead of a fixed time.
+            if (TextEntryStreamer::getInstance()->isStreaming())
+            {
+                pauseWaitTimer.start(TextEntryStreamer::STREAMINTERVAL);
+            }
+            else
+            {
+                finishPauseWait();
+            }
+        }
+        else if (inpauseHold.elapsed() < currentPause->getSlotCode())
         {
             int proposedInterval = currentPause->getSlotCode() - inpauseHold.elapsed();
             proposedInterval = proposedInterval > 0 ? proposedInterval : 0;
@@ -3508,17 +3782,7 @@ void JoyButton::pauseWaitEvent()
         }
         else
         {
-            pauseWaitTimer.stop();
-            createDeskTimer.stop();
-            currentPause = nullptr;
-            createDeskEvent();
-
-            // If release timer was disabled but if the button
-            // is not pressed, restart the release timer.
-            if (!releaseDeskTimer.isActive() && (isButtonPressedQueue.isEmpty() || !isButtonPressedQueue.last()))
-            {
-                waitForReleaseDeskEvent();
-            }
+            finishPauseWait();
         }
     }
     else
@@ -3527,6 +3791,26 @@ void JoyButton::pauseWaitEvent()
     }
 }
 
+/**
+ * @brief Continue the sequence after a pause or a streamed text entry.
+ */
+void JoyButton::finishPauseWait()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    pauseWaitTimer.stop();
+    createDeskTimer.stop();
+    currentPause = nullptr;
+    createDeskEvent();
+
+    // If release timer was disabled but if the button
+    // is not pressed, restart the release timer.
+    if (!releaseDeskTimer.isActive() && (isButtonPressedQueue.isEmpty() || !isButtonPressedQueue.last()))
+    {
+        waitForReleaseDeskEvent();
+    }
+}
+
 void JoyButton::checkForSetChange()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -3704,26 +3988,7 @@ bool JoyButton::containsSequence()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    bool result = false;
-
-    assignmentsLock.lockForRead();
-    QListIterator<JoyButtonSlot*> tempiter(*getAssignedSlots());
-    while (tempiter.hasNext())
-    {
-        JoyButtonSlot *slot = tempiter.next();
-        JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
-        if ((mode == JoyButtonSlot::JoyPause) ||
-            (mode == JoyButtonSlot::JoyHold) ||
-            (mode == JoyButtonSlot::JoyDistance)
-           )
-        {
-            result = true;
-            tempiter.toBack();
-        }
-    }
-    assignmentsLock.unlock();
-
-    return result;
+    return (getFeatureFlags() & ProfileFeatures::SequenceFeature) != 0;
 }
 
 void JoyButton::holdEvent()
@@ -4097,19 +4362,7 @@ bool JoyButton::containsDistanceSlots()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    bool result = false;
-    QListIterator<JoyButtonSlot*> iter(*getAssignedSlots());
-    while (iter.hasNext())
-    {
-        JoyButtonSlot *slot = iter.next();
-        if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
-
-    return result;
+    return (getFeatureFlags() & ProfileFeatures::DistanceFeature) != 0;
 }
 
 void JoyButton::clearAssignedSlots(bool signalEmit)
@@ -4128,6 +4381,7 @@ void JoyButton::clearAssignedSlots(bool signalEmit)
     }
 
     getAssignmentsLocal().clear();
+    updateSlotRecordsLocked();
 
     if (signalEmit)
     {
@@ -4143,13 +4397,14 @@ void JoyButton::removeAssignedSlot(int index)
 
     if ((index >= 0) && (index < getAssignedSlots()->size()))
     {
-        JoyButtonSlot *slot = getAssignedSlots()->takeAt(index);
+        JoyButtonSlot *slot = getAssignmentsLocal().takeAt(index);
         if (slot != nullptr)
         {
             delete slot;
             slot = nullptr;
         }
 
+        updateSlotRecordsLocked();
         tempAssignLocker.unlock();
 
         buildActiveZoneSummaryString();
@@ -4170,6 +4425,7 @@ void JoyButton::clearSlotsEventReset(bool clearSignalEmit)
     holdTimer.stop();
     mouseWheelVerticalEventTimer.stop();
     mouseWheelHorizontalEventTimer.stop();
+    removePendingWheelButton();
     setChangeTimer.stop();
     keyPressTimer.stop();
     delayTimer.stop();
@@ -4181,8 +4437,8 @@ void JoyButton::clearSlotsEventReset(bool clearSignalEmit)
 
     if (slotiter != nullptr)
     {
-        delete slotiter;
         slotiter = nullptr;
+        sequenceIterator.clear();
     }
 
     releaseActiveSlots();
@@ -4213,7 +4469,7 @@ void JoyButton::clearSlotsEventReset(bool clearSignalEmit)
 
     isKeyPressed = isButtonPressed = false;
 
-    activeZoneTimer.start();
+    scheduleActiveZoneSummaryUpdate();
     quitEvent = true;
 
 
@@ -4232,6 +4488,7 @@ void JoyButton::eventReset()
     holdTimer.stop();
     mouseWheelVerticalEventTimer.stop();
     mouseWheelHorizontalEventTimer.stop();
+    removePendingWheelButton();
     setChangeTimer.stop();
     keyPressTimer.stop();
     delayTimer.stop();
@@ -4243,8 +4500,8 @@ void JoyButton::eventReset()
 
     if (slotiter != nullptr)
     {
-        delete slotiter;
         slotiter = nullptr;
+        sequenceIterator.clear();
     }
 
     isButtonPressedQueue.clear();
@@ -4277,41 +4534,64 @@ void JoyButton::eventReset()
     quitEvent = true;
 }
 
+/**
+ * @brief Release everything the button holds when its device goes away
+ *     but the button object is kept, like the reset done on deletion.
+ *     Assignments are left untouched.
+ */
+void JoyButton::detachReset()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    eventReset();
+
+    // Released set change slots would otherwise switch sets later.
+    slotSetChangeTimer.stop();
+
+    PadderCommon::OutputStageLocker outputLocker;
+    pendingMouseButtons.removeAll(this);
+    pendingWheelButtons.removeAll(this);
+}
+
+/**
+ * @brief Add a slot to the active slots. Its record is kept alongside so
+ *     releasing the slots does not read the slot objects.
+ */
+void JoyButton::appendActiveSlot(const JoyButtonSlotIterator::Record &record)
+{
+    getActiveSlotsLocal().append(record.slot);
+    activeSlotRecords.append(record);
+}
+
 void JoyButton::releaseActiveSlots()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     if (!getActiveSlots().isEmpty())
     {
+        PadderCommon::OutputStageLocker outputLocker;
         QWriteLocker tempLocker(&activeZoneLock);
 
         #ifdef Q_OS_WIN
             bool changeRepeatState = false;
         #endif
-        QListIterator<JoyButtonSlot*> iter(getActiveSlots());
-
-        iter.toBack();
-        while (iter.hasPrevious())
+        for (int index = activeSlotRecords.size() - 1; index >= 0; index--)
         {
-            JoyButtonSlot *slot = iter.previous();
-            int tempcode = slot->getSlotCode();
-            JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
+            const JoyButtonSlotIterator::Record &record = activeSlotRecords.at(index);
+            JoyButtonSlot *slot = record.slot;
+            int tempcode = record.code;
+            JoyButtonSlot::JoySlotInputAction mode = static_cast<JoyButtonSlot::JoySlotInputAction>(record.mode);
 
             if (mode == JoyButtonSlot::JoyKeyboard)
             {
-                int referencecount = activeKeys.value(tempcode, 1) - 1;
+                int referencecount = activeKeys.release(tempcode);
                 if (referencecount <= 0)
                 {
                     sendevent(slot, false);
-                    activeKeys.remove(tempcode);
                     #ifdef Q_OS_WIN
                         changeRepeatState = true;
                     #endif
                 }
-                else
-                {
-                    activeKeys.insert(tempcode, referencecount);
-                }
 
                 if ((lastActiveKey == slot) && (referencecount <= 0))
                 {
@@ -4325,15 +4605,10 @@ void JoyButton::releaseActiveSlots()
                     (tempcode != static_cast<int>(JoyButtonSlot::MouseWheelLeft)) &&
                     (tempcode != static_cast<int>(JoyButtonSlot::MouseWheelRight)))
                 {
-                    int referencecount = (activeMouseButtons.value(tempcode, 1) - 1);
+                    int referencecount = activeMouseButtons.release(tempcode);
                     if (referencecount <= 0)
                     {
-                        sendevent(slot, false);
-                        activeMouseButtons.remove(tempcode);
-                    }
-                    else
-                    {
-                        activeMouseButtons.insert(tempcode, referencecount);
+                        sendevent(slot, false);
                     }
                 }
                 else if ((tempcode == static_cast<int>(JoyButtonSlot::MouseWheelUp)) ||
@@ -4516,6 +4791,7 @@ void JoyButton::releaseActiveSlots()
         }
 
         getActiveSlotsLocal().clear();
+        activeSlotRecords.clear();
 
         currentMouseEvent = nullptr;
         if (!mouseEventQueue.isEmpty())
@@ -4524,6 +4800,7 @@ void JoyButton::releaseActiveSlots()
         }
 
         pendingMouseButtons.removeAll(this);
+        pendingWheelButtons.removeAll(this);
         currentWheelVerticalEvent = nullptr;
         currentWheelHorizontalEvent = nullptr;
         mouseWheelVerticalEventTimer.stop();
@@ -4549,11 +4826,11 @@ void JoyButton::releaseActiveSlots()
         if ((pendingMouseButtons.length() == 0) && (cursorXSpeeds.length() == 0) &&
             (springXSpeeds.length() == 0))
         {
-            cursorRemainderX = 0;
-            cursorRemainderY = 0;
+            cursorAccumulatorX.reset();
+            cursorAccumulatorY.reset();
         }
 
-        activeZoneTimer.start();
+        scheduleActiveZoneSummaryUpdate();
 
 #ifdef Q_OS_WIN
         BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
@@ -4586,19 +4863,92 @@ bool JoyButton::containsReleaseSlots()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    bool result = false;
-    QListIterator<JoyButtonSlot*> iter(*getAssignedSlots());
-    while (iter.hasNext())
+    return (getFeatureFlags() & ProfileFeatures::ReleaseFeature) != 0;
+}
+
+/**
+ * @brief Get the ProfileFeatures flags of the button. Slot flags are kept
+ *     current by the functions that change the assignments and property
+ *     flags are read from the current button state.
+ * @return Bitwise OR of ProfileFeatures::Feature values
+ */
+int JoyButton::getFeatureFlags()
+{
+    int flags = slotFeatureFlags.load();
+
+    if (((flags & ProfileFeatures::MouseCursorFeature) != 0) && (mouseMode == MouseSpring))
     {
-        JoyButtonSlot *slot = iter.next();
-        if (slot->getSlotMode() == JoyButtonSlot::JoyRelease)
+        flags = (flags & ~ProfileFeatures::MouseCursorFeature) | ProfileFeatures::MouseSpringFeature;
+    }
+
+    if (useTurbo)
+    {
+        flags |= ProfileFeatures::TurboFeature;
+    }
+
+    if (setSelectionCondition != SetChangeDisabled)
+    {
+        flags |= ProfileFeatures::SetChangeFeature;
+    }
+
+    return flags;
+}
+
+/**
+ * @brief Rebuild the slot records and the flags of the assigned slots.
+ *     Must be called with assignmentsLock held for writing after the list
+ *     has been changed so the input thread never sees records or flags
+ *     older than the list. Mouse movement slots are stored as
+ *     MouseCursorFeature and mapped to MouseSpringFeature by
+ *     getFeatureFlags.
+ */
+void JoyButton::updateSlotRecordsLocked()
+{
+    int flags = ProfileFeatures::NoFeatures;
+
+    slotRecords = JoyButtonSlotIterator::createRecords(assignments);
+
+    for (int i = 0; i < slotRecords.size(); i++)
+    {
+        JoyButtonSlot::JoySlotInputAction mode =
+                static_cast<JoyButtonSlot::JoySlotInputAction>(slotRecords.at(i).mode);
+
+        if ((mode == JoyButtonSlot::JoyKeyboard) || (mode == JoyButtonSlot::JoyKeyPress) ||
+            (mode == JoyButtonSlot::JoyTextEntry))
         {
-            result = true;
-            iter.toBack();
+            flags |= ProfileFeatures::KeyboardFeature;
+        }
+        else if (mode == JoyButtonSlot::JoyMouseButton)
+        {
+            flags |= ProfileFeatures::MouseButtonFeature;
+        }
+        else if (mode == JoyButtonSlot::JoyMouseMovement)
+        {
+            flags |= ProfileFeatures::MouseCursorFeature;
+        }
+        else if ((mode == JoyButtonSlot::JoyPause) || (mode == JoyButtonSlot::JoyHold))
+        {
+            flags |= ProfileFeatures::SequenceFeature;
+        }
+        else if (mode == JoyButtonSlot::JoyDistance)
+        {
+            flags |= (ProfileFeatures::SequenceFeature | ProfileFeatures::DistanceFeature);
+        }
+        else if (mode == JoyButtonSlot::JoyRelease)
+        {
+            flags |= ProfileFeatures::ReleaseFeature;
+        }
+        else if (mode == JoyButtonSlot::JoySetChange)
+        {
+            flags |= ProfileFeatures::SetChangeFeature;
+        }
+        else
+        {
+            flags |= ProfileFeatures::OtherFeature;
         }
     }
 
-    return result;
+    slotFeatureFlags.store(flags);
 }
 
 void JoyButton::releaseSlotEvent()
@@ -4611,7 +4961,10 @@ void JoyButton::releaseSlotEvent()
 
     if (containsReleaseSlots())
     {
-        QListIterator<JoyButtonSlot*> iter(*getAssignedSlots());
+        assignmentsLock.lockForRead();
+        JoyButtonSlotIterator iter(slotRecords);
+        assignmentsLock.unlock();
+
         if (previousCycle != nullptr)
         {
             iter.findNext(previousCycle);
@@ -4621,17 +4974,15 @@ void JoyButton::releaseSlotEvent()
 
         while (iter.hasNext())
         {
-            JoyButtonSlot *currentSlot = iter.next();
-            int tempcode = currentSlot->getSlotCode();
-            JoyButtonSlot::JoySlotInputAction mode = currentSlot->getSlotMode();
+            const JoyButtonSlotIterator::Record &record = iter.nextRecord();
+            int tempcode = record.code;
+            JoyButtonSlot::JoySlotInputAction mode = static_cast<JoyButtonSlot::JoySlotInputAction>(record.mode);
             if (mode == JoyButtonSlot::JoyRelease)
             {
-
-
                 tempElapsed += tempcode;
                 if (tempElapsed <= timeElapsed)
                 {
-                    temp = currentSlot;
+                    temp = record.slot;
                 }
                 else if (tempElapsed > timeElapsed)
                 {
@@ -4683,8 +5034,7 @@ void JoyButton::findReleaseEventEnd()
         qDebug() << "slotiter has next element";
         #endif
 
-        JoyButtonSlot *currentSlot = slotiter->next();
-        JoyButtonSlot::JoySlotInputAction mode = currentSlot->getSlotMode();
+        JoyButtonSlot::JoySlotInputAction mode = static_cast<JoyButtonSlot::JoySlotInputAction>(slotiter->nextRecord().mode);
 
         if (mode == JoyButtonSlot::JoyRelease)
         {
@@ -4756,8 +5106,7 @@ void JoyButton::findHoldEventEnd()
         qDebug() << "There is next element in slotiter";
         #endif
 
-        JoyButtonSlot *currentSlot = slotiter->next();
-        JoyButtonSlot::JoySlotInputAction mode = currentSlot->getSlotMode();
+        JoyButtonSlot::JoySlotInputAction mode = static_cast<JoyButtonSlot::JoySlotInputAction>(slotiter->nextRecord().mode);
 
         if (mode == JoyButtonSlot::JoyRelease)
         {
@@ -4892,6 +5241,7 @@ void JoyButton::setMouseCurve(JoyMouseCurve selectedCurve)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     mouseCurve = selectedCurve;
+    invalidateMouseDistance();
     emit propertyUpdated();
 }
 
@@ -4945,6 +5295,7 @@ void JoyButton::setSensitivity(double value)
     if ((value >= 0.001) && (value <= 1000))
     {
         sensitivity = value;
+        invalidateMouseDistance();
         emit propertyUpdated();
     }
 }
@@ -5000,6 +5351,7 @@ void JoyButton::setButtonName(QString tempName)
     if ((tempName.length() <= 20) && (tempName != buttonName))
     {
         buttonName = tempName;
+        invalidateNameCache();
         emit buttonNameChanged();
         emit propertyUpdated();
     }
@@ -5053,6 +5405,7 @@ void JoyButton::setDefaultButtonName(QString tempname)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     defaultButtonName = tempname;
+    invalidateNameCache();
 }
 
 QString JoyButton::getDefaultButtonName()
@@ -5108,13 +5461,13 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
         {
             mouseCursorInfo infoX = cursorXSpeeds.takeFirst();
             mouseCursorInfo infoY = cursorYSpeeds.takeFirst();
-            if (qFuzzyCompare(infoX.code, 0))
+            if (!qFuzzyIsNull(infoX.code))
             {
                 finalx = (infoX.code < 0) ? qMin(infoX.code, finalx) :
                                             qMax(infoX.code, finalx);
             }
 
-            if (qFuzzyCompare(infoY.code, 0))
+            if (!qFuzzyIsNull(infoY.code))
             {
                 finaly = (infoY.code < 0) ? qMin(infoY.code, finaly) :
                                             qMax(infoY.code, finaly);
@@ -5124,39 +5477,12 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
             infoY.slot->getMouseInterval()->restart();
         }
 
-        // Only apply remainder if both current displacement and remainder
-        // follow the same direction.
-        if ((cursorRemainderX >= 0) == (finalx >= 0))
-        {
-            finalx += cursorRemainderX;
-        }
-
-        // Cap maximum relative mouse movement.
-        if (abs(finalx) > 127)
-        {
-            finalx = (finalx < 0) ? -127 : 127;
-        }
+        mouseTickPacer.addCursorOutput(finalx / qMax(elapsedTime, 1),
+                                       finaly / qMax(elapsedTime, 1));
 
         mouseHistoryX.prepend(finalx);
-
-        // Only apply remainder if both current displacement and remainder
-        // follow the same direction.
-        if ((cursorRemainderY >= 0) == (finaly >= 0))
-        {
-            finaly += cursorRemainderY;
-        }
-
-        // Cap maximum relative mouse movement.
-        if (abs(finaly) > 127)
-        {
-            finaly = (finaly < 0) ? -127 : 127;
-        }
-
         mouseHistoryY.prepend(finaly);
 
-        cursorRemainderX = 0;
-        cursorRemainderY = 0;
-
         double adjustedX = 0;
         double adjustedY = 0;
 
@@ -5173,23 +5499,9 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
             currentWeight *= weightModifier;
         }
 
-        if (fabs(adjustedX) > 0)
+        if (finalWeight > 0.0)
         {
             adjustedX = adjustedX / finalWeight;
-
-            if (adjustedX > 0)
-            {
-                double oldX = adjustedX;
-                adjustedX = floor(adjustedX);
-                cursorRemainderX = oldX - adjustedX;
-            }
-            else
-            {
-                double oldX = adjustedX;
-                adjustedX = static_cast<int>(ceil(adjustedX));
-                cursorRemainderX = oldX - adjustedX;
-            }
-
         }
 
         QListIterator<double> iterY(mouseHistoryY);
@@ -5204,32 +5516,22 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
             currentWeight *= weightModifier;
         }
 
-        if (fabs(adjustedY) > 0)
+        if (finalWeight > 0.0)
         {
             adjustedY = adjustedY / finalWeight;
-            if (adjustedY > 0)
-            {
-                double oldY = adjustedY;
-                adjustedY = floor(adjustedY);
-                cursorRemainderY = oldY - adjustedY;
-            }
-            else
-            {
-                double oldY = adjustedY;
-                adjustedY = ceil(adjustedY);
-                cursorRemainderY = oldY - adjustedY;
-            }
         }
 
+        // Sub-pixel residue is carried over to the next event in both
+        // directions so slow movement is not lost to rounding.
+        movedX = cursorAccumulatorX.add(adjustedX);
+        movedY = cursorAccumulatorY.add(adjustedY);
+
         // This check is more of a precaution than anything. No need to cause
         // a sync to happen when not needed.
-        if ((qFuzzyCompare(adjustedX, 0)) || (qFuzzyCompare(adjustedY, 0)))
+        if ((movedX != 0) || (movedY != 0))
         {
-            sendevent(static_cast<int>(adjustedX), static_cast<int>(adjustedY));
+            sendevent(movedX, movedY);
         }
-
-        movedX = static_cast<int>(adjustedX);
-        movedY = static_cast<int>(adjustedY);
     }
     else
     {
@@ -5237,38 +5539,12 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
         mouseHistoryY.prepend(0);
     }
 
-    // Check if mouse event timer should use idle time.
     if (pendingMouseButtons.length() == 0)
     {
-        if (staticMouseEventTimer.interval() != IDLEMOUSEREFRESHRATE)
-        {
-            staticMouseEventTimer.start(IDLEMOUSEREFRESHRATE);
-
-            // Clear current mouse history
-            mouseHistoryX.clear();
-            mouseHistoryY.clear();
-
-            // Fill history with zeroes.
-            for (int i=0; i < mouseHistorySize; i++)
-            {
-                mouseHistoryX.append(0);
-                mouseHistoryY.append(0);
-            }
-        }
-
-        cursorRemainderX = 0;
-        cursorRemainderY = 0;
-    }
-    else
-    {
-        if (staticMouseEventTimer.interval() != mouseRefreshRate)
-        {
-            // Restore intended QTimer interval.
-            staticMouseEventTimer.start(mouseRefreshRate);
-        }
+        cursorAccumulatorX.reset();
+        cursorAccumulatorY.reset();
     }
 
-
     cursorXSpeeds.clear();
     cursorYSpeeds.clear();
 }
@@ -5422,20 +5698,7 @@ void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved)
         movedX = realMouseX;
         movedY = realMouseY;
         hasMoved = true;
-    }
-
-    // Check if mouse event timer should use idle time.
-    if (pendingMouseButtons.length() == 0)
-    {
-        staticMouseEventTimer.start(IDLEMOUSEREFRESHRATE);
-    }
-    else
-    {
-        if (staticMouseEventTimer.interval() != mouseRefreshRate)
-        {
-            // Restore intended QTimer interval.
-            staticMouseEventTimer.start(mouseRefreshRate);
-        }
+        mouseTickPacer.addSpringOutput(realMouseX, realMouseY);
     }
 
     springXSpeeds.clear();
@@ -5691,6 +5954,7 @@ void JoyButton::copyAssignments(JoyButton *destButton)
     destButton->eventReset();
     destButton->assignmentsLock.lockForWrite();
     destButton->getAssignmentsLocal().clear();
+    destButton->updateSlotRecordsLocked();
     destButton->assignmentsLock.unlock();
 
     assignmentsLock.lockForWrite();
@@ -5717,6 +5981,7 @@ void JoyButton::copyAssignments(JoyButton *destButton)
     destButton->sensitivity = sensitivity;
     destButton->buttonName = buttonName;
     destButton->actionName = actionName;
+    destButton->invalidateNameCache();
     destButton->cycleResetActive = cycleResetActive;
     destButton->cycleResetInterval = cycleResetInterval;
     destButton->relativeSpring = relativeSpring;
@@ -5948,6 +6213,7 @@ void JoyButton::setMouseRefreshRate(int refresh)
         if (staticMouseEventTimer.isActive())
         {
             testOldMouseTime.restart();
+            mouseTickPacer.wake();
 
             int tempInterval = staticMouseEventTimer.interval();
 
@@ -6109,6 +6375,7 @@ void JoyButton::resetProperties()
     whileHeldStatus = false;
     buttonName.clear();
     actionName.clear();
+    invalidateNameCache();
     cycleResetActive = false;
     cycleResetInterval = 0;
     relativeSpring = false;
@@ -6147,6 +6414,7 @@ void JoyButton::resetProperties()
 
     activeZoneStringLock.lockForWrite();
     activeZoneString = trUtf8("[NO KEY]");
+    activeZoneStringDirty = false;
     activeZoneStringLock.unlock();
 }
 
@@ -6440,7 +6708,8 @@ bool JoyButton::shouldInvokeMouseEvents()
 {
     bool result = false;
 
-    if ((pendingMouseButtons.size() > 0) && staticMouseEventTimer.isActive())
+    if (((pendingMouseButtons.size() > 0) || (pendingWheelButtons.size() > 0)) &&
+        staticMouseEventTimer.isActive())
     {
         int timerInterval = staticMouseEventTimer.interval();
         if (timerInterval == 0)
@@ -6461,6 +6730,295 @@ void JoyButton::invokeMouseEvents()
     mouseHelper.mouseEvent();
 }
 
+/**
+ * @brief Pick the mouse event timer interval for the next tick from the
+ *     output of the tick that just finished. The timer is stopped once
+ *     no mouse bound element is left and is started again when a mouse
+ *     slot is activated.
+ */
+void JoyButton::updateMouseTimerInterval()
+{
+    bool active = (pendingMouseButtons.length() > 0) || (pendingWheelButtons.length() > 0) ||
+                  hasCursorEvents() || hasSpringEvents();
+    int interval = mouseTickPacer.finishTick(active, mouseRefreshRate);
+
+    if (interval == MouseTickPacer::STOPPED)
+    {
+        staticMouseEventTimer.stop();
+        staticMouseEventTimer.setInterval(IDLEMOUSEREFRESHRATE);
+
+        // Clear current mouse history
+        mouseHistoryX.clear();
+        mouseHistoryY.clear();
+
+        // Fill history with zeroes.
+        for (int i=0; i < mouseHistorySize; i++)
+        {
+            mouseHistoryX.append(0);
+            mouseHistoryY.append(0);
+        }
+    }
+    else if (!staticMouseEventTimer.isActive() || (staticMouseEventTimer.interval() != interval))
+    {
+        staticMouseEventTimer.start(interval);
+    }
+}
+
+/**
+ * @brief Bring the shared mouse event timer back to the full refresh rate
+ *     after the deflection of a held button with pending mouse movement
+ *     changed. Without it a backed off timer adds up to
+ *     MouseTickPacer::MAXZEROINTERVAL of latency to the change.
+ */
+void JoyButton::wakeMouseEventTimer()
+{
+    PadderCommon::OutputStageLocker outputLocker;
+
+    if (pendingMouseButtons.contains(this))
+    {
+        mouseTickPacer.wake();
+
+        if (!staticMouseEventTimer.isActive() || (staticMouseEventTimer.interval() > mouseRefreshRate))
+        {
+            startStaticMouseEventTimer(mouseRefreshRate);
+        }
+    }
+}
+
+/**
+ * @brief Start the shared mouse event timer. Buttons of a device that is
+ *     processed on a worker thread have to ask the thread that owns the
+ *     timer to start it.
+ * @param Timer interval in milliseconds
+ */
+void JoyButton::startStaticMouseEventTimer(int interval)
+{
+    if (staticMouseEventTimer.thread() == QThread::currentThread())
+    {
+        staticMouseEventTimer.start(interval);
+    }
+    else
+    {
+        QMetaObject::invokeMethod(&staticMouseEventTimer, "start",
+                                  Q_ARG(int, interval));
+    }
+}
+
+void JoyButton::setHighResolutionWheel(bool enabled)
+{
+    highResolutionWheel = enabled;
+}
+
+bool JoyButton::isHighResolutionWheelActive()
+{
+    return highResolutionWheel && hasHighResolutionWheel();
+}
+
+/**
+ * @brief Send one full wheel notch for a newly activated wheel slot, queue
+ *     the button for smooth scrolling and make sure the shared mouse event
+ *     timer runs at the full refresh rate. The notch keeps short taps
+ *     visible to clients that only act on whole notches.
+ * @param Wheel slot code
+ */
+void JoyButton::startHighResolutionWheel(int code)
+{
+    int notch = BaseEventHandler::WHEELNOTCHUNITS;
+    if (code == static_cast<int>(JoyButtonSlot::MouseWheelUp))
+    {
+        sendWheelEvent(notch, 0);
+    }
+    else if (code == static_cast<int>(JoyButtonSlot::MouseWheelDown))
+    {
+        sendWheelEvent(-notch, 0);
+    }
+    else if (code == static_cast<int>(JoyButtonSlot::MouseWheelLeft))
+    {
+        sendWheelEvent(0, notch);
+    }
+    else if (code == static_cast<int>(JoyButtonSlot::MouseWheelRight))
+    {
+        sendWheelEvent(0, -notch);
+    }
+
+    mouseTickPacer.addWheelOutput();
+
+    if (!pendingWheelButtons.contains(this))
+    {
+        if (pendingWheelButtons.isEmpty())
+        {
+            highResolutionWheelTime.start();
+        }
+
+        pendingWheelButtons.append(this);
+    }
+
+    if (!staticMouseEventTimer.isActive() || (staticMouseEventTimer.interval() > mouseRefreshRate))
+    {
+        mouseTickPacer.wake();
+        startStaticMouseEventTimer(mouseRefreshRate);
+    }
+}
+
+/**
+ * @brief Take the button off the smooth scrolling list. The list is shared
+ *     with the mouse event timer so it is changed under the output stage
+ *     lock.
+ */
+void JoyButton::removePendingWheelButton()
+{
+    PadderCommon::OutputStageLocker outputLocker;
+    pendingWheelButtons.removeAll(this);
+}
+
+/**
+ * @brief Scale factor for the wheel speed of the button. Plain buttons
+ *     scroll at the full wheel speed.
+ */
+double JoyButton::getWheelSpeedScale()
+{
+    return 1.0;
+}
+
+/**
+ * @brief Add the wheel movement of the active wheel slots of the button
+ *     for the elapsed time. Wheel speed is in notches per second, scaled
+ *     by getWheelSpeedScale.
+ * @param Seconds since the previous wheel update
+ * @return Whether the button still has an active wheel slot
+ */
+bool JoyButton::addHighResolutionWheelUnits(double seconds)
+{
+    bool result = false;
+    double scale = getWheelSpeedScale();
+
+    QListIterator<JoyButtonSlot*> iter(getActiveSlots());
+    while (iter.hasNext())
+    {
+        JoyButtonSlot *slot = iter.next();
+        if (slot->getSlotMode() == JoyButtonSlot::JoyMouseButton)
+        {
+            int code = slot->getSlotCode();
+            double verticalUnits = BaseEventHandler::WHEELNOTCHUNITS * wheelSpeedY * scale * seconds;
+            double horizontalUnits = BaseEventHandler::WHEELNOTCHUNITS * wheelSpeedX * scale * seconds;
+
+            if (code == static_cast<int>(JoyButtonSlot::MouseWheelUp))
+            {
+                wheelUnitsVertical += verticalUnits;
+                result = true;
+            }
+            else if (code == static_cast<int>(JoyButtonSlot::MouseWheelDown))
+            {
+                wheelUnitsVertical -= verticalUnits;
+                result = true;
+            }
+            else if (code == static_cast<int>(JoyButtonSlot::MouseWheelLeft))
+            {
+                wheelUnitsHorizontal += horizontalUnits;
+                result = true;
+            }
+            else if (code == static_cast<int>(JoyButtonSlot::MouseWheelRight))
+            {
+                wheelUnitsHorizontal -= horizontalUnits;
+                result = true;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Send the wheel movement of all smooth scrolling buttons since
+ *     the previous mouse event. Fractions of a wheel unit are carried
+ *     over to the next event, also across separate scrolls.
+ */
+void JoyButton::moveHighResolutionWheel()
+{
+    if (!pendingWheelButtons.isEmpty())
+    {
+        double seconds = highResolutionWheelTime.nsecsElapsed() / 1000000000.0;
+        highResolutionWheelTime.restart();
+
+        QMutableListIterator<JoyButton*> iter(pendingWheelButtons);
+        while (iter.hasNext())
+        {
+            JoyButton *button = iter.next();
+            if (!button->addHighResolutionWheelUnits(seconds))
+            {
+                iter.remove();
+            }
+        }
+
+        int vertical = static_cast<int>(wheelUnitsVertical);
+        int horizontal = static_cast<int>(wheelUnitsHorizontal);
+        if ((vertical != 0) || (horizontal != 0))
+        {
+            wheelUnitsVertical -= vertical;
+            wheelUnitsHorizontal -= horizontal;
+            sendWheelEvent(vertical, horizontal);
+            mouseTickPacer.addWheelOutput();
+        }
+    }
+}
+
+MouseTickPacer::Stats JoyButton::getMouseTimerStats()
+{
+    return mouseTickPacer.getStats(mouseRefreshRate, IDLEMOUSEREFRESHRATE);
+}
+
+/**
+ * @brief Size the pressed key table for the active event backend.
+ *     Should be called before any button becomes active.
+ * @param Key code range of the backend
+ */
+void JoyButton::setPressedKeyCodeRange(int range)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    activeKeys.resize(range);
+}
+
+/**
+ * @brief Send a release for every key and mouse button that is still held
+ *     by any button and forget all reference counts.
+ */
+void JoyButton::releaseAllPressedKeys()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QList<int> pressedKeys = activeKeys.snapshot();
+    QListIterator<int> keyIter(pressedKeys);
+    while (keyIter.hasNext())
+    {
+        JoyButtonSlot tempSlot(keyIter.next(), JoyButtonSlot::JoyKeyboard);
+        sendevent(&tempSlot, false);
+    }
+
+    QList<int> pressedMouseButtons = activeMouseButtons.snapshot();
+    QListIterator<int> mouseIter(pressedMouseButtons);
+    while (mouseIter.hasNext())
+    {
+        JoyButtonSlot tempSlot(mouseIter.next(), JoyButtonSlot::JoyMouseButton);
+        sendevent(&tempSlot, false);
+    }
+
+    activeKeys.clear();
+    activeMouseButtons.clear();
+    lastActiveKey = nullptr;
+}
+
+/**
+ * @brief Get the native codes of all keys currently held by buttons.
+ * @return Pressed key codes
+ */
+QList<int> JoyButton::getPressedKeys()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return activeKeys.snapshot();
+}
+
 bool JoyButton::hasActiveSlots()
 {
     return !getActiveSlots().isEmpty();
@@ -6502,8 +7060,13 @@ void JoyButton::setUpdateInitAccel(bool state)
     this->updateInitAccelValues = state;
 }
 
+/**
+ * @brief Mutable access to the assigned slots. Cached slot strings are
+ *     invalidated since callers use it to modify the list.
+ */
 QList<JoyButtonSlot*>& JoyButton::getAssignmentsLocal() {
 
+    invalidateSlotStrings();
     return assignments;
 }
 
@@ -20,8 +20,13 @@
 
 
 #include "joybuttonslot.h"
+#include "joybuttonslotiterator.h"
 #include "springmousemoveinfo.h"
 #include "joybuttonmousehelper.h"
+#include "pressedkeystate.h"
+#include "mousetickpacer.h"
+#include "subpixelaccumulator.h"
+#include "profilefeatures.h"
 
 #ifdef Q_OS_WIN
   #include "joykeyrepeathelper.h"
@@ -36,6 +41,8 @@
 #include <QHash>
 #include <QQueue>
 #include <QReadWriteLock>
+#include <QMutex>
+#include <QAtomicInt>
 
 class VDPad;
 class SetJoystick;
@@ -96,6 +103,7 @@ public:
     bool containsSequence();
     bool containsDistanceSlots();
     bool containsReleaseSlots();
+    int getFeatureFlags();
     bool getIgnoreEventState();
     bool getWhileHeldStatus();
     bool hasActiveSlots();
@@ -179,6 +187,7 @@ public:
 
     TurboMode getTurboMode();
 
+    void invalidateMouseDistance();
 
     static int calculateFinalMouseSpeed(JoyMouseCurve curve, int value);
     static int getMouseHistorySize();
@@ -187,8 +196,6 @@ public:
     static int getGamepadRefreshRate();
 
     static double getWeightModifier();
-    static double cursorRemainderX;
-    static double cursorRemainderY;
 
     static bool hasCursorEvents();
     static bool hasSpringEvents();
@@ -206,6 +213,14 @@ public:
     static void setStaticMouseThread(QThread *thread);
     static void indirectStaticMouseThread(QThread *thread);
     static void invokeMouseEvents();
+    static void updateMouseTimerInterval();
+    static void moveHighResolutionWheel();
+    static void setHighResolutionWheel(bool enabled);
+    static bool isHighResolutionWheelActive();
+    static MouseTickPacer::Stats getMouseTimerStats();
+    static void setPressedKeyCodeRange(int range);
+    static void releaseAllPressedKeys();
+    static QList<int> getPressedKeys();
 
     static JoyButtonMouseHelper* getMouseHelper();
     static QList<JoyButton*>* getPendingMouseButtons();
@@ -284,10 +299,26 @@ protected:
     void checkTurboCondition(JoyButtonSlot *slot);
     void vdpadPassEvent(bool pressed, bool ignoresets=false);
     void localBuildActiveZoneSummaryString();
+    void scheduleActiveZoneSummaryUpdate();
+    bool isActiveZoneObserved();
+
+    static void startStaticMouseEventTimer(int interval);
+    void wakeMouseEventTimer();
+    void startHighResolutionWheel(int code);
+    void removePendingWheelButton();
+    bool addHighResolutionWheelUnits(double seconds);
+    void invalidateSlotStrings();
+    void invalidateNameCache();
+    void updateSlotRecordsLocked();
+    void appendActiveSlot(const JoyButtonSlotIterator::Record &record);
+    double getSampledMouseDistance();
+    double getCurvedMouseDistance(JoyButtonSlot *buttonslot);
+    double applyMouseCurve(JoyMouseCurve currentCurve, double difference, JoyButtonSlot *buttonslot);
 
     static bool hasFutureSpringEvents();
 
     virtual double getCurrentSpringDeadCircle();
+    virtual double getWheelSpeedScale();
 
     virtual bool readButtonConfig(QXmlStreamReader *xml);
 
@@ -309,9 +340,12 @@ protected:
     static QList<PadderCommon::springModeInfo> springXSpeeds;
     static QList<PadderCommon::springModeInfo> springYSpeeds;
     static QList<JoyButton*> pendingMouseButtons;
+    static QList<JoyButton*> pendingWheelButtons;
+    static SubPixelAccumulator cursorAccumulatorX;
+    static SubPixelAccumulator cursorAccumulatorY;
 
-    static QHash<int, int> activeKeys; // QHash<unsigned int, int
-    static QHash<int, int> activeMouseButtons; // QHash<unsigned int, int
+    static PressedKeyState activeKeys;
+    static PressedKeyState activeMouseButtons;
 
 #ifdef Q_OS_WIN
     static JoyKeyRepeatHelper repeatHelper;
@@ -324,6 +358,10 @@ protected:
     static int mouseRefreshRate;
     static int springModeScreen;
     static int gamepadRefreshRate;
+    static bool highResolutionWheel;
+    static double wheelUnitsVertical;
+    static double wheelUnitsHorizontal;
+    static QElapsedTimer highResolutionWheelTime;
 
     int index; // Used to denote the SDL index of the actual joypad button
     int turboInterval;
@@ -402,6 +440,7 @@ public slots:
     virtual void resetProperties();
     virtual void clearSlotsEventReset(bool clearSignalEmit=true);
     virtual void eventReset();
+    void detachReset();
     virtual void mouseEvent();
 
     static void establishMouseTimerConnections();
@@ -441,8 +480,10 @@ private slots:
     void checkForSetChange();
     void keyPressEvent();
     void slotSetChange();
+    void refreshActiveZoneSummary();
 
 private:
+    void finishPauseWait();
     QList<JoyButtonSlot*>& getAssignmentsLocal();
     QList<JoyButtonSlot*>& getActiveSlotsLocal();
 
@@ -501,6 +542,7 @@ private:
     QTimer slotSetChangeTimer;
     QTimer activeZoneTimer;
     static QTimer staticMouseEventTimer;
+    static MouseTickPacer mouseTickPacer;
 
     QString customName;
     QString actionName;
@@ -508,7 +550,15 @@ private:
 
     QList<JoyButtonSlot*> assignments;
     QList<JoyButtonSlot*> activeSlots;
-    QListIterator<JoyButtonSlot*> *slotiter;
+
+    // Runtime records of assignments, rebuilt while assignmentsLock is
+    // held for writing, and of activeSlots in the same order.
+    JoyButtonSlotIterator::Records slotRecords;
+    JoyButtonSlotIterator::Records activeSlotRecords;
+
+    // Points to sequenceIterator while a sequence runs, else nullptr.
+    JoyButtonSlotIterator sequenceIterator;
+    JoyButtonSlotIterator *slotiter;
     QQueue<JoyButtonSlot*> mouseEventQueue;
     JoyButtonSlot *currentPause;
     JoyButtonSlot *currentHold;
@@ -540,6 +590,34 @@ private:
     QReadWriteLock assignmentsLock;
     QReadWriteLock activeZoneStringLock;
 
+    // Active zone string is only rebuilt when something displays it.
+    bool activeZoneStringDirty;
+    QAtomicInt activeZoneRefreshQueued;
+
+    // Summary strings cached until the assigned slots change.
+    QMutex slotStringsLock;
+    bool slotsSummaryValid;
+    bool slotsStringValid;
+    QString slotsSummaryCache;
+    QString slotsStringCache;
+
+    // ProfileFeatures flags of the assigned slots. Updated together
+    // with slotRecords.
+    QAtomicInt slotFeatureFlags;
+
+    // Partial names indexed by forceFullFormat and displayNames.
+    mutable QMutex nameCacheLock;
+    mutable int nameCacheValidMask;
+    mutable QString partialNameCache[4];
+
+    // Mouse distance of the last input sample. mouseSampleSerial is
+    // bumped by the input side and compared on the next mouse tick.
+    QAtomicInt mouseSampleSerial;
+    int mouseDistanceSerial;
+    double sampledMouseDistance;
+    double curvedMouseDistance;
+    bool curvedMouseDistanceValid;
+
 };
 
 
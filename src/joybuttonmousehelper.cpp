@@ -18,6 +18,7 @@
 #include "joybuttonmousehelper.h"
 
 #include "messagehandler.h"
+#include "common.h"
 #include "joybutton.h"
 
 #include <QDebug>
@@ -73,6 +74,8 @@ void JoyButtonMouseHelper::mouseEvent()
 {
    // qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    PadderCommon::OutputStageLocker outputLocker;
+
     if (!JoyButton::hasCursorEvents() && !JoyButton::hasSpringEvents())
     {
         QList<JoyButton*> *buttonList = JoyButton::getPendingMouseButtons();
@@ -91,7 +94,10 @@ void JoyButtonMouseHelper::mouseEvent()
         moveSpringMouse();
     }
 
+    JoyButton::moveHighResolutionWheel();
+
     JoyButton::restartLastMouseTime();
+    JoyButton::updateMouseTimerInterval();
     firstSpringEvent = false;
 }
 
@@ -99,6 +105,8 @@ void JoyButtonMouseHelper::resetButtonMouseDistances()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    PadderCommon::OutputStageLocker outputLocker;
+
     QList<JoyButton*> *buttonList = JoyButton::getPendingMouseButtons();
     QListIterator<JoyButton*> iter(*buttonList);
     while (iter.hasNext())
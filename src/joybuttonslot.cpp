@@ -21,6 +21,9 @@
 #include "inputdevice.h"
 #include "antkeymapper.h"
 #include "event.h"
+#include "common.h"
+#include "eventhandlerfactory.h"
+#include "eventhandlers/baseeventhandler.h"
 
 #include <QDebug>
 #include <QFileInfo>
@@ -43,6 +46,7 @@ JoyButtonSlot::JoyButtonSlot(QObject *parent) :
     previousDistance = 0.0;
     qkeyaliasCode = 0;
     easingActive = false;
+    textEntryProgramValid = false;
 }
 
 JoyButtonSlot::JoyButtonSlot(int code, JoySlotInputAction mode, QObject *parent) :
@@ -62,6 +66,7 @@ JoyButtonSlot::JoyButtonSlot(int code, JoySlotInputAction mode, QObject *parent)
     this->mode = mode;
     distance = 0.0;
     easingActive = false;
+    textEntryProgramValid = false;
 }
 
 JoyButtonSlot::JoyButtonSlot(int code, int alias, JoySlotInputAction mode, QObject *parent) :
@@ -86,6 +91,7 @@ JoyButtonSlot::JoyButtonSlot(int code, int alias, JoySlotInputAction mode, QObje
     this->mode = mode;
     distance = 0.0;
     easingActive = false;
+    textEntryProgramValid = false;
 }
 
 JoyButtonSlot::JoyButtonSlot(JoyButtonSlot *slot, QObject *parent) :
@@ -100,7 +106,9 @@ JoyButtonSlot::JoyButtonSlot(JoyButtonSlot *slot, QObject *parent) :
     distance = slot->distance;
     easingActive = false;
     textData = slot->getTextData();
-    extraData = slot->getExtraData();
+    setExtraData(slot->getExtraData());
+    textEntryProgram = slot->textEntryProgram;
+    textEntryProgramValid = slot->textEntryProgramValid;
 }
 
 JoyButtonSlot::JoyButtonSlot(QString text, JoySlotInputAction mode, QObject *parent) :
@@ -114,11 +122,12 @@ JoyButtonSlot::JoyButtonSlot(QString text, JoySlotInputAction mode, QObject *par
     this->mode = mode;
     distance = 0.0;
     easingActive = false;
+    textEntryProgramValid = false;
     if ((mode == JoyLoadProfile) ||
         (mode == JoyTextEntry) ||
         (mode == JoyExecute))
     {
-        textData = text;
+        setTextData(text);
     }
 }
 
@@ -168,6 +177,7 @@ void JoyButtonSlot::setSlotMode(JoySlotInputAction selectedMode)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     mode = selectedMode;
+    textEntryProgramValid = false;
 }
 
 JoyButtonSlot::JoySlotInputAction JoyButtonSlot::getSlotMode()
@@ -791,6 +801,12 @@ void JoyButtonSlot::setTextData(QString textData)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     this->textData = textData;
+    textEntryProgramValid = false;
+
+    if (mode == JoyTextEntry)
+    {
+        compileTextEntryProgram();
+    }
 }
 
 QString JoyButtonSlot::getTextData()
@@ -805,6 +821,45 @@ void JoyButtonSlot::setExtraData(QVariant data)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     this->extraData = data;
+
+    // Parse execute arguments once here instead of on every button press.
+    argumentsList.clear();
+    if (extraData.canConvert<QString>())
+    {
+        argumentsList = PadderCommon::parseArgumentsString(extraData.toString());
+    }
+}
+
+/**
+ * @brief Get the keystroke program of a text entry slot. The program is
+ *     compiled when the text is assigned and rebuilt here only if the
+ *     slot changed since then.
+ * @return Compiled keystroke program
+ */
+const KeystrokeProgram::Steps& JoyButtonSlot::getTextEntryProgram()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (!textEntryProgramValid)
+    {
+        compileTextEntryProgram();
+    }
+
+    return textEntryProgram;
+}
+
+void JoyButtonSlot::compileTextEntryProgram()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    textEntryProgram.clear();
+
+    if ((mode == JoyTextEntry) && !textData.isEmpty())
+    {
+        textEntryProgram = EventHandlerFactory::getInstance()->handler()->compileTextEntry(textData);
+    }
+
+    textEntryProgramValid = true;
 }
 
 QVariant JoyButtonSlot::getExtraData()
@@ -814,6 +869,18 @@ QVariant JoyButtonSlot::getExtraData()
     return extraData;
 }
 
+/**
+ * @brief Get the argument list of an execute slot as parsed when the
+ *     extra data was assigned.
+ * @return Parsed argument list
+ */
+const QStringList& JoyButtonSlot::getArgumentsList()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return argumentsList;
+}
+
 bool JoyButtonSlot::isValidSlot()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
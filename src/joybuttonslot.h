@@ -18,11 +18,14 @@
 #ifndef JOYBUTTONSLOT_H
 #define JOYBUTTONSLOT_H
 
+#include "keystrokeprogram.h"
+
 #include <QObject>
 #include <QElapsedTimer>
 #include <QTime>
 #include <QMetaType>
 #include <QVariant>
+#include <QStringList>
 
 class QXmlStreamReader;
 class QXmlStreamWriter;
@@ -72,9 +75,11 @@ public:
 
     void setTextData(QString textData);
     QString getTextData();
+    const KeystrokeProgram::Steps& getTextEntryProgram();
 
     void setExtraData(QVariant data);
     QVariant getExtraData();
+    const QStringList& getArgumentsList();
 
     bool isValidSlot();
 
@@ -95,8 +100,13 @@ private:
     bool easingActive;
     QString textData;
     QVariant extraData;
+    QStringList argumentsList;
+    KeystrokeProgram::Steps textEntryProgram;
+    bool textEntryProgramValid;
 
     static const int MAXTEXTENTRYDISPLAYLENGTH;
+
+    void compileTextEntryProgram();
     
 };
 
@@ -0,0 +1,98 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "joybuttonslotiterator.h"
+
+#include "joybuttonslot.h"
+
+
+JoyButtonSlotIterator::JoyButtonSlotIterator()
+{
+    position = 0;
+}
+
+/**
+ * @brief Start at the front of the records. The array is implicitly
+ *     shared with the button, not copied.
+ * @param Records of the assigned slots
+ */
+JoyButtonSlotIterator::JoyButtonSlotIterator(const Records &records) :
+    records(records)
+{
+    position = 0;
+}
+
+/**
+ * @brief Advance until the given slot has been passed.
+ * @param Slot to look for
+ * @return Whether the slot was found
+ */
+bool JoyButtonSlotIterator::findNext(JoyButtonSlot *slot)
+{
+    while (hasNext())
+    {
+        if (next() == slot)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Drop the reference to the records.
+ */
+void JoyButtonSlotIterator::clear()
+{
+    records = Records();
+    position = 0;
+}
+
+/**
+ * @brief Build the record of one slot. Modifier keys are looked up here
+ *     so the activation loop does not query the key mapper.
+ */
+JoyButtonSlotIterator::Record JoyButtonSlotIterator::createRecord(JoyButtonSlot *slot)
+{
+    Record record;
+    record.slot = slot;
+    record.code = slot->getSlotCode();
+    record.alias = slot->getSlotCodeAlias();
+    record.mode = static_cast<quint8>(slot->getSlotMode());
+    record.flags = slot->isModifierKey() ? ModifierKeyFlag : 0;
+
+    return record;
+}
+
+/**
+ * @brief Build the records of all assigned slots in one array.
+ * @param Slots assigned to a button
+ */
+JoyButtonSlotIterator::Records JoyButtonSlotIterator::createRecords(const QList<JoyButtonSlot*> &assignments)
+{
+    Records result;
+    result.reserve(assignments.size());
+
+    QListIterator<JoyButtonSlot*> iter(assignments);
+    while (iter.hasNext())
+    {
+        result.append(createRecord(iter.next()));
+    }
+
+    return result;
+}
@@ -0,0 +1,106 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOYBUTTONSLOTITERATOR_H
+#define JOYBUTTONSLOTITERATOR_H
+
+#include <QtGlobal>
+#include <QList>
+#include <QVector>
+
+class JoyButtonSlot;
+
+/**
+ * @brief Java style iterator over the runtime records of the slots
+ *     assigned to a button. It has the same interface as QListIterator.
+ *     Buttons keep the records in one contiguous array that is rebuilt
+ *     when the assignments change. The iterator shares that array, so
+ *     starting a sequence does not allocate and an edit made while a
+ *     sequence runs does not change the records it walks.
+ */
+class JoyButtonSlotIterator
+{
+public:
+    enum RecordFlags {ModifierKeyFlag=0x01};
+
+    /**
+     * @brief Runtime view of one assigned slot. It does not replace the
+     *     slot object. The mouse interval, distance and easing state stay
+     *     in the slot, which is also used for output and for the active
+     *     slot lists. The records add their size per slot on top.
+     */
+    struct Record
+    {
+        JoyButtonSlot *slot;
+        qint32 code;
+        qint32 alias;
+        quint8 mode;
+        quint8 flags;
+    };
+
+    typedef QVector<Record> Records;
+
+    JoyButtonSlotIterator();
+    explicit JoyButtonSlotIterator(const Records &records);
+
+    inline bool hasNext() const
+    {
+        return position < records.size();
+    }
+
+    inline bool hasPrevious() const
+    {
+        return position > 0;
+    }
+
+    inline JoyButtonSlot* next()
+    {
+        return records.at(position++).slot;
+    }
+
+    inline JoyButtonSlot* previous()
+    {
+        return records.at(--position).slot;
+    }
+
+    inline const Record& nextRecord()
+    {
+        return records.at(position++);
+    }
+
+    inline void toFront()
+    {
+        position = 0;
+    }
+
+    inline void toBack()
+    {
+        position = records.size();
+    }
+
+    bool findNext(JoyButtonSlot *slot);
+    void clear();
+
+    static Record createRecord(JoyButtonSlot *slot);
+    static Records createRecords(const QList<JoyButtonSlot*> &assignments);
+
+private:
+    Records records;
+    int position;
+};
+
+#endif // JOYBUTTONSLOTITERATOR_H
@@ -269,7 +269,6 @@ QString JoyControlStickButton::getCalculatedActiveZoneSummary()
 
     JoyControlStickModifierButton *tempButton = stick->getModifierButton();
     QString temp = QString();
-    QStringList stringlist = QStringList();
 
     if ((tempButton != nullptr) && tempButton->getButtonState() &&
         tempButton->hasActiveSlots() && getButtonState())
@@ -278,11 +277,14 @@ QString JoyControlStickButton::getCalculatedActiveZoneSummary()
         qDebug() << "Calculated Active Zone Summary: " << tempButton->getCalculatedActiveZoneSummary();
         #endif
 
-        stringlist.append(tempButton->getCalculatedActiveZoneSummary());
+        temp = tempButton->getCalculatedActiveZoneSummary();
+        temp.append(", ").append(JoyButton::getCalculatedActiveZoneSummary());
+    }
+    else
+    {
+        // Shares the cached string of the button without copying.
+        temp = JoyButton::getCalculatedActiveZoneSummary();
     }
-
-    stringlist.append(JoyButton::getCalculatedActiveZoneSummary());
-    temp = stringlist.join(", ");
 
     #ifndef QT_DEBUG_NO_OUTPUT
     qDebug() << "Returned joined zone: " << temp;
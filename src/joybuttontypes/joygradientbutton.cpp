@@ -18,6 +18,7 @@
 #include "joygradientbutton.h"
 
 #include "messagehandler.h"
+#include "common.h"
 #include "setjoystick.h"
 #include "event.h"
 
@@ -244,6 +245,8 @@ void JoyGradientButton::wheelEventVertical()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    PadderCommon::OutputStageLocker outputLocker;
+
     JoyButtonSlot *buttonslot = nullptr;
     bool activateEvent = false;
 
@@ -398,6 +401,8 @@ void JoyGradientButton::wheelEventHorizontal()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    PadderCommon::OutputStageLocker outputLocker;
+
     JoyButtonSlot *buttonslot = nullptr;
     bool activateEvent = false;
 
@@ -545,3 +550,12 @@ void JoyGradientButton::wheelEventHorizontal()
         lastWheelHorizontalDistance = getMouseDistanceFromDeadZone();
     }
 }
+
+/**
+ * @brief Smooth scrolling follows the deflection of the control, matching
+ *     the notch interval used by wheelEventVertical and wheelEventHorizontal.
+ */
+double JoyGradientButton::getWheelSpeedScale()
+{
+    return getMouseDistanceFromDeadZone();
+}
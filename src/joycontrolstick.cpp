@@ -22,10 +22,12 @@
 #include "joybuttontypes/joycontrolstickbutton.h"
 #include "joybuttontypes/joycontrolstickmodifierbutton.h"
 #include "joyaxis.h"
+#include "calibrationstatistics.h"
 
 #include <cmath>
 
 #include <QDebug>
+#include <QThread>
 #include <QHashIterator>
 #include <QStringList>
 #include <QXmlStreamReader>
@@ -43,6 +45,24 @@ const JoyControlStick::JoyMode JoyControlStick::DEFAULTMODE = JoyControlStick::S
 const double JoyControlStick::DEFAULTCIRCLE = 0.0;
 const int JoyControlStick::DEFAULTSTICKDELAY = 0;
 
+// Bearings are quantized to half degrees. Zone boundaries always fall on
+// that grid, so even entries hold the direction exactly at a boundary and
+// odd entries hold the direction inside the following half degree.
+static const int BEARINGTABLESIZE = (360 * 4) + 2;
+
+static inline int bearingTableIndex(double bearing)
+{
+    double scaled = bearing * 2.0;
+    int whole = static_cast<int>(scaled);
+    int index = (whole * 2) + ((scaled > whole) ? 1 : 0);
+    return qBound(0, index, BEARINGTABLESIZE - 1);
+}
+
+static inline double bearingForTableIndex(int index)
+{
+    return ((index / 2) * 0.5) + (((index % 2) != 0) ? 0.25 : 0.0);
+}
+
 
 JoyControlStick::JoyControlStick(JoyAxis *axis1, JoyAxis *axis2,
                                  int index, int originset, QObject *parent) :
@@ -490,6 +510,8 @@ double JoyControlStick::getDistanceFromDeadZone(int axisXValue, int axisYValue)
     double adjustedDist = (circleStickFull > 1.0) ? (dist / circleStickFull) : dist;
     double adjustedDeadZone = (circleStickFull > 1.0) ? (deadZone / circleStickFull) : deadZone;
 
+    adjustedDist *= getOuterCorrection(angle2);
+
     distance = (adjustedDist - adjustedDeadZone)/static_cast<double>(maxZone - adjustedDeadZone);
     distance = qBound(0.0, distance, 1.0);
     return distance;
@@ -538,6 +560,7 @@ double JoyControlStick::calculateYDistanceFromDeadZone(int axisXValue,
     double circleStickFull = (squareStickFullPhi - 1) * circle + 1;
 
     double adjustedAxis2Value = (circleStickFull > 1.0) ? (axis2Value / circleStickFull) : axis2Value;
+    adjustedAxis2Value *= getOuterCorrection(angle2);
     double adjustedDeadYZone = (circleStickFull > 1.0) ? (deadY / circleStickFull) : deadY;
 
     // Interpolation would return the correct value if diagonalRange is 90 but
@@ -685,6 +708,7 @@ double JoyControlStick::calculateXDistanceFromDeadZone(int axisXValue,
     double circleStickFull = (squareStickFullPhi - 1) * circle + 1;
 
     double adjustedAxis1Value = (circleStickFull > 1.0) ? (axis1Value / circleStickFull) : axis1Value;
+    adjustedAxis1Value *= getOuterCorrection(angle2);
     double adjustedDeadXZone = (circleStickFull > 1.0) ? (deadX / circleStickFull) : deadX;
 
     // Interpolation would return the correct value if diagonalRange is 90 but
@@ -1038,9 +1062,29 @@ void JoyControlStick::reset()
     stickName.clear();
     circle = DEFAULTCIRCLE;
     stickDelay = DEFAULTSTICKDELAY;
+    outerCorrection.clear();
+    rebuildDirectionTables();
     resetButtons();
 }
 
+/**
+ * @brief Buttons keep the mouse distance of the last sample. Make them
+ *     pick up a zone or correction change while the stick is held still.
+ */
+void JoyControlStick::invalidateButtonMouseDistances()
+{
+    QHashIterator<JoyStickDirections, JoyControlStickButton*> iter(buttons);
+    while (iter.hasNext())
+    {
+        iter.next().value()->invalidateMouseDistance();
+    }
+
+    if (modifierButton != nullptr)
+    {
+        modifierButton->invalidateMouseDistance();
+    }
+}
+
 void JoyControlStick::setDeadZone(int value)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -1054,6 +1098,7 @@ void JoyControlStick::setDeadZone(int value)
     if ((value != deadZone) && (value <= maxZone))
     {
         deadZone = value;
+        invalidateButtonMouseDistances();
         emit deadZoneChanged(value);
         emit propertyUpdated();
     }
@@ -1072,6 +1117,7 @@ void JoyControlStick::setMaxZone(int value)
     if ((value != maxZone) && (value > deadZone))
     {
         maxZone = value;
+        invalidateButtonMouseDistances();
         emit maxZoneChanged(value);
         emit propertyUpdated();
     }
@@ -1099,6 +1145,43 @@ void JoyControlStick::setCalibrationSummary(QString text)
     calibrationSummary = text;
 }
 
+/**
+ * @brief Set the outer circle correction table produced by calibration.
+ * @param Table of CalibrationStatistics::ANGLEBINS radial scale factors.
+ *     An empty table disables the correction.
+ */
+void JoyControlStick::setOuterCorrectionTable(const QVector<double> &table)
+{
+    if (table.isEmpty() || (table.size() == CalibrationStatistics::ANGLEBINS))
+    {
+        outerCorrection = table;
+        invalidateButtonMouseDistances();
+    }
+}
+
+const QVector<double>& JoyControlStick::getOuterCorrectionTable()
+{
+    return outerCorrection;
+}
+
+/**
+ * @brief Radial scale factor of the outer correction table. Stretches
+ *     the calibrated outer circle so every direction can reach the max
+ *     zone.
+ * @param Stick angle as returned by atan2(x, -y)
+ * @return Scale factor or 1.0 when the stick has no correction table.
+ */
+double JoyControlStick::getOuterCorrection(double angle)
+{
+    double result = 1.0;
+    if (!outerCorrection.isEmpty())
+    {
+        result = outerCorrection.at(CalibrationStatistics::angleBin(angle));
+    }
+
+    return result;
+}
+
 /**
  * @brief Set the diagonal range value for a stick.
  * @param Value between 1 - 90.
@@ -1119,6 +1202,8 @@ void JoyControlStick::setDiagonalRange(int value)
     if (value != diagonalRange)
     {
         diagonalRange = value;
+        rebuildDirectionTables();
+        invalidateButtonMouseDistances();
         emit diagonalRangeChanged(value);
         emit propertyUpdated();
     }
@@ -1201,6 +1286,24 @@ void JoyControlStick::readConfig(QXmlStreamReader *xml)
                 QString temptext = xml->readElementText();
                 this->setCalibrationSummary(temptext);
             }
+            else if ((xml->name() == "outerCorrection") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                QStringList tempvalues = temptext.split(',', QString::SkipEmptyParts);
+                QVector<double> temptable;
+                bool validTable = true;
+
+                for (int i = 0; (i < tempvalues.size()) && validTable; i++)
+                {
+                    double tempfactor = tempvalues.at(i).toDouble(&validTable);
+                    temptable.append(tempfactor);
+                }
+
+                if (validTable)
+                {
+                    this->setOuterCorrectionTable(temptable);
+                }
+            }
             else if ((xml->name() == "diagonalRange") && xml->isStartElement())
             {
                 QString temptext = xml->readElementText();
@@ -1295,6 +1398,17 @@ void JoyControlStick::writeConfig(QXmlStreamWriter *xml)
         xml->writeTextElement("calibrated", (calibrated ? "true" : "false"));
         xml->writeTextElement("summary", (getCalibrationSummary().isEmpty() ? "" : calibrationSummary));
 
+        if (!outerCorrection.isEmpty())
+        {
+            QStringList tempvalues;
+            for (int i = 0; i < outerCorrection.size(); i++)
+            {
+                tempvalues.append(QString::number(outerCorrection.at(i), 'f', 4));
+            }
+
+            xml->writeTextElement("outerCorrection", tempvalues.join(','));
+        }
+
 
         if ((currentMode == StandardMode) || (currentMode == EightWayMode))
         {
@@ -2143,6 +2257,7 @@ void JoyControlStick::setJoyMode(JoyMode mode)
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     currentMode = mode;
+    rebuildDirectionTables();
     emit joyModeChanged();
     emit propertyUpdated();
 }
@@ -2177,6 +2292,7 @@ bool JoyControlStick::isDefault()
     value = value && (currentMode == DEFAULTMODE);
     value = value && (qFuzzyCompare(circle, DEFAULTCIRCLE));
     value = value && (stickDelay == DEFAULTSTICKDELAY);
+    value = value && outerCorrection.isEmpty();
 
     QHashIterator<JoyStickDirections, JoyControlStickButton*> iter(buttons);
     while (iter.hasNext())
@@ -2593,58 +2709,47 @@ void JoyControlStick::determineStandardModeEvent(JoyControlStickButton *&eventbu
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    double bearing = calculateBearing();
+    JoyStickDirections direction = lookupEventDirection(calculateBearing());
 
-    QList<double> anglesList = getDiagonalZoneAngles();
-    double initialLeft = anglesList.value(0);
-    double initialRight = anglesList.value(1);
-    double upRightInitial = anglesList.value(2);
-    double rightInitial = anglesList.value(3);
-    double downRightInitial = anglesList.value(4);
-    double downInitial = anglesList.value(5);
-    double downLeftInitial = anglesList.value(6);
-    double leftInitial = anglesList.value(7);
-    double upLeftInitial = anglesList.value(8);
-
-    if ((bearing <= initialRight) || (bearing >= initialLeft))
+    if (direction == StickUp)
     {
         currentDirection = StickUp;
         eventbutton2 = buttons.value(StickUp);
     }
-    else if ((bearing >= upRightInitial) && (bearing < rightInitial))
+    else if (direction == StickRightUp)
     {
         currentDirection = StickRightUp;
         eventbutton1 = buttons.value(StickRight);
         eventbutton2 = buttons.value(StickUp);
     }
-    else if ((bearing >= rightInitial) && (bearing < downRightInitial))
+    else if (direction == StickRight)
     {
         currentDirection = StickRight;
         eventbutton1 = buttons.value(StickRight);
     }
-    else if ((bearing >= downRightInitial) && (bearing < downInitial))
+    else if (direction == StickRightDown)
     {
         currentDirection = StickRightDown;
         eventbutton1 = buttons.value(StickRight);
         eventbutton2 = buttons.value(StickDown);
     }
-    else if ((bearing >= downInitial) && (bearing < downLeftInitial))
+    else if (direction == StickDown)
     {
         currentDirection = StickDown;
         eventbutton2 = buttons.value(StickDown);
     }
-    else if ((bearing >= downLeftInitial) && (bearing < leftInitial))
+    else if (direction == StickLeftDown)
     {
         currentDirection = StickLeftDown;
         eventbutton1 = buttons.value(StickLeft);
         eventbutton2 = buttons.value(StickDown);
     }
-    else if ((bearing >= leftInitial) && (bearing < upLeftInitial))
+    else if (direction == StickLeft)
     {
         currentDirection = StickLeft;
         eventbutton1 = buttons.value(StickLeft);
     }
-    else if ((bearing >= upLeftInitial) && (bearing < initialLeft))
+    else if (direction == StickLeftUp)
     {
         currentDirection = StickLeftUp;
         eventbutton1 = buttons.value(StickLeft);
@@ -2663,55 +2768,44 @@ void JoyControlStick::determineEightWayModeEvent(JoyControlStickButton *&eventbu
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    double bearing = calculateBearing();
-
-    QList<double> anglesList = getDiagonalZoneAngles();
-    double initialLeft = anglesList.value(0);
-    double initialRight = anglesList.value(1);
-    double upRightInitial = anglesList.value(2);
-    double rightInitial = anglesList.value(3);
-    double downRightInitial = anglesList.value(4);
-    double downInitial = anglesList.value(5);
-    double downLeftInitial = anglesList.value(6);
-    double leftInitial = anglesList.value(7);
-    double upLeftInitial = anglesList.value(8);
+    JoyStickDirections direction = lookupEventDirection(calculateBearing());
 
-    if ((bearing <= initialRight) || (bearing >= initialLeft))
+    if (direction == StickUp)
     {
         currentDirection = StickUp;
         eventbutton2 = buttons.value(StickUp);
     }
-    else if ((bearing >= upRightInitial) && (bearing < rightInitial))
+    else if (direction == StickRightUp)
     {
         currentDirection = StickRightUp;
         eventbutton3 = buttons.value(StickRightUp);
     }
-    else if ((bearing >= rightInitial) && (bearing < downRightInitial))
+    else if (direction == StickRight)
     {
         currentDirection = StickRight;
         eventbutton1 = buttons.value(StickRight);
     }
-    else if ((bearing >= downRightInitial) && (bearing < downInitial))
+    else if (direction == StickRightDown)
     {
         currentDirection = StickRightDown;
         eventbutton3 = buttons.value(StickRightDown);
     }
-    else if ((bearing >= downInitial) && (bearing < downLeftInitial))
+    else if (direction == StickDown)
     {
         currentDirection = StickDown;
         eventbutton2 = buttons.value(StickDown);
     }
-    else if ((bearing >= downLeftInitial) && (bearing < leftInitial))
+    else if (direction == StickLeftDown)
     {
         currentDirection = StickLeftDown;
         eventbutton3 = buttons.value(StickLeftDown);
     }
-    else if ((bearing >= leftInitial) && (bearing < upLeftInitial))
+    else if (direction == StickLeft)
     {
         currentDirection = StickLeft;
         eventbutton1 = buttons.value(StickLeft);
     }
-    else if ((bearing >= upLeftInitial) && (bearing < initialLeft))
+    else if (direction == StickLeftUp)
     {
         currentDirection = StickLeftUp;
         eventbutton3 = buttons.value(StickLeftUp);
@@ -2728,30 +2822,24 @@ void JoyControlStick::determineFourWayCardinalEvent(JoyControlStickButton *&even
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    double bearing = calculateBearing();
+    JoyStickDirections direction = lookupEventDirection(calculateBearing());
 
-    QList<int> anglesList = getFourWayCardinalZoneAngles();
-    int rightInitial = anglesList.value(0);
-    int downInitial = anglesList.value(1);
-    int leftInitial = anglesList.value(2);
-    int upInitial = anglesList.value(3);
-
-    if ((bearing < rightInitial) || (bearing >= upInitial))
+    if (direction == StickUp)
     {
         currentDirection = StickUp;
         eventbutton2 = buttons.value(StickUp);
     }
-    else if ((bearing >= rightInitial) && (bearing < downInitial))
+    else if (direction == StickRight)
     {
         currentDirection = StickRight;
         eventbutton1 = buttons.value(StickRight);
     }
-    else if ((bearing >= downInitial) && (bearing < leftInitial))
+    else if (direction == StickDown)
     {
         currentDirection = StickDown;
         eventbutton2 = buttons.value(StickDown);
     }
-    else if ((bearing >= leftInitial) && (bearing < upInitial))
+    else if (direction == StickLeft)
     {
         currentDirection = StickLeft;
         eventbutton1 = buttons.value(StickLeft);
@@ -2767,30 +2855,24 @@ void JoyControlStick::determineFourWayDiagonalEvent(JoyControlStickButton *&even
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    double bearing = calculateBearing();
-
-    QList<int> anglesList = getFourWayDiagonalZoneAngles();
-    int upRightInitial = anglesList.value(0);
-    int downRightInitial = anglesList.value(1);
-    int downLeftInitial = anglesList.value(2);
-    int upLeftInitial = anglesList.value(3);
+    JoyStickDirections direction = lookupEventDirection(calculateBearing());
 
-    if ((bearing >= upRightInitial) && (bearing < downRightInitial))
+    if (direction == StickRightUp)
     {
         currentDirection = StickRightUp;
         eventbutton3 = buttons.value(StickRightUp);
     }
-    else if ((bearing >= downRightInitial) && (bearing < downLeftInitial))
+    else if (direction == StickRightDown)
     {
         currentDirection = StickRightDown;
         eventbutton3 = buttons.value(StickRightDown);
     }
-    else if ((bearing >= downLeftInitial) && (bearing < upLeftInitial))
+    else if (direction == StickLeftDown)
     {
         currentDirection = StickLeftDown;
         eventbutton3 = buttons.value(StickLeftDown);
     }
-    else if (bearing >= upLeftInitial)
+    else if (direction == StickLeftUp)
     {
         currentDirection = StickLeftUp;
         eventbutton3 = buttons.value(StickLeftUp);
@@ -2814,55 +2896,7 @@ JoyControlStick::determineStandardModeDirection(int axisXValue, int axisYValue)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    JoyStickDirections result = StickCentered;
-
-    double bearing = calculateBearing(axisXValue, axisYValue);
-
-    QList<double> anglesList = getDiagonalZoneAngles();
-    int initialLeft = static_cast<int>(anglesList.value(0));
-    int initialRight = static_cast<int>(anglesList.value(1));
-    int upRightInitial = static_cast<int>(anglesList.value(2));
-    int rightInitial = static_cast<int>(anglesList.value(3));
-    int downRightInitial = static_cast<int>(anglesList.value(4));
-    int downInitial = static_cast<int>(anglesList.value(5));
-    int downLeftInitial = static_cast<int>(anglesList.value(6));
-    int leftInitial = static_cast<int>(anglesList.value(7));
-    int upLeftInitial = static_cast<int>(anglesList.value(8));
-
-    if ((bearing <= initialRight) || (bearing >= initialLeft))
-    {
-        result = StickUp;
-    }
-    else if ((bearing >= upRightInitial) && (bearing < rightInitial))
-    {
-        result = StickRightUp;
-    }
-    else if ((bearing >= rightInitial) && (bearing < downRightInitial))
-    {
-        result = StickRight;
-    }
-    else if ((bearing >= downRightInitial) && (bearing < downInitial))
-    {
-        result = StickRightDown;
-    }
-    else if ((bearing >= downInitial) && (bearing < downLeftInitial))
-    {
-        result = StickDown;
-    }
-    else if ((bearing >= downLeftInitial) && (bearing < leftInitial))
-    {
-        result = StickLeftDown;
-    }
-    else if ((bearing >= leftInitial) && (bearing < upLeftInitial))
-    {
-        result = StickLeft;
-    }
-    else if ((bearing >= upLeftInitial) && (bearing < initialLeft))
-    {
-        result = StickLeftUp;
-    }
-
-    return result;
+    return standardModeDirectionFromBearing(calculateBearing(axisXValue, axisYValue), true);
 }
 
 /**
@@ -2905,9 +2939,147 @@ JoyControlStick::determineFourWayCardinalDirection(int axisXValue, int axisYValu
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    return fourWayCardinalDirectionFromBearing(calculateBearing(axisXValue, axisYValue));
+}
+
+/**
+ * @brief Find the current stick direction based on a Four Way Diagonal mode
+ *     stick.
+ * @return Current direction the stick is positioned.
+ */
+JoyControlStick::JoyStickDirections
+JoyControlStick::determineFourWayDiagonalDirection()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return determineFourWayDiagonalDirection(axisX->getCurrentRawValue(),
+                                             axisY->getCurrentRawValue());
+}
+
+JoyControlStick::JoyStickDirections
+JoyControlStick::determineFourWayDiagonalDirection(int axisXValue, int axisYValue)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return fourWayDiagonalDirectionFromBearing(calculateBearing(axisXValue, axisYValue));
+}
+
+/**
+ * @brief Calculate the current direction of the stick based on the values
+ *     of the X and Y axes and the current mode of the stick.
+ * @return Current direction the stick is positioned.
+ */
+JoyControlStick::JoyStickDirections
+JoyControlStick::calculateStickDirection()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return calculateStickDirection(axisX->getCurrentRawValue(),
+                                   axisY->getCurrentRawValue());
+}
+
+JoyControlStick::JoyStickDirections
+JoyControlStick::calculateStickDirection(int axisXValue, int axisYValue)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return lookupDirection(calculateBearing(axisXValue, axisYValue));
+}
+
+/**
+ * @brief Look up the direction of a bearing for the current mode with
+ *     the diagonal zone angles truncated to whole degrees.
+ * @param Bearing (in degrees)
+ * @return Stick direction for the current mode
+ */
+JoyControlStick::JoyStickDirections JoyControlStick::lookupDirection(double bearing)
+{
+    return static_cast<JoyStickDirections>(directionTable.constData()[bearingTableIndex(bearing)]);
+}
+
+/**
+ * @brief Look up the direction used to pick event buttons for a bearing.
+ *     Unlike calculateStickDirection, the diagonal zone angles are not
+ *     truncated to whole degrees.
+ * @param Bearing (in degrees)
+ * @return Stick direction for the current mode
+ */
+JoyControlStick::JoyStickDirections JoyControlStick::lookupEventDirection(double bearing)
+{
+    return static_cast<JoyStickDirections>(eventDirectionTable.constData()[bearingTableIndex(bearing)]);
+}
+
+/**
+ * @brief Resolve a standard or eight way mode direction by comparing a
+ *     bearing against the diagonal zone angles.
+ * @param Bearing (in degrees)
+ * @param Whether zone angles should be truncated to whole degrees
+ * @return Stick direction
+ */
+JoyControlStick::JoyStickDirections
+JoyControlStick::standardModeDirectionFromBearing(double bearing, bool wholeAngles)
+{
     JoyStickDirections result = StickCentered;
 
-    double bearing = calculateBearing(axisXValue, axisYValue);
+    QList<double> anglesList = getDiagonalZoneAngles();
+    if (wholeAngles)
+    {
+        for (int i = 0; i < anglesList.size(); i++)
+        {
+            anglesList[i] = static_cast<int>(anglesList.at(i));
+        }
+    }
+
+    double initialLeft = anglesList.value(0);
+    double initialRight = anglesList.value(1);
+    double upRightInitial = anglesList.value(2);
+    double rightInitial = anglesList.value(3);
+    double downRightInitial = anglesList.value(4);
+    double downInitial = anglesList.value(5);
+    double downLeftInitial = anglesList.value(6);
+    double leftInitial = anglesList.value(7);
+    double upLeftInitial = anglesList.value(8);
+
+    if ((bearing <= initialRight) || (bearing >= initialLeft))
+    {
+        result = StickUp;
+    }
+    else if ((bearing >= upRightInitial) && (bearing < rightInitial))
+    {
+        result = StickRightUp;
+    }
+    else if ((bearing >= rightInitial) && (bearing < downRightInitial))
+    {
+        result = StickRight;
+    }
+    else if ((bearing >= downRightInitial) && (bearing < downInitial))
+    {
+        result = StickRightDown;
+    }
+    else if ((bearing >= downInitial) && (bearing < downLeftInitial))
+    {
+        result = StickDown;
+    }
+    else if ((bearing >= downLeftInitial) && (bearing < leftInitial))
+    {
+        result = StickLeftDown;
+    }
+    else if ((bearing >= leftInitial) && (bearing < upLeftInitial))
+    {
+        result = StickLeft;
+    }
+    else if ((bearing >= upLeftInitial) && (bearing < initialLeft))
+    {
+        result = StickLeftUp;
+    }
+
+    return result;
+}
+
+JoyControlStick::JoyStickDirections
+JoyControlStick::fourWayCardinalDirectionFromBearing(double bearing)
+{
+    JoyStickDirections result = StickCentered;
 
     QList<int> anglesList = getFourWayCardinalZoneAngles();
     int rightInitial = anglesList.value(0);
@@ -2935,29 +3107,11 @@ JoyControlStick::determineFourWayCardinalDirection(int axisXValue, int axisYValu
     return result;
 }
 
-/**
- * @brief Find the current stick direction based on a Four Way Diagonal mode
- *     stick.
- * @return Current direction the stick is positioned.
- */
-JoyControlStick::JoyStickDirections
-JoyControlStick::determineFourWayDiagonalDirection()
-{
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
-
-    return determineFourWayDiagonalDirection(axisX->getCurrentRawValue(),
-                                             axisY->getCurrentRawValue());
-}
-
 JoyControlStick::JoyStickDirections
-JoyControlStick::determineFourWayDiagonalDirection(int axisXValue, int axisYValue)
+JoyControlStick::fourWayDiagonalDirectionFromBearing(double bearing)
 {
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
-
     JoyStickDirections result = StickCentered;
 
-    double bearing = calculateBearing(axisXValue, axisYValue);
-
     QList<int> anglesList = getFourWayDiagonalZoneAngles();
     int upRightInitial = anglesList.value(0);
     int downRightInitial = anglesList.value(1);
@@ -2985,44 +3139,52 @@ JoyControlStick::determineFourWayDiagonalDirection(int axisXValue, int axisYValu
 }
 
 /**
- * @brief Calculate the current direction of the stick based on the values
- *     of the X and Y axes and the current mode of the stick.
- * @return Current direction the stick is positioned.
+ * @brief Rebuild the bearing to direction tables for the current mode and
+ *     diagonal range. The tables are read by joyEvent so they are only
+ *     replaced on the thread of the stick. Calls from other threads, like
+ *     the GUI changing the mode, are queued to that thread.
  */
-JoyControlStick::JoyStickDirections
-JoyControlStick::calculateStickDirection()
-{
-    qInstallMessageHandler(MessageHandler::myMessageOutput);
-
-    return calculateStickDirection(axisX->getCurrentRawValue(),
-                                   axisY->getCurrentRawValue());
-}
-
-JoyControlStick::JoyStickDirections
-JoyControlStick::calculateStickDirection(int axisXValue, int axisYValue)
+void JoyControlStick::rebuildDirectionTables()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    JoyStickDirections result = StickCentered;
-
-    if (currentMode == StandardMode)
+    if (thread() != QThread::currentThread())
     {
-        result = determineStandardModeDirection(axisXValue, axisYValue);
+        QMetaObject::invokeMethod(this, "rebuildDirectionTables", Qt::QueuedConnection);
+        return;
     }
-    else if (currentMode == EightWayMode)
-    {
-        result = determineEightWayModeDirection(axisXValue, axisYValue);
-    }
-    else if (currentMode == FourWayCardinal)
-    {
-        result = determineFourWayCardinalDirection(axisXValue, axisYValue);
-    }
-    else if (currentMode == FourWayDiagonal)
+
+    QVector<quint8> tempDirectionTable(BEARINGTABLESIZE, StickCentered);
+    QVector<quint8> tempEventDirectionTable(BEARINGTABLESIZE, StickCentered);
+
+    for (int i = 0; i < BEARINGTABLESIZE; i++)
     {
-        result = determineFourWayDiagonalDirection(axisXValue, axisYValue);
+        double bearing = bearingForTableIndex(i);
+        JoyStickDirections direction = StickCentered;
+        JoyStickDirections eventDirection = StickCentered;
+
+        if ((currentMode == StandardMode) || (currentMode == EightWayMode))
+        {
+            direction = standardModeDirectionFromBearing(bearing, true);
+            eventDirection = standardModeDirectionFromBearing(bearing, false);
+        }
+        else if (currentMode == FourWayCardinal)
+        {
+            direction = fourWayCardinalDirectionFromBearing(bearing);
+            eventDirection = direction;
+        }
+        else if (currentMode == FourWayDiagonal)
+        {
+            direction = fourWayDiagonalDirectionFromBearing(bearing);
+            eventDirection = direction;
+        }
+
+        tempDirectionTable[i] = static_cast<quint8>(direction);
+        tempEventDirectionTable[i] = static_cast<quint8>(eventDirection);
     }
 
-    return result;
+    directionTable = tempDirectionTable;
+    eventDirectionTable = tempEventDirectionTable;
 }
 
 void JoyControlStick::establishPropertyUpdatedConnection()
@@ -3124,9 +3286,11 @@ void JoyControlStick::copyAssignments(JoyControlStick *destStick)
     destStick->diagonalRange = diagonalRange;
     destStick->currentDirection = currentDirection;
     destStick->currentMode = currentMode;
+    destStick->rebuildDirectionTables();
     destStick->stickName = stickName;
     destStick->circle = circle;
     destStick->stickDelay = stickDelay;
+    destStick->outerCorrection = outerCorrection;
 
     QHashIterator<JoyStickDirections, JoyControlStickButton*> iter(destStick->buttons);
     while (iter.hasNext())
@@ -3166,6 +3330,7 @@ void JoyControlStick::setCircleAdjust(double circle)
     if ((circle >= 0.0) && (circle <= 1.0))
     {
         this->circle = circle;
+        invalidateButtonMouseDistances();
         emit circleAdjustChange(circle);
         emit propertyUpdated();
     }
@@ -24,6 +24,7 @@
 #include <QObject>
 #include <QHash>
 #include <QList>
+#include <QVector>
 #include <QTimer>
 
 
@@ -57,8 +58,11 @@ public:
     void clearPendingEvent();
     void setCalibrationFlag(bool flag);
     void setCalibrationSummary(QString text);
+    void setOuterCorrectionTable(const QVector<double> &table);
 
     QString getCalibrationSummary();
+    const QVector<double>& getOuterCorrectionTable();
+    double getOuterCorrection(double angle);
 
     bool inDeadZone();
     bool hasSlotsAssigned();
@@ -212,6 +216,12 @@ protected:
     JoyControlStick::JoyStickDirections calculateStickDirection();
     JoyControlStick::JoyStickDirections calculateStickDirection(int axisXValue, int axisYValue);
 
+    JoyControlStick::JoyStickDirections lookupDirection(double bearing);
+    JoyControlStick::JoyStickDirections lookupEventDirection(double bearing);
+    JoyControlStick::JoyStickDirections standardModeDirectionFromBearing(double bearing, bool wholeAngles);
+    JoyControlStick::JoyStickDirections fourWayCardinalDirectionFromBearing(double bearing);
+    JoyControlStick::JoyStickDirections fourWayDiagonalDirectionFromBearing(double bearing);
+
     void performButtonPress(JoyControlStickButton *eventbutton, JoyControlStickButton *&activebutton, bool ignoresets);
     void performButtonRelease(JoyControlStickButton *&eventbutton, bool ignoresets);
 
@@ -234,6 +244,7 @@ protected:
 
     QHash<JoyStickDirections, JoyControlStickButton*> getApplicableButtons();
     void clearPendingAxisEvents();
+    void invalidateButtonMouseDistances();
 
 signals:
     void moved(int xaxis, int yaxis);
@@ -263,6 +274,7 @@ public slots:
 
 private slots:
     void stickDirectionChangeEvent();
+    void rebuildDirectionTables();
 
 private:
     int originset;
@@ -280,6 +292,10 @@ private:
     bool calibrated;
 
     QString calibrationSummary;
+    QVector<double> outerCorrection;
+
+    QVector<quint8> directionTable;
+    QVector<quint8> eventDirectionTable;
 
     JoyAxis *axisX;
     JoyAxis *axisY;
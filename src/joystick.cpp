@@ -62,6 +62,10 @@ QString Joystick::getSDLName()
     {
         temp = SDL_JoystickName(joyhandle);
     }
+    else
+    {
+        temp = detachedSDLName;
+    }
 
     return temp;
 }
@@ -72,10 +76,17 @@ QString Joystick::getGUIDString()
 
     QString temp = QString();
 
-    SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(joyhandle);
-    char guidString[65] = {'0'};
-    SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
-    temp = QString(guidString);
+    if (joyhandle != nullptr)
+    {
+        SDL_JoystickGUID tempGUID = SDL_JoystickGetGUID(joyhandle);
+        char guidString[65] = {'0'};
+        SDL_JoystickGetGUIDString(tempGUID, guidString, sizeof(guidString));
+        temp = QString(guidString);
+    }
+    else
+    {
+        temp = detachedGUIDString;
+    }
 
     // Not available on SDL 1.2. Return empty string in that case.
     return temp;
@@ -98,6 +109,33 @@ void Joystick::closeSDLDevice()
     }
 }
 
+void Joystick::detachSDLDevice()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    detachedGUIDString = getGUIDString();
+    detachedSDLName = getSDLName();
+
+    // Handle has to be closed even though the device is no longer attached.
+    if (joyhandle != nullptr)
+    {
+        SDL_JoystickClose(joyhandle);
+        joyhandle = nullptr;
+    }
+}
+
+void Joystick::rebindSDLDevice(SDL_Joystick *joyhandle, int deviceIndex)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    this->joyhandle = joyhandle;
+    joystickID = SDL_JoystickInstanceID(joyhandle);
+    setIndex(deviceIndex);
+
+    detachedGUIDString = QString();
+    detachedSDLName = QString();
+}
+
 int Joystick::getNumberRawButtons()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
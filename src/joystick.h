@@ -36,6 +36,8 @@ public:
     virtual QString getGUIDString(); // GUID available on SDL 2.
     virtual QString getXmlName();
     virtual void closeSDLDevice();
+    virtual void detachSDLDevice();
+    void rebindSDLDevice(SDL_Joystick *joyhandle, int deviceIndex);
     virtual SDL_JoystickID getSDLJoystickID();
 
     virtual int getNumberRawButtons();
@@ -50,6 +52,10 @@ private:
     SDL_Joystick *joyhandle;
     SDL_JoystickID joystickID;
 
+    // Identity of a detached device. Used while waiting for a reconnect.
+    QString detachedGUIDString;
+    QString detachedSDLName;
+
 };
 
 Q_DECLARE_METATYPE(Joystick*)
@@ -482,6 +482,7 @@ JoyTabWidget::JoyTabWidget(InputDevice *joystick, AntiMicroSettings *settings, Q
     connect(setPushButton6, &QPushButton::clicked, this, &JoyTabWidget::changeSetSix);
     connect(setPushButton7, &QPushButton::clicked, this, &JoyTabWidget::changeSetSeven);
     connect(setPushButton8, &QPushButton::clicked, this, &JoyTabWidget::changeSetEight);
+    connect(stackedWidget_2, &QStackedWidget::currentChanged, this, &JoyTabWidget::buildSetPage);
 
     connect(stickAssignPushButton, &QPushButton::clicked, this, &JoyTabWidget::showStickAssignmentDialog);
     connect(gameControllerMappingPushButton, &QPushButton::clicked, this, &JoyTabWidget::openGameControllerMappingWindow);
@@ -559,7 +560,8 @@ void JoyTabWidget::openConfigFileDialog()
 
 /**
  * @brief Create and render all push buttons corresponding to joystick
- *     controls for all sets.
+ *     controls for the displayed set. Pages of the other sets are built
+ *     the first time they are shown.
  */
 void JoyTabWidget::fillButtons()
 {
@@ -568,15 +570,43 @@ void JoyTabWidget::fillButtons()
     joystick->establishPropertyUpdatedConnection();
     connect(joystick, &InputDevice::setChangeActivated, this, &JoyTabWidget::changeCurrentSet, Qt::QueuedConnection);
 
+    // Edits to a set must mark the profile as changed even when its page
+    // has not been built yet.
     for (int i=0; i < Joystick::NUMBER_JOYSETS; i++)
     {
-        SetJoystick *currentSet = joystick->getSetJoystick(i);
-        fillSetButtons(currentSet);
+        establishSetPropertyConnections(joystick->getSetJoystick(i));
+    }
+
+    // Pages left over from an earlier fill are stale. Drop them so they
+    // get rebuilt on display.
+    for (int i=0; i < Joystick::NUMBER_JOYSETS; i++)
+    {
+        if (builtSetPages.contains(i))
+        {
+            removeSetButtons(joystick->getSetJoystick(i));
+        }
     }
 
+    buildSetPage(stackedWidget_2->currentIndex());
+
     refreshCopySetActions();
 }
 
+/**
+ * @brief Create the widgets of a set page unless they already exist.
+ * @param Index of the set page
+ */
+void JoyTabWidget::buildSetPage(int index)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if ((index >= 0) && (index < Joystick::NUMBER_JOYSETS) &&
+        !builtSetPages.contains(index))
+    {
+        fillSetButtons(joystick->getSetJoystick(index));
+    }
+}
+
 void JoyTabWidget::showButtonDialog()
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -1430,7 +1460,12 @@ void JoyTabWidget::removeCurrentButtons()
     for (int i=0; i < Joystick::NUMBER_JOYSETS; i++)
     {
         SetJoystick *currentSet = joystick->getSetJoystick(i);
-        removeSetButtons(currentSet);
+        currentSet->disconnectPropertyUpdatedConnection();
+
+        if (builtSetPages.contains(i))
+        {
+            removeSetButtons(currentSet);
+        }
     }
 }
 
@@ -1978,7 +2013,7 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
     }
 
     SetJoystick *currentSet = set;
-    currentSet->establishPropertyUpdatedConnection();
+    builtSetPages.insert(currentSet->getIndex());
 
     QGridLayout *stickGrid = nullptr;
     QGroupBox *stickGroup = nullptr;
@@ -1988,7 +2023,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
     for (int j=0; j < joystick->getNumberSticks(); j++)
     {
         JoyControlStick *stick = currentSet->getJoyStick(j);
-        stick->establishPropertyUpdatedConnection();
         QHash<JoyControlStick::JoyStickDirections, JoyControlStickButton*> *stickButtons = stick->getButtons();
 
         if (!hideEmptyButtons || stick->hasSlotsAssigned())
@@ -2030,7 +2064,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
             while (tempiter.hasNext())
             {
                 JoyControlStickButton *button = tempiter.next().value();
-                button->establishPropertyUpdatedConnections();
                 connect(button, &JoyControlStickButton::slotsChanged, this, &JoyTabWidget::checkStickDisplay);
             }
         }
@@ -2056,7 +2089,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
     for (int j = 0; j < joystick->getNumberHats(); j++)
     {
         JoyDPad *dpad = currentSet->getJoyDPad(j);
-        dpad->establishPropertyUpdatedConnection();
         QHash<int, JoyDPadButton*> *buttons = dpad->getJoyButtons();
 
         if (!hideEmptyButtons || dpad->hasSlotsAssigned())
@@ -2098,7 +2130,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
             while (tempiter.hasNext())
             {
                 JoyDPadButton *button = tempiter.next().value();
-                button->establishPropertyUpdatedConnections();
                 connect(button, &JoyDPadButton::slotsChanged, this, &JoyTabWidget::checkDPadButtonDisplay);
             }
         }
@@ -2107,7 +2138,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
     for (int j = 0; j < joystick->getNumberVDPads(); j++)
     {
         VDPad *vdpad = currentSet->getVDPad(j);
-        vdpad->establishPropertyUpdatedConnection();
         QHash<int, JoyDPadButton*> *buttons = vdpad->getButtons();
 
         if (!hideEmptyButtons || vdpad->hasSlotsAssigned())
@@ -2150,7 +2180,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
             while (tempiter.hasNext())
             {
                 JoyDPadButton *button = tempiter.next().value();
-                button->establishPropertyUpdatedConnections();
                 connect(button, &JoyDPadButton::slotsChanged, this, &JoyTabWidget::checkDPadButtonDisplay);
             }
         }
@@ -2205,9 +2234,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
             }
             else
             {
-                paxisbutton->establishPropertyUpdatedConnections();
-                naxisbutton->establishPropertyUpdatedConnections();
-
                 connect(paxisbutton, &JoyAxisButton::slotsChanged, this, &JoyTabWidget::checkAxisButtonDisplay);
                 connect(naxisbutton, &JoyAxisButton::slotsChanged, this, &JoyTabWidget::checkAxisButtonDisplay);
             }
@@ -2219,8 +2245,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
         JoyButton *button = currentSet->getJoyButton(j);
         if ((button != nullptr) && !button->isPartVDPad())
         {
-            button->establishPropertyUpdatedConnections();
-
             if (!hideEmptyButtons || (button->getAssignedSlots()->count() > 0))
             {
                 JoyButtonWidget *buttonWidget = new JoyButtonWidget (button, displayingNames, this);
@@ -2246,7 +2270,6 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
             }
             else
             {
-                button->establishPropertyUpdatedConnections();
                 connect(button, &JoyButton::slotsChanged, this, &JoyTabWidget::checkButtonDisplay);
             }
         }
@@ -2259,12 +2282,80 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
     }
 }
 
+/**
+ * @brief Forward property changes of a set and of its controls to the
+ *     device so the profile is flagged as edited.
+ * @param Set to connect
+ */
+void JoyTabWidget::establishSetPropertyConnections(SetJoystick *set)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    set->establishPropertyUpdatedConnection();
+
+    for (int j=0; j < joystick->getNumberSticks(); j++)
+    {
+        JoyControlStick *stick = set->getJoyStick(j);
+        stick->establishPropertyUpdatedConnection();
+
+        QHashIterator<JoyControlStick::JoyStickDirections, JoyControlStickButton*> tempiter(*stick->getButtons());
+        while (tempiter.hasNext())
+        {
+            tempiter.next().value()->establishPropertyUpdatedConnections();
+        }
+    }
+
+    for (int j = 0; j < joystick->getNumberHats(); j++)
+    {
+        JoyDPad *dpad = set->getJoyDPad(j);
+        dpad->establishPropertyUpdatedConnection();
+
+        QHashIterator<int, JoyDPadButton*> tempiter(*dpad->getJoyButtons());
+        while (tempiter.hasNext())
+        {
+            tempiter.next().value()->establishPropertyUpdatedConnections();
+        }
+    }
+
+    for (int j = 0; j < joystick->getNumberVDPads(); j++)
+    {
+        VDPad *vdpad = set->getVDPad(j);
+        vdpad->establishPropertyUpdatedConnection();
+
+        QHashIterator<int, JoyDPadButton*> tempiter(*vdpad->getButtons());
+        while (tempiter.hasNext())
+        {
+            tempiter.next().value()->establishPropertyUpdatedConnections();
+        }
+    }
+
+    for (int j = 0; j < joystick->getNumberAxes(); j++)
+    {
+        JoyAxis *axis = set->getJoyAxis(j);
+
+        if (!axis->isPartControlStick() && axis->hasControlOfButtons())
+        {
+            axis->getPAxisButton()->establishPropertyUpdatedConnections();
+            axis->getNAxisButton()->establishPropertyUpdatedConnections();
+        }
+    }
+
+    for (int j = 0; j < joystick->getNumberButtons(); j++)
+    {
+        JoyButton *button = set->getJoyButton(j);
+        if ((button != nullptr) && !button->isPartVDPad())
+        {
+            button->establishPropertyUpdatedConnections();
+        }
+    }
+}
+
 void JoyTabWidget::removeSetButtons(SetJoystick *set)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     SetJoystick *currentSet = set;
-    currentSet->disconnectPropertyUpdatedConnection();
+    builtSetPages.remove(currentSet->getIndex());
 
     QLayoutItem *child = nullptr;
     QGridLayout *current_layout = nullptr;
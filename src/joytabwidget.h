@@ -23,6 +23,7 @@
 
 #include <QFileDialog>
 #include <QHash>
+#include <QSet>
 #include <QScrollArea>
 #include <QIcon>
 
@@ -83,6 +84,7 @@ protected:
     void reconnectCheckUnsavedEvent();
     void fillSetButtons(SetJoystick *set);
     void removeSetButtons(SetJoystick *set);
+    void establishSetPropertyConnections(SetJoystick *set);
 
     static const int DEFAULTNUMBERPROFILES = 5;
 
@@ -116,6 +118,7 @@ private slots:
     void showKeyDelayDialog();
     void showSetNamesDialog();
     void toggleNames();
+    void buildSetPage(int index);
 
     void changeSetOne();
     void changeSetTwo();
@@ -217,6 +220,7 @@ private:
     QString oldProfileName;
 
     JoyTabWidgetHelper tabHelper;
+    QSet<int> builtSetPages;
 
 };
 
@@ -0,0 +1,104 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keystrokeprogram.h"
+
+static const quint32 STEPKEYCODEMASK = 0x3FFFFFFF;
+static const quint32 STEPPRESSEDFLAG = 0x40000000;
+static const quint32 STEPSYNCFLAG = 0x80000000;
+
+
+namespace KeystrokeProgram
+{
+    quint32 encodeStep(int keycode, bool pressed, bool sync)
+    {
+        quint32 step = static_cast<quint32>(keycode) & STEPKEYCODEMASK;
+
+        if (pressed)
+        {
+            step |= STEPPRESSEDFLAG;
+        }
+
+        if (sync)
+        {
+            step |= STEPSYNCFLAG;
+        }
+
+        return step;
+    }
+
+    int stepKeycode(quint32 step)
+    {
+        return static_cast<int>(step & STEPKEYCODEMASK);
+    }
+
+    bool stepPressed(quint32 step)
+    {
+        return (step & STEPPRESSEDFLAG) != 0;
+    }
+
+    bool stepSync(quint32 step)
+    {
+        return (step & STEPSYNCFLAG) != 0;
+    }
+
+    /**
+     * @brief Turn resolved characters into a flat list of key steps.
+     *     Modifiers stay held between consecutive characters that need
+     *     them so only changes in modifier state produce extra steps.
+     * @param Resolved characters in typing order
+     * @return Keystroke program
+     */
+    Steps compile(const QList<CharacterStroke> &strokes)
+    {
+        Steps program;
+        QList<int> heldModifiers;
+
+        for (int i = 0; i < strokes.size(); i++)
+        {
+            const CharacterStroke &stroke = strokes.at(i);
+
+            for (int j = heldModifiers.size() - 1; j >= 0; j--)
+            {
+                if (!stroke.modifiers.contains(heldModifiers.at(j)))
+                {
+                    program.append(encodeStep(heldModifiers.at(j), false, false));
+                    heldModifiers.removeAt(j);
+                }
+            }
+
+            for (int j = 0; j < stroke.modifiers.size(); j++)
+            {
+                if (!heldModifiers.contains(stroke.modifiers.at(j)))
+                {
+                    program.append(encodeStep(stroke.modifiers.at(j), true, false));
+                    heldModifiers.append(stroke.modifiers.at(j));
+                }
+            }
+
+            program.append(encodeStep(stroke.keycode, true, true));
+            program.append(encodeStep(stroke.keycode, false, true));
+        }
+
+        for (int j = heldModifiers.size() - 1; j >= 0; j--)
+        {
+            program.append(encodeStep(heldModifiers.at(j), false, (j == 0)));
+        }
+
+        return program;
+    }
+}
@@ -0,0 +1,50 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEYSTROKEPROGRAM_H
+#define KEYSTROKEPROGRAM_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QList>
+
+/**
+ * @brief Packed representation of a text entry. Every step is a single
+ *     32 bit word holding a backend specific key code, the key state and
+ *     whether the backend should flush after the step. Programs are built
+ *     once when a slot is configured and replayed by TextEntryStreamer.
+ */
+namespace KeystrokeProgram
+{
+    typedef QVector<quint32> Steps;
+
+    // Key code and modifier key codes needed to type one character.
+    struct CharacterStroke
+    {
+        int keycode;
+        QList<int> modifiers;
+    };
+
+    quint32 encodeStep(int keycode, bool pressed, bool sync);
+    int stepKeycode(quint32 step);
+    bool stepPressed(quint32 step);
+    bool stepSync(quint32 step);
+
+    Steps compile(const QList<CharacterStroke> &strokes);
+}
+
+#endif // KEYSTROKEPROGRAM_H
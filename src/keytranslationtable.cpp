@@ -0,0 +1,160 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keytranslationtable.h"
+
+#include <QHashIterator>
+
+static const int DIRECTORYSIZE = 4096;
+static const int PAGESIZE = 256;
+
+
+KeyTranslationTable::KeyTranslationTable()
+{
+    clear();
+}
+
+void KeyTranslationTable::clear()
+{
+    for (int i = 0; i < 16; i++)
+    {
+        ranges[i] = -1;
+    }
+
+    directories.clear();
+    middlePages.clear();
+    leafPages.clear();
+    leafPresent.clear();
+    count = 0;
+}
+
+/**
+ * @brief Append a block of unused entries to a level of the table.
+ * @param Storage of the level
+ * @param Number of entries in a block of that level
+ * @return Index of the new block
+ */
+int KeyTranslationTable::allocateBlock(QVector<qint32> &storage, int blockSize)
+{
+    int index = storage.size() / blockSize;
+    storage.insert(storage.size(), blockSize, -1);
+    return index;
+}
+
+void KeyTranslationTable::insert(int key, int value)
+{
+    quint32 tempkey = static_cast<quint32>(key);
+    int rangeIndex = static_cast<int>(tempkey >> 28);
+    int directoryIndex = static_cast<int>((tempkey >> 16) & 0xFFF);
+    int middleIndex = static_cast<int>((tempkey >> 8) & 0xFF);
+    int leafIndex = static_cast<int>(tempkey & 0xFF);
+
+    if (ranges[rangeIndex] < 0)
+    {
+        ranges[rangeIndex] = allocateBlock(directories, DIRECTORYSIZE);
+    }
+
+    int directorySlot = (ranges[rangeIndex] * DIRECTORYSIZE) + directoryIndex;
+    if (directories.at(directorySlot) < 0)
+    {
+        directories[directorySlot] = allocateBlock(middlePages, PAGESIZE);
+    }
+
+    int middleSlot = (directories.at(directorySlot) * PAGESIZE) + middleIndex;
+    if (middlePages.at(middleSlot) < 0)
+    {
+        // Leaves start out as 0 so missing keys in a used page still
+        // return the default value.
+        middlePages[middleSlot] = leafPages.size() / PAGESIZE;
+        leafPages.insert(leafPages.size(), PAGESIZE, 0);
+        leafPresent.insert(leafPresent.size(), PAGESIZE, 0);
+    }
+
+    int leafSlot = (middlePages.at(middleSlot) * PAGESIZE) + leafIndex;
+    if (leafPresent.at(leafSlot) == 0)
+    {
+        leafPresent[leafSlot] = 1;
+        count++;
+    }
+
+    leafPages[leafSlot] = value;
+}
+
+/**
+ * @brief Replace the contents of the table with the entries of a hash.
+ * @param Hash used while populating key mappings
+ */
+void KeyTranslationTable::build(const QHash<int, int> &source)
+{
+    clear();
+
+    QHashIterator<int, int> iter(source);
+    while (iter.hasNext())
+    {
+        iter.next();
+        insert(iter.key(), iter.value());
+    }
+}
+
+int KeyTranslationTable::value(int key) const
+{
+    int result = 0;
+    quint32 tempkey = static_cast<quint32>(key);
+    int directory = ranges[tempkey >> 28];
+
+    if (directory >= 0)
+    {
+        int middle = directories.constData()[(directory * DIRECTORYSIZE) + ((tempkey >> 16) & 0xFFF)];
+        if (middle >= 0)
+        {
+            int leaf = middlePages.constData()[(middle * PAGESIZE) + ((tempkey >> 8) & 0xFF)];
+            if (leaf >= 0)
+            {
+                result = leafPages.constData()[(leaf * PAGESIZE) + (tempkey & 0xFF)];
+            }
+        }
+    }
+
+    return result;
+}
+
+bool KeyTranslationTable::contains(int key) const
+{
+    bool result = false;
+    quint32 tempkey = static_cast<quint32>(key);
+    int directory = ranges[tempkey >> 28];
+
+    if (directory >= 0)
+    {
+        int middle = directories.constData()[(directory * DIRECTORYSIZE) + ((tempkey >> 16) & 0xFFF)];
+        if (middle >= 0)
+        {
+            int leaf = middlePages.constData()[(middle * PAGESIZE) + ((tempkey >> 8) & 0xFF)];
+            if (leaf >= 0)
+            {
+                result = leafPresent.constData()[(leaf * PAGESIZE) + (tempkey & 0xFF)] != 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+int KeyTranslationTable::size() const
+{
+    return count;
+}
@@ -0,0 +1,58 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEYTRANSLATIONTABLE_H
+#define KEYTRANSLATIONTABLE_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QHash>
+
+/**
+ * @brief Read-only int to int map stored as dense multi level arrays.
+ *     The top four bits of a key select its range, which matches the
+ *     custom Qt key, custom key and native key prefixes used by
+ *     QtKeyMapperBase. The remaining bits are split into a 12 bit
+ *     directory index and two 8 bit page indexes, so a lookup is a few
+ *     array reads without hashing. Missing keys return 0 like
+ *     QHash::value does for the tables it replaces.
+ */
+class KeyTranslationTable
+{
+public:
+    KeyTranslationTable();
+
+    void clear();
+    void insert(int key, int value);
+    void build(const QHash<int, int> &source);
+
+    int value(int key) const;
+    bool contains(int key) const;
+    int size() const;
+
+private:
+    int allocateBlock(QVector<qint32> &storage, int blockSize);
+
+    qint32 ranges[16];
+    QVector<qint32> directories;
+    QVector<qint32> middlePages;
+    QVector<qint32> leafPages;
+    QVector<quint8> leafPresent;
+    int count;
+};
+
+#endif // KEYTRANSLATIONTABLE_H
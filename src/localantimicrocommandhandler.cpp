@@ -0,0 +1,469 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "localantimicrocommandhandler.h"
+
+#include "messagehandler.h"
+#include "localantimicroprotocol.h"
+#include "inputdevice.h"
+#include "xmlconfigreader.h"
+#include "common.h"
+#include "logger.h"
+#include "joybutton.h"
+
+#include <QLocalSocket>
+#include <QPointer>
+#include <QMutexLocker>
+#include <QFileInfo>
+#include <QMapIterator>
+#include <QThread>
+#include <QDebug>
+
+
+LocalAntiMicroCommandHandler::LocalAntiMicroCommandHandler(QMap<SDL_JoystickID, InputDevice*> *joysticks,
+                                                           QObject *parent) :
+    QObject(parent)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    this->joysticks = joysticks;
+    requestCount = 0;
+    failedRequestCount = 0;
+    lastRequestNsecs = 0;
+    totalRequestNsecs = 0;
+    maxRequestNsecs = 0;
+    uptimeTimer.start();
+}
+
+void LocalAntiMicroCommandHandler::addClient(QLocalSocket *socket)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (socket != nullptr)
+    {
+        clientBuffers.insert(socket, QByteArray());
+        protocolClients.insert(socket, false);
+
+        connect(socket, &QLocalSocket::readyRead, this, &LocalAntiMicroCommandHandler::readClientData);
+        connect(socket, &QLocalSocket::disconnected, this, &LocalAntiMicroCommandHandler::removeClient);
+
+        // Data might have arrived before the socket was handed over
+        // to this thread.
+        if (socket->bytesAvailable() > 0)
+        {
+            processClientData(socket);
+        }
+
+        if (clientBuffers.contains(socket) && (socket->state() != QLocalSocket::ConnectedState))
+        {
+            releaseClient(socket);
+        }
+    }
+}
+
+void LocalAntiMicroCommandHandler::readClientData()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+    if ((socket != nullptr) && clientBuffers.contains(socket))
+    {
+        processClientData(socket);
+    }
+}
+
+void LocalAntiMicroCommandHandler::processClientData(QLocalSocket *socket)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QPointer<QLocalSocket> client(socket);
+    QByteArray buffer = clientBuffers.value(socket);
+    buffer.append(socket->readAll());
+
+    bool processing = true;
+    while (processing && !client.isNull())
+    {
+        quint8 command = LocalAntiMicroProtocol::InvalidCommand;
+        QVariantMap args;
+        LocalAntiMicroProtocol::FrameResult result =
+                LocalAntiMicroProtocol::decodeFrame(buffer, command, args);
+
+        if (result == LocalAntiMicroProtocol::FrameComplete)
+        {
+            protocolClients.insert(socket, true);
+
+            QElapsedTimer requestTimer;
+            requestTimer.start();
+
+            QVariantMap response = processRequest(command, args);
+            LocalAntiMicroProtocol::writeFrame(socket, command, response);
+
+            lastRequestNsecs = requestTimer.nsecsElapsed();
+            totalRequestNsecs += lastRequestNsecs;
+            maxRequestNsecs = qMax(maxRequestNsecs, lastRequestNsecs);
+            requestCount++;
+            if (response.value("status").toInt() != LocalAntiMicroProtocol::StatusOk)
+            {
+                failedRequestCount++;
+            }
+
+            Logger::LogDebug(QString("Local command \"%1\" handled in %2 us")
+                             .arg(LocalAntiMicroProtocol::commandName(command))
+                             .arg(lastRequestNsecs / 1000.0, 0, 'f', 1));
+        }
+        else if (result == LocalAntiMicroProtocol::FrameInvalid)
+        {
+            Logger::LogWarning(trUtf8("Invalid frame received on local socket. Closing connection."));
+
+            buffer.clear();
+            failedRequestCount++;
+            protocolClients.insert(socket, true);
+            processing = false;
+            socket->disconnectFromServer();
+        }
+        else
+        {
+            processing = false;
+        }
+    }
+
+    if (!client.isNull() && clientBuffers.contains(socket))
+    {
+        clientBuffers.insert(socket, buffer);
+        socket->flush();
+    }
+}
+
+void LocalAntiMicroCommandHandler::removeClient()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+    if ((socket != nullptr) && clientBuffers.contains(socket))
+    {
+        releaseClient(socket);
+    }
+}
+
+void LocalAntiMicroCommandHandler::releaseClient(QLocalSocket *socket)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    bool usedProtocol = protocolClients.value(socket, false);
+    clientBuffers.remove(socket);
+    protocolClients.remove(socket);
+    socket->deleteLater();
+
+    // Plain connections are made by a second instance that wrote
+    // its options to the settings file. Let the GUI reload them.
+    if (!usedProtocol)
+    {
+        emit legacyClientDisconnected();
+    }
+}
+
+QVariantMap LocalAntiMicroCommandHandler::processRequest(quint8 command, const QVariantMap &args)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QVariantMap response;
+
+    switch (command)
+    {
+        case LocalAntiMicroProtocol::LoadProfile:
+        {
+            QMutexLocker locker(&PadderCommon::inputDaemonMutex);
+            response = loadProfile(args);
+            break;
+        }
+        case LocalAntiMicroProtocol::ChangeSet:
+        {
+            QMutexLocker locker(&PadderCommon::inputDaemonMutex);
+            response = changeSet(args);
+            break;
+        }
+        case LocalAntiMicroProtocol::UnloadProfile:
+        {
+            QMutexLocker locker(&PadderCommon::inputDaemonMutex);
+            response = unloadProfile(args);
+            break;
+        }
+        case LocalAntiMicroProtocol::QueryStatus:
+        {
+            response = queryStatus();
+            break;
+        }
+        case LocalAntiMicroProtocol::ReadStats:
+        {
+            response = readStats();
+            break;
+        }
+        default:
+        {
+            response = createResponse(LocalAntiMicroProtocol::StatusUnsupported,
+                                      trUtf8("Unknown command %1").arg(command));
+            break;
+        }
+    }
+
+    return response;
+}
+
+/**
+ * @brief Find devices matching a controller value. The value can be a
+ *     controller number, GUID or name like on the command-line. An empty
+ *     value matches all connected controllers.
+ */
+QList<InputDevice*> LocalAntiMicroCommandHandler::findDevices(QString controller)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QList<InputDevice*> devices;
+    bool validNumber = false;
+    int controllerNumber = controller.toInt(&validNumber);
+
+    QMapIterator<SDL_JoystickID, InputDevice*> iter(*joysticks);
+    while (iter.hasNext())
+    {
+        InputDevice *device = iter.next().value();
+        if (device == nullptr)
+        {
+            continue;
+        }
+
+        if (controller.isEmpty())
+        {
+            devices.append(device);
+        }
+        else if (validNumber && (device->getRealJoyNumber() == controllerNumber))
+        {
+            devices.append(device);
+        }
+        else if (!validNumber &&
+                 ((controller == device->getStringIdentifier()) ||
+                  (controller == device->getGUIDString()) ||
+                  (controller == device->getSDLName())))
+        {
+            devices.append(device);
+        }
+    }
+
+    return devices;
+}
+
+/**
+ * @brief Pick the connection used to change a device. Devices processed
+ *     on a device worker have to be changed from their worker thread.
+ * @param Device that is about to be changed
+ * @return Connection type for QMetaObject::invokeMethod
+ */
+Qt::ConnectionType LocalAntiMicroCommandHandler::deviceConnection(InputDevice *device)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return (device->thread() == QThread::currentThread()) ? Qt::DirectConnection :
+                                                            Qt::BlockingQueuedConnection;
+}
+
+QVariantMap LocalAntiMicroCommandHandler::loadProfile(const QVariantMap &args)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QString profile = args.value("profile").toString();
+    QFileInfo profileInfo(profile);
+    if (profile.isEmpty() || !profileInfo.exists() || !profileInfo.isReadable())
+    {
+        return createResponse(LocalAntiMicroProtocol::StatusProfileError,
+                              trUtf8("Profile location %1 is not a readable file.").arg(profile));
+    }
+
+    QList<InputDevice*> devices = findDevices(args.value("controller").toString());
+    if (devices.isEmpty())
+    {
+        return createResponse(LocalAntiMicroProtocol::StatusNoDevice);
+    }
+
+    QStringList errors;
+    QListIterator<InputDevice*> iter(devices);
+    while (iter.hasNext())
+    {
+        InputDevice *device = iter.next();
+        Qt::ConnectionType connection = deviceConnection(device);
+        QMetaObject::invokeMethod(device, "disconnectPropertyUpdatedConnection", connection);
+
+        if (device->getActiveSetNumber() != 0)
+        {
+            QMetaObject::invokeMethod(device, "setActiveSetNumber", connection, Q_ARG(int, 0));
+        }
+
+        QMetaObject::invokeMethod(device, "resetButtonDownCount", connection);
+
+        XMLConfigReader *reader = new XMLConfigReader;
+        reader->setFileName(profileInfo.absoluteFilePath());
+        reader->moveToThread(device->thread());
+        QMetaObject::invokeMethod(reader, "configJoystick", connection, Q_ARG(InputDevice*, device));
+
+        QMetaObject::invokeMethod(device, "establishPropertyUpdatedConnection", connection);
+
+        if (reader->hasError())
+        {
+            errors.append(reader->getErrorString());
+        }
+
+        reader->deleteLater();
+    }
+
+    QVariantMap response = createResponse(errors.isEmpty() ? LocalAntiMicroProtocol::StatusOk :
+                                                             LocalAntiMicroProtocol::StatusProfileError,
+                                          errors.join("\n"));
+    response.insert("devices", devices.size());
+    return response;
+}
+
+QVariantMap LocalAntiMicroCommandHandler::changeSet(const QVariantMap &args)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    bool validNumber = false;
+    int setNumber = args.value("set").toInt(&validNumber);
+    if (!validNumber || (setNumber < 1) || (setNumber > InputDevice::NUMBER_JOYSETS))
+    {
+        return createResponse(LocalAntiMicroProtocol::StatusBadRequest,
+                              trUtf8("Set number must be between 1 and %1.")
+                              .arg(InputDevice::NUMBER_JOYSETS));
+    }
+
+    QList<InputDevice*> devices = findDevices(args.value("controller").toString());
+    if (devices.isEmpty())
+    {
+        return createResponse(LocalAntiMicroProtocol::StatusNoDevice);
+    }
+
+    QListIterator<InputDevice*> iter(devices);
+    while (iter.hasNext())
+    {
+        InputDevice *device = iter.next();
+        QMetaObject::invokeMethod(device, "setActiveSetNumber", deviceConnection(device),
+                                  Q_ARG(int, setNumber - 1));
+    }
+
+    QVariantMap response = createResponse(LocalAntiMicroProtocol::StatusOk);
+    response.insert("devices", devices.size());
+    return response;
+}
+
+QVariantMap LocalAntiMicroCommandHandler::unloadProfile(const QVariantMap &args)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QList<InputDevice*> devices = findDevices(args.value("controller").toString());
+    if (devices.isEmpty())
+    {
+        return createResponse(LocalAntiMicroProtocol::StatusNoDevice);
+    }
+
+    QListIterator<InputDevice*> iter(devices);
+    while (iter.hasNext())
+    {
+        InputDevice *device = iter.next();
+        Qt::ConnectionType connection = deviceConnection(device);
+        QMetaObject::invokeMethod(device, "disconnectPropertyUpdatedConnection", connection);
+
+        if (device->getActiveSetNumber() != 0)
+        {
+            QMetaObject::invokeMethod(device, "setActiveSetNumber", connection, Q_ARG(int, 0));
+        }
+
+        QMetaObject::invokeMethod(device, "transferReset", connection);
+        QMetaObject::invokeMethod(device, "resetButtonDownCount", connection);
+        QMetaObject::invokeMethod(device, "reInitButtons", connection);
+
+        QMetaObject::invokeMethod(device, "establishPropertyUpdatedConnection", connection);
+    }
+
+    QVariantMap response = createResponse(LocalAntiMicroProtocol::StatusOk);
+    response.insert("devices", devices.size());
+    return response;
+}
+
+QVariantMap LocalAntiMicroCommandHandler::queryStatus()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QVariantList deviceList;
+
+    QMapIterator<SDL_JoystickID, InputDevice*> iter(*joysticks);
+    while (iter.hasNext())
+    {
+        InputDevice *device = iter.next().value();
+        if (device != nullptr)
+        {
+            QVariantMap temp;
+            temp.insert("number", device->getRealJoyNumber());
+            temp.insert("name", device->getSDLName());
+            temp.insert("guid", device->getGUIDString());
+            temp.insert("gameController", device->isGameController());
+            temp.insert("set", device->getActiveSetNumber() + 1);
+            temp.insert("profile", device->getProfileName());
+            temp.insert("edited", device->isDeviceEdited());
+            deviceList.append(temp);
+        }
+    }
+
+    QVariantMap response = createResponse(LocalAntiMicroProtocol::StatusOk);
+    response.insert("devices", deviceList);
+    return response;
+}
+
+QVariantMap LocalAntiMicroCommandHandler::readStats()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QVariantMap response = createResponse(LocalAntiMicroProtocol::StatusOk);
+    response.insert("uptimeMsecs", uptimeTimer.elapsed());
+    response.insert("connectedDevices", joysticks->size());
+    response.insert("connectedClients", clientBuffers.size());
+    response.insert("requests", requestCount);
+    response.insert("failedRequests", failedRequestCount);
+    response.insert("lastRequestUsecs", lastRequestNsecs / 1000.0);
+    response.insert("averageRequestUsecs", (requestCount > 0) ?
+                        (totalRequestNsecs / static_cast<double>(requestCount)) / 1000.0 : 0.0);
+    response.insert("maxRequestUsecs", maxRequestNsecs / 1000.0);
+
+    MouseTickPacer::Stats mouseStats = JoyButton::getMouseTimerStats();
+    response.insert("mouseTimerWakeups", mouseStats.wakeups);
+    response.insert("mouseTimerIntervalMsecs", mouseStats.interval);
+    response.insert("mouseTimerWakeupsPerSecond", mouseStats.wakeupsPerSecond);
+    response.insert("mouseTimerAverageWakeupsPerSecond", mouseStats.averageWakeupsPerSecond);
+    response.insert("mouseTimerBaselineWakeupsPerSecond", mouseStats.baselineWakeupsPerSecond);
+    response.insert("mouseTimerSavedWakeupsPercent", mouseStats.savedWakeupsPercent);
+    response.insert("mouseTimerStoppedPercent", mouseStats.stoppedPercent);
+    return response;
+}
+
+QVariantMap LocalAntiMicroCommandHandler::createResponse(int status, QString error)
+{
+    QVariantMap response;
+    response.insert("status", status);
+
+    if (!error.isEmpty())
+    {
+        response.insert("error", error);
+    }
+
+    return response;
+}
@@ -0,0 +1,86 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCALANTIMICROCOMMANDHANDLER_H
+#define LOCALANTIMICROCOMMANDHANDLER_H
+
+#include <QObject>
+#include <QMap>
+#include <QHash>
+#include <QList>
+#include <QVariantMap>
+#include <QElapsedTimer>
+
+#include <SDL2/SDL_joystick.h>
+
+class InputDevice;
+class QLocalSocket;
+
+/**
+ * @brief Executes binary protocol requests received by
+ *     LocalAntiMicroServer. Instances are meant to live on the input
+ *     thread so that requests are applied to the devices directly
+ *     instead of going through the GUI.
+ */
+class LocalAntiMicroCommandHandler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LocalAntiMicroCommandHandler(QMap<SDL_JoystickID, InputDevice*> *joysticks,
+                                          QObject *parent = nullptr);
+
+    QVariantMap processRequest(quint8 command, const QVariantMap &args);
+
+protected:
+    void processClientData(QLocalSocket *socket);
+    void releaseClient(QLocalSocket *socket);
+    QList<InputDevice*> findDevices(QString controller);
+    static Qt::ConnectionType deviceConnection(InputDevice *device);
+
+    QVariantMap loadProfile(const QVariantMap &args);
+    QVariantMap changeSet(const QVariantMap &args);
+    QVariantMap unloadProfile(const QVariantMap &args);
+    QVariantMap queryStatus();
+    QVariantMap readStats();
+
+    static QVariantMap createResponse(int status, QString error = QString());
+
+signals:
+    void legacyClientDisconnected();
+
+public slots:
+    void addClient(QLocalSocket *socket);
+
+private slots:
+    void readClientData();
+    void removeClient();
+
+private:
+    QMap<SDL_JoystickID, InputDevice*> *joysticks;
+    QHash<QLocalSocket*, QByteArray> clientBuffers;
+    QHash<QLocalSocket*, bool> protocolClients;
+
+    QElapsedTimer uptimeTimer;
+    qint64 requestCount;
+    qint64 failedRequestCount;
+    qint64 lastRequestNsecs;
+    qint64 totalRequestNsecs;
+    qint64 maxRequestNsecs;
+};
+
+#endif // LOCALANTIMICROCOMMANDHANDLER_H
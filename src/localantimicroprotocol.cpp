@@ -0,0 +1,165 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "localantimicroprotocol.h"
+
+#include <QDataStream>
+#include <QIODevice>
+#include <QtEndian>
+
+
+namespace LocalAntiMicroProtocol
+{
+    QByteArray encodeFrame(quint8 command, const QVariantMap &payload)
+    {
+        QByteArray body;
+        QDataStream stream(&body, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << payload;
+
+        QByteArray frame(headerSize, '\0');
+        uchar *header = reinterpret_cast<uchar*>(frame.data());
+        qToBigEndian<quint16>(frameMagic, header);
+        header[2] = protocolVersion;
+        header[3] = command;
+        qToBigEndian<quint32>(static_cast<quint32>(body.size()), header + 4);
+
+        frame.append(body);
+        return frame;
+    }
+
+    FrameResult decodeFrame(QByteArray &buffer, quint8 &command, QVariantMap &payload)
+    {
+        if (buffer.size() < headerSize)
+        {
+            return FrameIncomplete;
+        }
+
+        const uchar *header = reinterpret_cast<const uchar*>(buffer.constData());
+        if ((qFromBigEndian<quint16>(header) != frameMagic) ||
+            (header[2] != protocolVersion))
+        {
+            return FrameInvalid;
+        }
+
+        quint32 payloadSize = qFromBigEndian<quint32>(header + 4);
+        if (payloadSize > maxPayloadSize)
+        {
+            return FrameInvalid;
+        }
+        else if (static_cast<quint32>(buffer.size() - headerSize) < payloadSize)
+        {
+            return FrameIncomplete;
+        }
+
+        command = header[3];
+
+        QByteArray body = buffer.mid(headerSize, static_cast<int>(payloadSize));
+        buffer.remove(0, headerSize + static_cast<int>(payloadSize));
+
+        payload.clear();
+        if (!body.isEmpty())
+        {
+            QDataStream stream(body);
+            stream.setVersion(QDataStream::Qt_5_0);
+            stream >> payload;
+
+            if (stream.status() != QDataStream::Ok)
+            {
+                return FrameInvalid;
+            }
+        }
+
+        return FrameComplete;
+    }
+
+    bool writeFrame(QIODevice *device, quint8 command, const QVariantMap &payload)
+    {
+        QByteArray frame = encodeFrame(command, payload);
+        return device->write(frame) == frame.size();
+    }
+
+    QString commandName(quint8 command)
+    {
+        QString temp = QString();
+
+        switch (command)
+        {
+            case LoadProfile:
+                temp = "load";
+                break;
+            case ChangeSet:
+                temp = "set";
+                break;
+            case UnloadProfile:
+                temp = "unload";
+                break;
+            case QueryStatus:
+                temp = "status";
+                break;
+            case ReadStats:
+                temp = "stats";
+                break;
+            default:
+                temp = "invalid";
+                break;
+        }
+
+        return temp;
+    }
+
+    quint8 commandFromName(const QString &name)
+    {
+        quint8 command = InvalidCommand;
+
+        for (quint8 i = LoadProfile; (i <= ReadStats) && (command == InvalidCommand); i++)
+        {
+            if (commandName(i) == name)
+            {
+                command = i;
+            }
+        }
+
+        return command;
+    }
+
+    QString statusName(int status)
+    {
+        QString temp = QString();
+
+        switch (status)
+        {
+            case StatusOk:
+                temp = "ok";
+                break;
+            case StatusBadRequest:
+                temp = "bad request";
+                break;
+            case StatusNoDevice:
+                temp = "no matching controller";
+                break;
+            case StatusProfileError:
+                temp = "profile error";
+                break;
+            default:
+                temp = "unsupported";
+                break;
+        }
+
+        return temp;
+    }
+}
@@ -0,0 +1,73 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCALANTIMICROPROTOCOL_H
+#define LOCALANTIMICROPROTOCOL_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QVariantMap>
+#include <QString>
+
+class QIODevice;
+
+/**
+ * @brief Framing used for commands sent to a running instance over
+ *     the local socket. Every frame starts with an 8 byte header
+ *     (magic, version, command, payload length in big endian order)
+ *     followed by a QDataStream serialized QVariantMap payload.
+ */
+namespace LocalAntiMicroProtocol
+{
+    const quint16 frameMagic = 0x414D; // "AM"
+    const quint8 protocolVersion = 1;
+    const int headerSize = 8;
+    const quint32 maxPayloadSize = 1 << 20;
+
+    enum Command {
+        InvalidCommand = 0,
+        LoadProfile = 1,
+        ChangeSet = 2,
+        UnloadProfile = 3,
+        QueryStatus = 4,
+        ReadStats = 5
+    };
+
+    enum ResponseStatus {
+        StatusOk = 0,
+        StatusBadRequest,
+        StatusNoDevice,
+        StatusProfileError,
+        StatusUnsupported
+    };
+
+    enum FrameResult {
+        FrameIncomplete = 0,
+        FrameComplete,
+        FrameInvalid
+    };
+
+    QByteArray encodeFrame(quint8 command, const QVariantMap &payload);
+    FrameResult decodeFrame(QByteArray &buffer, quint8 &command, QVariantMap &payload);
+    bool writeFrame(QIODevice *device, quint8 command, const QVariantMap &payload);
+
+    QString commandName(quint8 command);
+    quint8 commandFromName(const QString &name);
+    QString statusName(int status);
+}
+
+#endif // LOCALANTIMICROPROTOCOL_H
@@ -18,6 +18,7 @@
 #include "localantimicroserver.h"
 
 #include "messagehandler.h"
+#include "localantimicrocommandhandler.h"
 #include "common.h"
 
 #include <QTextStream>
@@ -32,6 +33,7 @@ LocalAntiMicroServer::LocalAntiMicroServer(QObject *parent) :
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     localServer = new QLocalServer(this);
+    commandHandler = nullptr;
 }
 
 void LocalAntiMicroServer::startLocalServer()
@@ -58,7 +60,15 @@ void LocalAntiMicroServer::handleOutsideConnection()
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
     QLocalSocket *socket = localServer->nextPendingConnection();
-    if (socket != nullptr)
+    if ((socket != nullptr) && (commandHandler != nullptr))
+    {
+        // Hand the connection over to the command handler thread so
+        // protocol requests never touch the GUI thread.
+        socket->setParent(nullptr);
+        socket->moveToThread(commandHandler->thread());
+        emit clientConnected(socket);
+    }
+    else if (socket != nullptr)
     {
         connect(socket, &QLocalSocket::disconnected, this, &LocalAntiMicroServer::handleSocketDisconnect);
         connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
@@ -83,3 +93,29 @@ QLocalServer* LocalAntiMicroServer::getLocalServer() const {
 
     return localServer;
 }
+
+void LocalAntiMicroServer::setCommandHandler(LocalAntiMicroCommandHandler *handler)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (commandHandler != nullptr)
+    {
+        disconnect(this, &LocalAntiMicroServer::clientConnected, commandHandler, nullptr);
+        disconnect(commandHandler, &LocalAntiMicroCommandHandler::legacyClientDisconnected, this, nullptr);
+    }
+
+    commandHandler = handler;
+
+    if (commandHandler != nullptr)
+    {
+        connect(this, &LocalAntiMicroServer::clientConnected, commandHandler,
+                &LocalAntiMicroCommandHandler::addClient, Qt::QueuedConnection);
+        connect(commandHandler, &LocalAntiMicroCommandHandler::legacyClientDisconnected,
+                this, &LocalAntiMicroServer::handleSocketDisconnect);
+    }
+}
+
+LocalAntiMicroCommandHandler* LocalAntiMicroServer::getCommandHandler() const {
+
+    return commandHandler;
+}
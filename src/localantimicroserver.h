@@ -22,6 +22,8 @@
 
 
 class QLocalServer;
+class QLocalSocket;
+class LocalAntiMicroCommandHandler;
 
 class LocalAntiMicroServer : public QObject
 {
@@ -32,9 +34,12 @@ public:
 
     QLocalServer* getLocalServer() const;
 
+    void setCommandHandler(LocalAntiMicroCommandHandler *handler);
+    LocalAntiMicroCommandHandler* getCommandHandler() const;
 
 signals:
     void clientdisconnect();
+    void clientConnected(QLocalSocket *socket);
 
 public slots:
     void startLocalServer();
@@ -44,6 +49,7 @@ public slots:
 
 private:
     QLocalServer *localServer;
+    LocalAntiMicroCommandHandler *commandHandler;
 
 };
 
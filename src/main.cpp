@@ -20,14 +20,19 @@
 #include "setjoystick.h"
 #include "simplekeygrabberbutton.h"
 #include "joybuttonslot.h"
+#include "joybutton.h"
 #include "inputdaemon.h"
 #include "common.h"
 #include "commandlineutility.h"
 #include "autoprofileinfo.h"
 #include "localantimicroserver.h"
+#include "processlauncher.h"
+#include "textentrystreamer.h"
+#include "localantimicrocommandhandler.h"
 #include "antimicrosettings.h"
 #include "applaunchhelper.h"
 #include "antkeymapper.h"
+#include "startuptrace.h"
 
 #include "eventhandlerfactory.h"
 #include "messagehandler.h"
@@ -122,6 +127,7 @@ int main(int argc, char *argv[])
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
+    StartupTrace::start();
 
     QApplication antimicro(argc, argv);
     QCoreApplication::setApplicationName("antimicro");
@@ -142,6 +148,8 @@ int main(int argc, char *argv[])
     }
 #endif
 
+    StartupTrace::mark(QString("Application setup"));
+
     QFile logFile;
     QTextStream logFileStream;
     
@@ -205,6 +213,8 @@ int main(int argc, char *argv[])
                 "xtest"}, // default
             {{"list","l"},
                 QCoreApplication::translate("main", "Print information about joysticks detected by SDL. Use only if you have sdl library. You can check your controller index, name or even GUID.")},
+            {"startup-trace",
+                QCoreApplication::translate("main", "Log how long each startup phase takes. Raises the log level to info if needed.")},
            // {"display",
            //     QCoreApplication::translate("main", "Use specified display for X11 calls")},
            // {"next",
@@ -235,6 +245,9 @@ int main(int argc, char *argv[])
       appLogger.setCurrentErrorStream(nullptr);
     }
 
+    StartupTrace::setEnabled(cmdutility.isStartupTraceEnabled());
+    StartupTrace::mark(QString("Command line parsing"));
+
     Q_INIT_RESOURCE(resources);
 
 
@@ -499,6 +512,8 @@ int main(int argc, char *argv[])
     QIcon::setThemeName("/");
 #endif
 
+    StartupTrace::mark(QString("Instance check and local server"));
+
     AntiMicroSettings *settings = new AntiMicroSettings(PadderCommon::configFilePath(),
                                                         QSettings::IniFormat);
     settings->importFromCommandLine(cmdutility);
@@ -514,6 +529,14 @@ int main(int argc, char *argv[])
       appLogger.setCurrentErrorStream(nullptr);
     }
 
+    // The startup trace is written as info messages.
+    if (StartupTrace::isEnabled() && (appLogger.getCurrentLogLevel() < Logger::LOG_INFO))
+    {
+        appLogger.setLogLevel(Logger::LOG_INFO);
+    }
+
+    StartupTrace::mark(QString("Settings import"));
+
     QString targetLang = QLocale::system().name();
     if (settings->contains("Language"))
     {
@@ -541,6 +564,8 @@ int main(int argc, char *argv[])
 #endif
     antimicro.installTranslator(&myappTranslator);
 
+    StartupTrace::mark(QString("Translator loading"));
+
 #ifndef Q_OS_WIN
     // Have program handle SIGTERM
     struct sigaction termaction;
@@ -614,6 +639,8 @@ int main(int argc, char *argv[])
 
         joypad_worker->moveToThread(inputEventThread);
         PadderCommon::mouseHelperObj.moveToThread(inputEventThread);
+        ProcessLauncher::createInstance();
+        TextEntryStreamer::createInstance(inputEventThread);
         inputEventThread->start(QThread::HighPriority);
 
         int app_result = antimicro.exec();
@@ -636,6 +663,9 @@ int main(int argc, char *argv[])
         delete inputEventThread;
         inputEventThread = nullptr;
 
+        ProcessLauncher::deleteInstance();
+        TextEntryStreamer::deleteInstance();
+
 #ifdef WITH_X11
 
         if (QApplication::platformName() == QStringLiteral("xcb"))
@@ -663,8 +693,22 @@ int main(int argc, char *argv[])
     {
         eventGeneratorIdentifier = factory->handler()->getIdentifier();
         keyMapper = AntKeyMapper::getInstance(eventGeneratorIdentifier);
-        status = factory->handler()->init();
+        StartupTrace::mark(QString("Key mapper"));
+
+        // Virtual input devices get created while SDL starts up and
+        // ingests the stored controller mappings.
+        factory->startHandlerInit();
+    }
+
+    PadderCommon::mouseHelperObj.initDeskWid();
+    InputDaemon *joypad_worker = new InputDaemon(joysticks, settings);
+    StartupTrace::mark(QString("SDL init and device scan"));
+
+    if (factory)
+    {
+        status = factory->waitHandlerInit();
         factory->handler()->printPostMessages();
+        StartupTrace::mark(QString("Event generator wait"));
     }
 
 #if (defined(Q_OS_UNIX) && defined(WITH_UINPUT) && defined(WITH_XTEST)) || \
@@ -704,10 +748,15 @@ int main(int argc, char *argv[])
         appLogger.LogError(QObject::trUtf8("Failed to open event generator. Exiting."));
         appLogger.Log();
 
-        deleteInputDevices(joysticks);
+        joypad_worker->quit();
+        joypad_worker->deleteJoysticks();
+
         delete joysticks;
         joysticks = nullptr;
 
+        delete joypad_worker;
+        joypad_worker = nullptr;
+
         delete localServer;
         localServer = nullptr;
 
@@ -734,11 +783,16 @@ int main(int argc, char *argv[])
                           .arg(factory->handler()->getName()));
     }
 
-    PadderCommon::mouseHelperObj.initDeskWid();
-    InputDaemon *joypad_worker = new InputDaemon(joysticks, settings);
+    JoyButton::setPressedKeyCodeRange(factory->handler()->getKeyCodeRange());
+
     inputEventThread = new QThread();
 
+    // Protocol requests from other processes are executed on
+    // the input thread next to the devices they act on.
+    LocalAntiMicroCommandHandler *commandHandler = new LocalAntiMicroCommandHandler(joysticks);
+
     MainWindow *w = new MainWindow(joysticks, &cmdutility, settings);
+    StartupTrace::mark(QString("Main window"));
 
     w->setAppTranslator(&qtTranslator);
     w->setTranslator(&myappTranslator);
@@ -791,6 +845,11 @@ int main(int argc, char *argv[])
     QTimer::singleShot(0, [w]() { w->fillButtons(); });
     QTimer::singleShot(0, w, &MainWindow::alterConfigFromSettings);
     QTimer::singleShot(0, w, &MainWindow::changeWindowStatus);
+    // Runs after the profiles above have been loaded.
+    QTimer::singleShot(0, []() {
+        StartupTrace::mark(QString("Profile loading"));
+        StartupTrace::report();
+    });
 
     mainAppHelper.changeMouseThread(inputEventThread);
 
@@ -798,7 +857,12 @@ int main(int argc, char *argv[])
 
     joypad_worker->moveToThread(inputEventThread);
     PadderCommon::mouseHelperObj.moveToThread(inputEventThread);
+    commandHandler->moveToThread(inputEventThread);
+    localServer->setCommandHandler(commandHandler);
+    ProcessLauncher::createInstance();
+    TextEntryStreamer::createInstance(inputEventThread);
     inputEventThread->start(QThread::HighPriority);
+    StartupTrace::mark(QString("Input thread start"));
 
     int app_result = antimicro.exec();
 
@@ -815,9 +879,15 @@ int main(int argc, char *argv[])
     inputEventThread->quit();
     inputEventThread->wait();
 
+    delete commandHandler;
+    commandHandler = nullptr;
+
     delete inputEventThread;
     inputEventThread = nullptr;
 
+    ProcessLauncher::deleteInstance();
+    TextEntryStreamer::deleteInstance();
+
     delete joysticks;
     joysticks = nullptr;
 
@@ -833,6 +903,8 @@ int main(int argc, char *argv[])
 
 #endif
 
+    // Nothing should be left pressed once the devices are gone.
+    JoyButton::releaseAllPressedKeys();
     EventHandlerFactory::getInstance()->handler()->cleanup();
     EventHandlerFactory::getInstance()->deleteInstance();
 
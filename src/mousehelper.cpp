@@ -20,8 +20,18 @@
 #include "messagehandler.h"
 
 #include <QDesktopWidget>
+#include <QApplication>
+#include <QCursor>
 #include <QDebug>
 
+#if defined(Q_OS_UNIX) && defined(WITH_X11)
+  #include "x11extras.h"
+#endif
+
+// Time in ms a predicted spring cursor position is used before the real
+// position is read again.
+const int MouseHelper::SPRINGCURSORSYNCINTERVAL = 250;
+
 MouseHelper::MouseHelper(QObject *parent) :
     QObject(parent)
 {
@@ -32,6 +42,7 @@ MouseHelper::MouseHelper(QObject *parent) :
     previousCursorLocation[1] = 0;
     pivotPoint[0] = -1;
     pivotPoint[1] = -1;
+    springCursorKnown = false;
     mouseTimer.setParent(this);
     mouseTimer.setSingleShot(true);
     QObject::connect(&mouseTimer, &QTimer::timeout, this, &MouseHelper::resetSpringMouseMoving);
@@ -71,3 +82,55 @@ QDesktopWidget* MouseHelper::getDesktopWidget() const
 
     return deskWid;
 }
+
+/**
+ * @brief Cursor position used by spring mode. The real position is read
+ *     when spring mode starts and every SPRINGCURSORSYNCINTERVAL ms. In
+ *     between the destination of the last spring move is used so an
+ *     update does not need a round trip to the X server.
+ * @return Current or predicted cursor position
+ */
+QPoint MouseHelper::getSpringCursorPos()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (!springCursorKnown || springCursorSyncTime.hasExpired(SPRINGCURSORSYNCINTERVAL))
+    {
+#if defined(Q_OS_UNIX) && defined(WITH_X11)
+        if (QApplication::platformName() == QStringLiteral("xcb"))
+        {
+            springCursorPos = X11Extras::getInstance()->getPos();
+        }
+        else
+        {
+            springCursorPos = QCursor::pos();
+        }
+#else
+        springCursorPos = QCursor::pos();
+#endif
+
+        springCursorKnown = true;
+        springCursorSyncTime.start();
+    }
+
+    return springCursorPos;
+}
+
+void MouseHelper::setSpringCursorPos(int x, int y)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    springCursorPos = QPoint(x, y);
+}
+
+/**
+ * @brief Make the next spring update read the real cursor position.
+ *     Used once a spring is released since the cursor is free to move
+ *     until the next one starts.
+ */
+void MouseHelper::invalidateSpringCursorPos()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    springCursorKnown = false;
+}
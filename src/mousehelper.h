@@ -20,6 +20,8 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QPoint>
+#include <QElapsedTimer>
 
 class QDesktopWidget;
 
@@ -35,6 +37,12 @@ public:
     int pivotPoint[2];
     QTimer mouseTimer;
 
+    QPoint getSpringCursorPos();
+    void setSpringCursorPos(int x, int y);
+    void invalidateSpringCursorPos();
+
+    static const int SPRINGCURSORSYNCINTERVAL;
+
 public slots:
     void deleteDeskWid();
     void initDeskWid();
@@ -44,6 +52,11 @@ private slots:
 
 private:
     QDesktopWidget *deskWid;
+
+    // Cursor position predicted from the last spring move.
+    QPoint springCursorPos;
+    bool springCursorKnown;
+    QElapsedTimer springCursorSyncTime;
 };
 
 #endif // MOUSEHELPER_H
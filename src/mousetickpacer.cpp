@@ -0,0 +1,257 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mousetickpacer.h"
+
+#include <QMutexLocker>
+
+#include <cmath>
+
+const int MouseTickPacer::STOPPED = -1;
+
+// Number of unchanged ticks before the interval is doubled again.
+const int MouseTickPacer::QUIETTICKS = 8;
+
+// Longest interval used while the cursor keeps moving at a constant rate.
+// Distances are scaled by the elapsed time so the speed does not change,
+// only the step size.
+const int MouseTickPacer::MAXCONSTANTINTERVAL = 16;
+
+// Longest interval used while mouse elements are active but produce no
+// movement, like a stick resting just outside its dead zone.
+const int MouseTickPacer::MAXZEROINTERVAL = 50;
+
+static const double ABSOLUTERATETOLERANCE = 0.001;
+static const double RELATIVERATETOLERANCE = 0.02;
+
+
+MouseTickPacer::MouseTickPacer()
+{
+    running = false;
+    interval = 0;
+    quietTicks = 0;
+
+    cursorX = cursorY = 0.0;
+    lastCursorX = lastCursorY = 0.0;
+    springX = springY = 0;
+    springMoved = false;
+    lastSpringX = lastSpringY = 0;
+    wheelMoved = false;
+
+    wakeups = 0;
+    windowWakeups = 0;
+    lastWindowRate = 0.0;
+    runningMsecs = 0;
+    stoppedMsecs = 0;
+    stateTimer.start();
+    windowTimer.start();
+}
+
+/**
+ * @brief Add the time since the last state change to the running or
+ *     stopped total. Caller must hold the mutex.
+ */
+void MouseTickPacer::accountStateTime()
+{
+    qint64 elapsed = stateTimer.restart();
+    if (running)
+    {
+        runningMsecs += elapsed;
+    }
+    else
+    {
+        stoppedMsecs += elapsed;
+    }
+}
+
+/**
+ * @brief Go back to the full refresh rate. Called when the timer is
+ *     started for a newly activated mouse element, when a held mouse
+ *     element changes deflection or when the refresh rate is changed.
+ */
+void MouseTickPacer::wake()
+{
+    QMutexLocker locker(&mutex);
+
+    accountStateTime();
+    running = true;
+    interval = 0;
+    quietTicks = 0;
+}
+
+/**
+ * @brief Record the cursor movement generated in the current tick.
+ * @param Horizontal movement in pixels per millisecond
+ * @param Vertical movement in pixels per millisecond
+ */
+void MouseTickPacer::addCursorOutput(double rateX, double rateY)
+{
+    QMutexLocker locker(&mutex);
+
+    cursorX = rateX;
+    cursorY = rateY;
+}
+
+/**
+ * @brief Record the spring mode position sent in the current tick.
+ */
+void MouseTickPacer::addSpringOutput(int x, int y)
+{
+    QMutexLocker locker(&mutex);
+
+    springX = x;
+    springY = y;
+    springMoved = true;
+}
+
+/**
+ * @brief Record that wheel movement was sent in the current tick.
+ *     Smooth scrolling keeps the tick from backing off to the
+ *     interval used for resting elements.
+ */
+void MouseTickPacer::addWheelOutput()
+{
+    QMutexLocker locker(&mutex);
+
+    wheelMoved = true;
+}
+
+/**
+ * @brief Compare the output of the finished tick against the previous one
+ *     and decide on the interval for the next tick.
+ * @param Whether any mouse bound element or queued mouse event remains
+ * @param Interval used at the full mouse refresh rate
+ * @return Interval for the next tick or STOPPED when the timer can be
+ *     shut down.
+ */
+int MouseTickPacer::finishTick(bool active, int fullInterval)
+{
+    QMutexLocker locker(&mutex);
+
+    wakeups++;
+    windowWakeups++;
+    if (windowTimer.elapsed() >= 1000)
+    {
+        lastWindowRate = (windowWakeups * 1000.0) / windowTimer.restart();
+        windowWakeups = 0;
+    }
+
+    int result = STOPPED;
+
+    if (active)
+    {
+        double toleranceX = qMax(ABSOLUTERATETOLERANCE,
+                                 RELATIVERATETOLERANCE * qMax(fabs(cursorX), fabs(lastCursorX)));
+        double toleranceY = qMax(ABSOLUTERATETOLERANCE,
+                                 RELATIVERATETOLERANCE * qMax(fabs(cursorY), fabs(lastCursorY)));
+
+        bool changed = (fabs(cursorX - lastCursorX) > toleranceX) ||
+                       (fabs(cursorY - lastCursorY) > toleranceY);
+
+        if (springMoved && ((springX != lastSpringX) || (springY != lastSpringY)))
+        {
+            changed = true;
+        }
+
+        bool zeroOutput = (fabs(cursorX) < ABSOLUTERATETOLERANCE) &&
+                          (fabs(cursorY) < ABSOLUTERATETOLERANCE) &&
+                          !springMoved && !wheelMoved;
+
+        if (!running)
+        {
+            accountStateTime();
+            running = true;
+        }
+
+        int currentInterval = qMax(interval, fullInterval);
+        if (changed)
+        {
+            quietTicks = 0;
+            currentInterval = fullInterval;
+        }
+        else if (++quietTicks >= QUIETTICKS)
+        {
+            int maxInterval = qMax(fullInterval, zeroOutput ? MAXZEROINTERVAL : MAXCONSTANTINTERVAL);
+            currentInterval = qMin(qMax(currentInterval * 2, 1), maxInterval);
+            quietTicks = 0;
+        }
+
+        interval = currentInterval;
+        result = currentInterval;
+    }
+    else
+    {
+        if (running)
+        {
+            accountStateTime();
+            running = false;
+        }
+
+        interval = 0;
+        quietTicks = 0;
+    }
+
+    lastCursorX = cursorX;
+    lastCursorY = cursorY;
+    if (springMoved)
+    {
+        lastSpringX = springX;
+        lastSpringY = springY;
+    }
+
+    cursorX = cursorY = 0.0;
+    springMoved = false;
+    wheelMoved = false;
+
+    return result;
+}
+
+/**
+ * @brief Summarize timer wakeups. The baseline is the number of wakeups
+ *     a timer running at the full rate while active and at the idle rate
+ *     otherwise would have needed over the same time.
+ * @param Interval used at the full mouse refresh rate
+ * @param Interval the fixed rate timer uses while idle
+ */
+MouseTickPacer::Stats MouseTickPacer::getStats(int fullInterval, int idleInterval)
+{
+    QMutexLocker locker(&mutex);
+
+    accountStateTime();
+
+    Stats stats;
+    stats.wakeups = wakeups;
+    stats.interval = running ? qMax(interval, fullInterval) : STOPPED;
+
+    // Once the timer stops the current window never rolls over, so let
+    // its rate decay with the time that keeps passing.
+    qint64 windowElapsed = windowTimer.elapsed();
+    stats.wakeupsPerSecond = (windowElapsed >= 1000) ?
+                (windowWakeups * 1000.0) / windowElapsed : lastWindowRate;
+
+    qint64 totalMsecs = runningMsecs + stoppedMsecs;
+    stats.averageWakeupsPerSecond = (totalMsecs > 0) ? (wakeups * 1000.0) / totalMsecs : 0.0;
+    stats.stoppedPercent = (totalMsecs > 0) ? (stoppedMsecs * 100.0) / totalMsecs : 0.0;
+
+    double baselineWakeups = (runningMsecs / static_cast<double>(qMax(fullInterval, 1))) +
+                             (stoppedMsecs / static_cast<double>(qMax(idleInterval, 1)));
+    stats.baselineWakeupsPerSecond = (totalMsecs > 0) ? (baselineWakeups * 1000.0) / totalMsecs : 0.0;
+    stats.savedWakeupsPercent = (baselineWakeups > 0.0) ?
+                qMax(0.0, 100.0 * (1.0 - (wakeups / baselineWakeups))) : 0.0;
+
+    return stats;
+}
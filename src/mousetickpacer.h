@@ -0,0 +1,89 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOUSETICKPACER_H
+#define MOUSETICKPACER_H
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+#include <QMutex>
+
+/**
+ * @brief Pacing policy for the shared mouse event timer. The timer runs
+ *     at the full mouse refresh rate while the generated output changes,
+ *     backs off in steps while it stays constant or zero and is stopped
+ *     once no mouse bound element is active. Wakeups are counted so the
+ *     savings against a fixed rate timer can be reported.
+ */
+class MouseTickPacer
+{
+public:
+    struct Stats
+    {
+        qint64 wakeups;
+        double wakeupsPerSecond;
+        double averageWakeupsPerSecond;
+        double baselineWakeupsPerSecond;
+        double savedWakeupsPercent;
+        double stoppedPercent;
+        int interval;
+    };
+
+    MouseTickPacer();
+
+    void wake();
+    void addCursorOutput(double rateX, double rateY);
+    void addSpringOutput(int x, int y);
+    void addWheelOutput();
+    int finishTick(bool active, int fullInterval);
+
+    Stats getStats(int fullInterval, int idleInterval);
+
+    static const int STOPPED;
+    static const int QUIETTICKS;
+    static const int MAXCONSTANTINTERVAL;
+    static const int MAXZEROINTERVAL;
+
+private:
+    void accountStateTime();
+
+    QMutex mutex;
+    bool running;
+    int interval;
+    int quietTicks;
+
+    double cursorX;
+    double cursorY;
+    double lastCursorX;
+    double lastCursorY;
+    int springX;
+    int springY;
+    bool springMoved;
+    int lastSpringX;
+    int lastSpringY;
+    bool wheelMoved;
+
+    qint64 wakeups;
+    qint64 windowWakeups;
+    double lastWindowRate;
+    qint64 runningMsecs;
+    qint64 stoppedMsecs;
+    QElapsedTimer stateTimer;
+    QElapsedTimer windowTimer;
+};
+
+#endif // MOUSETICKPACER_H
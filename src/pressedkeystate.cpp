@@ -0,0 +1,215 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pressedkeystate.h"
+
+#include <QHashIterator>
+#include <QtAlgorithms>
+
+static const quint16 MAXCOUNT = 0xFFFF;
+
+
+PressedKeyState::PressedKeyState(int codeRange)
+{
+    range = 0;
+    pressedCodes = 0;
+    resize(codeRange);
+}
+
+/**
+ * @brief Change the size of the dense part of the table. Any pressed
+ *     state is dropped.
+ * @param Number of codes, starting at 0, stored without hashing
+ */
+void PressedKeyState::resize(int codeRange)
+{
+    range = qMax(codeRange, 0);
+    pressedBits.fill(0, (range + 63) / 64);
+    counts.fill(0, range);
+    overflowCounts.clear();
+    pressedCodes = 0;
+}
+
+void PressedKeyState::clear()
+{
+    pressedBits.fill(0);
+    counts.fill(0);
+    overflowCounts.clear();
+    pressedCodes = 0;
+}
+
+/**
+ * @brief Add a reference to a code.
+ * @param Native code
+ * @return Number of references held after the press
+ */
+int PressedKeyState::press(int code)
+{
+    int result = 0;
+
+    if ((code >= 0) && (code < range))
+    {
+        quint16 &current = counts[code];
+        if (current == 0)
+        {
+            pressedBits[code >> 6] |= (Q_UINT64_C(1) << (code & 63));
+            pressedCodes++;
+        }
+
+        if (current < MAXCOUNT)
+        {
+            current++;
+        }
+
+        result = current;
+    }
+    else
+    {
+        result = overflowCounts.value(code, 0) + 1;
+        if (result == 1)
+        {
+            pressedCodes++;
+        }
+
+        overflowCounts.insert(code, result);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Drop a reference to a code. Releasing a code that is not
+ *     pressed is treated like releasing the last reference.
+ * @param Native code
+ * @return Number of references left. 0 means the code should be released.
+ */
+int PressedKeyState::release(int code)
+{
+    int result = 0;
+
+    if ((code >= 0) && (code < range))
+    {
+        quint16 &current = counts[code];
+        if (current > 1)
+        {
+            current--;
+            result = current;
+        }
+        else if (current == 1)
+        {
+            current = 0;
+            pressedBits[code >> 6] &= ~(Q_UINT64_C(1) << (code & 63));
+            pressedCodes--;
+        }
+    }
+    else
+    {
+        QHash<int, int>::iterator iter = overflowCounts.find(code);
+        if (iter != overflowCounts.end())
+        {
+            result = iter.value() - 1;
+            if (result <= 0)
+            {
+                overflowCounts.erase(iter);
+                pressedCodes--;
+                result = 0;
+            }
+            else
+            {
+                iter.value() = result;
+            }
+        }
+    }
+
+    return result;
+}
+
+bool PressedKeyState::isPressed(int code) const
+{
+    bool result = false;
+
+    if ((code >= 0) && (code < range))
+    {
+        result = (pressedBits.at(code >> 6) & (Q_UINT64_C(1) << (code & 63))) != 0;
+    }
+    else
+    {
+        result = overflowCounts.contains(code);
+    }
+
+    return result;
+}
+
+int PressedKeyState::count(int code) const
+{
+    int result = 0;
+
+    if ((code >= 0) && (code < range))
+    {
+        result = counts.at(code);
+    }
+    else
+    {
+        result = overflowCounts.value(code, 0);
+    }
+
+    return result;
+}
+
+bool PressedKeyState::isEmpty() const
+{
+    return pressedCodes == 0;
+}
+
+int PressedKeyState::codeRange() const
+{
+    return range;
+}
+
+/**
+ * @brief Collect every pressed code. The dense part is walked one 64 bit
+ *     word at a time so idle regions cost one comparison per word.
+ * @return Pressed codes in ascending order followed by hashed codes
+ */
+QList<int> PressedKeyState::snapshot() const
+{
+    QList<int> result;
+
+    if (pressedCodes > 0)
+    {
+        result.reserve(pressedCodes);
+
+        for (int i = 0; i < pressedBits.size(); i++)
+        {
+            quint64 word = pressedBits.at(i);
+            while (word != 0)
+            {
+                result.append((i * 64) + static_cast<int>(qCountTrailingZeroBits(word)));
+                word &= (word - 1);
+            }
+        }
+
+        QHashIterator<int, int> iter(overflowCounts);
+        while (iter.hasNext())
+        {
+            iter.next();
+            result.append(iter.key());
+        }
+    }
+
+    return result;
+}
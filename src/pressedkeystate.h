@@ -0,0 +1,57 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRESSEDKEYSTATE_H
+#define PRESSEDKEYSTATE_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QHash>
+#include <QList>
+
+/**
+ * @brief Reference counted set of pressed native codes. Codes below the
+ *     configured range are kept in a bitmap and a counter array indexed
+ *     by code. Anything outside the range falls back to a hash.
+ */
+class PressedKeyState
+{
+public:
+    explicit PressedKeyState(int codeRange = 0);
+
+    void resize(int codeRange);
+    void clear();
+
+    int press(int code);
+    int release(int code);
+
+    bool isPressed(int code) const;
+    int count(int code) const;
+    bool isEmpty() const;
+    int codeRange() const;
+
+    QList<int> snapshot() const;
+
+private:
+    int range;
+    int pressedCodes;
+    QVector<quint64> pressedBits;
+    QVector<quint16> counts;
+    QHash<int, int> overflowCounts;
+};
+
+#endif // PRESSEDKEYSTATE_H
@@ -0,0 +1,294 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "processlauncher.h"
+
+#include "messagehandler.h"
+#include "logger.h"
+
+#include <QMutexLocker>
+#include <QMutableListIterator>
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <QFile>
+#include <QByteArray>
+#include <QVector>
+
+#include <spawn.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+extern char **environ;
+#else
+#include <QProcess>
+#endif
+
+
+ProcessLauncher* ProcessLauncher::instance = nullptr;
+
+// Maximum number of launch requests waiting for the launcher thread.
+const int ProcessLauncher::MAXQUEUEDEPTH = 16;
+
+// Interval in ms used to reap finished child processes.
+static const unsigned long REAPINTERVAL = 1000;
+
+
+ProcessLauncher::ProcessLauncher(QObject *parent) :
+    QThread(parent)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    stopRequested = false;
+}
+
+ProcessLauncher::~ProcessLauncher()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    queueLock.lock();
+    stopRequested = true;
+    queueCondition.wakeAll();
+    queueLock.unlock();
+
+    wait();
+}
+
+/**
+ * @brief Create and start the launcher thread. Has to be called at
+ *     startup before devices are processed. Execute slots can fire on
+ *     several device workers at once, so the instance is not created on
+ *     first use.
+ */
+void ProcessLauncher::createInstance()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (instance == nullptr)
+    {
+        instance = new ProcessLauncher();
+        instance->start();
+    }
+}
+
+/**
+ * @brief Get the launcher instance made by createInstance.
+ * @return ProcessLauncher instance
+ */
+ProcessLauncher* ProcessLauncher::getInstance()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return instance;
+}
+
+void ProcessLauncher::deleteInstance()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (instance != nullptr)
+    {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+/**
+ * @brief Queue a program to be launched by the launcher thread. The call
+ *     only holds the queue lock long enough to append the request.
+ * @param Path of the executable
+ * @param Pre-parsed argument list
+ * @return Whether the request was queued. Requests are rejected when the
+ *     queue is full.
+ */
+bool ProcessLauncher::queueLaunch(const QString &program, const QStringList &arguments)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    bool queued = false;
+    int depth = 0;
+
+    queueLock.lock();
+    depth = pendingRequests.size();
+    if (depth < MAXQUEUEDEPTH)
+    {
+        LaunchRequest request;
+        request.program = program;
+        request.arguments = arguments;
+        request.queuedTime.start();
+        pendingRequests.enqueue(request);
+        queueCondition.wakeOne();
+        queued = true;
+    }
+    queueLock.unlock();
+
+    if (!queued)
+    {
+        Logger::LogWarning(trUtf8("Launch queue is full (%1 pending). Dropping %2")
+                           .arg(depth).arg(program));
+    }
+
+    return queued;
+}
+
+int ProcessLauncher::getQueueDepth()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QMutexLocker locker(&queueLock);
+    return pendingRequests.size();
+}
+
+void ProcessLauncher::run()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    queueLock.lock();
+
+    while (!stopRequested)
+    {
+        if (pendingRequests.isEmpty())
+        {
+            // Wake up periodically while children are still running so
+            // they can be reaped.
+            if (runningChildren.isEmpty())
+            {
+                queueCondition.wait(&queueLock);
+            }
+            else
+            {
+                queueCondition.wait(&queueLock, REAPINTERVAL);
+            }
+        }
+
+        if (!pendingRequests.isEmpty() && !stopRequested)
+        {
+            LaunchRequest request = pendingRequests.dequeue();
+            int depth = pendingRequests.size();
+            queueLock.unlock();
+
+            qint64 waitTime = request.queuedTime.nsecsElapsed() / 1000;
+            QElapsedTimer launchTime;
+            launchTime.start();
+
+            launchProcess(request.program, request.arguments);
+
+            Logger::LogDebug(QString("Launched %1 in %2 us after %3 us in queue (queue depth %4)")
+                             .arg(request.program)
+                             .arg(launchTime.nsecsElapsed() / 1000)
+                             .arg(waitTime)
+                             .arg(depth));
+
+            queueLock.lock();
+        }
+
+        reapChildren();
+    }
+
+    queueLock.unlock();
+}
+
+/**
+ * @brief Create the child process. Called on the launcher thread only.
+ * @param Path or name of the executable
+ * @param Argument list
+ */
+void ProcessLauncher::launchProcess(const QString &program, const QStringList &arguments)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+#ifdef Q_OS_UNIX
+    QList<QByteArray> argumentBytes;
+    argumentBytes.append(QFile::encodeName(program));
+    for (int i = 0; i < arguments.size(); i++)
+    {
+        argumentBytes.append(arguments.at(i).toLocal8Bit());
+    }
+
+    QVector<char*> argv;
+    for (int i = 0; i < argumentBytes.size(); i++)
+    {
+        argv.append(argumentBytes[i].data());
+    }
+    argv.append(nullptr);
+
+    // Reset the signal state inherited from the application so the child
+    // starts out like one created by QProcess::startDetached.
+    sigset_t defaultSignals;
+    sigemptyset(&defaultSignals);
+    sigaddset(&defaultSignals, SIGPIPE);
+    sigaddset(&defaultSignals, SIGCHLD);
+
+    sigset_t signalMask;
+    sigemptyset(&signalMask);
+
+    short flags = POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK;
+#ifdef POSIX_SPAWN_SETSID
+    flags |= POSIX_SPAWN_SETSID;
+#endif
+
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setflags(&attributes, flags);
+    posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+    posix_spawnattr_setsigmask(&attributes, &signalMask);
+
+    // Bare program names are searched in PATH like QProcess does.
+    pid_t pid = 0;
+    int result = posix_spawnp(&pid, argv.at(0), nullptr, &attributes, argv.data(), environ);
+    posix_spawnattr_destroy(&attributes);
+
+    if (result == 0)
+    {
+        runningChildren.append(pid);
+    }
+    else
+    {
+        Logger::LogWarning(trUtf8("Could not launch %1: %2")
+                           .arg(program).arg(QString::fromLocal8Bit(strerror(result))));
+    }
+#else
+    if (!QProcess::startDetached(program, arguments))
+    {
+        Logger::LogWarning(trUtf8("Could not launch %1").arg(program));
+    }
+#endif
+}
+
+/**
+ * @brief Collect exit status of finished children so no zombie processes
+ *     are left behind.
+ */
+void ProcessLauncher::reapChildren()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+#ifdef Q_OS_UNIX
+    QMutableListIterator<qint64> iter(runningChildren);
+    while (iter.hasNext())
+    {
+        int status = 0;
+        pid_t result = waitpid(static_cast<pid_t>(iter.next()), &status, WNOHANG);
+        if (result != 0)
+        {
+            iter.remove();
+        }
+    }
+#endif
+}
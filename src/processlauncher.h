@@ -0,0 +1,76 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROCESSLAUNCHER_H
+#define PROCESSLAUNCHER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QList>
+#include <QStringList>
+#include <QElapsedTimer>
+
+
+/**
+ * @brief Launches external programs for execute slots on a dedicated
+ *     thread so process creation never stalls the input event thread.
+ *     Requests are kept in a bounded queue; requests that arrive while
+ *     the queue is full are dropped.
+ */
+class ProcessLauncher : public QThread
+{
+    Q_OBJECT
+
+public:
+    static void createInstance();
+    static ProcessLauncher* getInstance();
+    static void deleteInstance();
+
+    bool queueLaunch(const QString &program, const QStringList &arguments);
+    int getQueueDepth();
+
+    static const int MAXQUEUEDEPTH;
+
+protected:
+    explicit ProcessLauncher(QObject *parent = nullptr);
+    ~ProcessLauncher();
+
+    virtual void run();
+
+    void launchProcess(const QString &program, const QStringList &arguments);
+    void reapChildren();
+
+    struct LaunchRequest
+    {
+        QString program;
+        QStringList arguments;
+        QElapsedTimer queuedTime;
+    };
+
+    static ProcessLauncher *instance;
+
+private:
+    QMutex queueLock;
+    QWaitCondition queueCondition;
+    QQueue<LaunchRequest> pendingRequests;
+    QList<qint64> runningChildren;
+    bool stopRequested;
+};
+
+#endif // PROCESSLAUNCHER_H
@@ -0,0 +1,46 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILEFEATURES_H
+#define PROFILEFEATURES_H
+
+/**
+ * @brief Capabilities used by a button or a set. Computed from the
+ *     assigned slots and button properties so event processing can skip
+ *     work for features that are not in use.
+ */
+class ProfileFeatures {
+public:
+    enum Feature {
+        NoFeatures = 0,
+        KeyboardFeature = 0x1,
+        MouseButtonFeature = 0x2,
+        MouseCursorFeature = 0x4,
+        MouseSpringFeature = 0x8,
+        TurboFeature = 0x10,
+        SequenceFeature = 0x20,
+        DistanceFeature = 0x40,
+        ReleaseFeature = 0x80,
+        SetChangeFeature = 0x100,
+        OtherFeature = 0x200
+    };
+
+    static const int MouseMovementFeatures = MouseCursorFeature | MouseSpringFeature;
+    static const int MouseFeatures = MouseButtonFeature | MouseMovementFeatures;
+};
+
+#endif // PROFILEFEATURES_H
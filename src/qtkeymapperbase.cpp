@@ -19,6 +19,7 @@
 
 #include "messagehandler.h"
 
+#include <QHashIterator>
 #include <QDebug>
 
 const int QtKeyMapperBase::customQtKeyPrefix;
@@ -38,14 +39,14 @@ int QtKeyMapperBase::returnQtKey(int key, int scancode)
 
     Q_UNUSED(scancode);
 
-    return virtualKeyToQtKey.value(key);
+    return virtualKeyToQtKeyTable.value(key);
 }
 
 int QtKeyMapperBase::returnVirtualKey(int qkey)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
 
-    return qtKeyToVirtualKey.value(qkey);
+    return qtKeyToVirtualKeyTable.value(qkey);
 }
 
 bool QtKeyMapperBase::isModifier(int qkey)
@@ -83,14 +84,39 @@ QtKeyMapperBase::charKeyInformation QtKeyMapperBase::getCharKeyInformation(QChar
     temp.virtualkey = 0;
     temp.modifiers = Qt::NoModifier;
 
-    if (virtualkeyToCharKeyInformation.contains(value.unicode()))
+    int index = charKeyInformationTable.value(value.unicode());
+    if (index > 0)
     {
-        temp = virtualkeyToCharKeyInformation.value(value.unicode());
+        temp = charKeyInformationList.at(index - 1);
     }
 
     return temp;
 }
 
+/**
+ * @brief Copy populated mapping hashes into dense lookup tables. Has to be
+ *     called by subclasses after the populate methods so lookups on the
+ *     key event path do not hash.
+ */
+void QtKeyMapperBase::buildLookupTables()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    qtKeyToVirtualKeyTable.build(qtKeyToVirtualKey);
+    virtualKeyToQtKeyTable.build(virtualKeyToQtKey);
+
+    charKeyInformationTable.clear();
+    charKeyInformationList.clear();
+
+    QHashIterator<int, charKeyInformation> iter(virtualkeyToCharKeyInformation);
+    while (iter.hasNext())
+    {
+        iter.next();
+        charKeyInformationList.append(iter.value());
+        charKeyInformationTable.insert(iter.key(), charKeyInformationList.size());
+    }
+}
+
 /**
  * @brief Obtain identifier string for key mapper.
  * @return Identifier string.
@@ -18,8 +18,11 @@
 #ifndef QTKEYMAPPERBASE_H
 #define QTKEYMAPPERBASE_H
 
+#include "keytranslationtable.h"
+
 #include <QObject>
 #include <QHash>
+#include <QVector>
 
 class QtKeyMapperBase : public QObject
 {
@@ -81,11 +84,18 @@ public:
 protected:
     virtual void populateMappingHashes() = 0;
     virtual void populateCharKeyInformation() = 0;
+    void buildLookupTables();
 
     QHash<int, int> qtKeyToVirtualKey; // unsigned, unsigned
     QHash<int, int> virtualKeyToQtKey; // unsigned, unsigned
     // Unicode representation -> VK+Modifier information
     QHash<int, charKeyInformation> virtualkeyToCharKeyInformation; // unsigned, ..
+
+    // Dense copies of the hashes above used for lookups once populated.
+    KeyTranslationTable qtKeyToVirtualKeyTable;
+    KeyTranslationTable virtualKeyToQtKeyTable;
+    KeyTranslationTable charKeyInformationTable; // unicode -> index + 1
+    QVector<charKeyInformation> charKeyInformationList;
     QString identifier;
 
 };
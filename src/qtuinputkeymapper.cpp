@@ -34,6 +34,7 @@ QtUInputKeyMapper::QtUInputKeyMapper(QObject *parent) :
     identifier = "uinput";
     populateMappingHashes();
     populateCharKeyInformation();
+    buildLookupTables();
 }
 
 void QtUInputKeyMapper::populateAlphaHashes()
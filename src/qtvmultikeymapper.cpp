@@ -24,6 +24,7 @@ QtVMultiKeyMapper::QtVMultiKeyMapper(QObject *parent) :
 {
     identifier = "vmulti";
     populateMappingHashes();
+    buildLookupTables();
 }
 
 void QtVMultiKeyMapper::populateMappingHashes()
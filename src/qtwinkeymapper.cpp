@@ -116,6 +116,7 @@ QtWinKeyMapper::QtWinKeyMapper(QObject *parent) :
     identifier = "sendinput";
     populateMappingHashes();
     populateCharKeyInformation();
+    buildLookupTables();
 }
 
 void QtWinKeyMapper::populateMappingHashes()
@@ -332,7 +333,7 @@ void QtWinKeyMapper::populateMappingHashes()
 
 int QtWinKeyMapper::returnQtKey(int key, int scancode)
 {
-    int tempkey = virtualKeyToQtKey.value(key);
+    int tempkey = virtualKeyToQtKeyTable.value(key);
     int extended = scancode & WinExtras::EXTENDED_FLAG;
     if (key == VK_RETURN && extended)
     {
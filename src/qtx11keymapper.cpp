@@ -45,6 +45,7 @@ QtX11KeyMapper::QtX11KeyMapper(QObject *parent) :
     identifier = "xtest";
     populateMappingHashes();
     populateCharKeyInformation();
+    buildLookupTables();
 }
 
 /*
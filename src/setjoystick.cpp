@@ -23,7 +23,10 @@
 #include "joydpad.h"
 #include "joybutton.h"
 #include "vdpad.h"
+#include "joybuttontypes/joyaxisbutton.h"
+#include "joybuttontypes/joydpadbutton.h"
 #include "joybuttontypes/joycontrolstickbutton.h"
+#include "joybuttontypes/joycontrolstickmodifierbutton.h"
 
 #include <QDebug>
 #include <QHashIterator>
@@ -390,6 +393,72 @@ void SetJoystick::release()
     }
 }
 
+/**
+ * @brief Release every element of the set without sending new input.
+ *     Used when the device is unplugged but kept for a reconnect.
+ */
+void SetJoystick::detachReset()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    QHashIterator<int, JoyButton*> iterButtons(getButtons());
+    while (iterButtons.hasNext())
+    {
+        JoyButton *button = iterButtons.next().value();
+        button->clearPendingEvent();
+        button->detachReset();
+    }
+
+    QHashIterator<int, JoyAxis*> iterAxes(axes);
+    while (iterAxes.hasNext())
+    {
+        JoyAxis *axis = iterAxes.next().value();
+        axis->clearPendingEvent();
+        axis->getNAxisButton()->detachReset();
+        axis->getPAxisButton()->detachReset();
+    }
+
+    QHashIterator<int, JoyDPad*> iterDPads(getHats());
+    while (iterDPads.hasNext())
+    {
+        JoyDPad *dpad = iterDPads.next().value();
+        dpad->clearPendingEvent();
+
+        QHashIterator<int, JoyDPadButton*> iterDPadButtons(*dpad->getButtons());
+        while (iterDPadButtons.hasNext())
+        {
+            iterDPadButtons.next().value()->detachReset();
+        }
+    }
+
+    QHashIterator<int, JoyControlStick*> iterSticks(getSticks());
+    while (iterSticks.hasNext())
+    {
+        JoyControlStick *stick = iterSticks.next().value();
+        stick->clearPendingEvent();
+
+        QHashIterator<JoyControlStick::JoyStickDirections, JoyControlStickButton*> iterStickButtons(*stick->getButtons());
+        while (iterStickButtons.hasNext())
+        {
+            iterStickButtons.next().value()->detachReset();
+        }
+
+        stick->getModifierButton()->detachReset();
+    }
+
+    QHashIterator<int, VDPad*> iterVDPads(getVdpads());
+    while (iterVDPads.hasNext())
+    {
+        VDPad *vdpad = iterVDPads.next().value();
+
+        QHashIterator<int, JoyDPadButton*> iterVDPadButtons(*vdpad->getButtons());
+        while (iterVDPadButtons.hasNext())
+        {
+            iterVDPadButtons.next().value()->detachReset();
+        }
+    }
+}
+
 void SetJoystick::readConfig(QXmlStreamReader *xml)
 {
     qInstallMessageHandler(MessageHandler::myMessageOutput);
@@ -65,6 +65,7 @@ public:
     virtual void refreshAxes();
     virtual void refreshHats();
     void release();
+    void detachReset();
     void addControlStick(int index, JoyControlStick *stick);
     void removeControlStick(int index);
     void addVDPad(int index, VDPad *vdpad);
@@ -0,0 +1,129 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "startuptrace.h"
+
+#include "logger.h"
+
+#include <QListIterator>
+#include <QMutexLocker>
+
+
+QElapsedTimer StartupTrace::clock;
+qint64 StartupTrace::lastMark = 0;
+bool StartupTrace::enabled = false;
+bool StartupTrace::reported = false;
+QList<StartupTrace::Phase> StartupTrace::phases;
+QMutex StartupTrace::mutex;
+
+
+/**
+ * @brief Start the startup clock. Should be called first thing in main.
+ */
+void StartupTrace::start()
+{
+    QMutexLocker locker(&mutex);
+
+    clock.start();
+    lastMark = 0;
+    reported = false;
+    phases.clear();
+}
+
+void StartupTrace::setEnabled(bool status)
+{
+    enabled = status;
+}
+
+bool StartupTrace::isEnabled()
+{
+    return enabled;
+}
+
+/**
+ * @brief Close the current main thread phase. Its duration is the time
+ *     passed since the previous mark.
+ * @param Name of the phase
+ */
+void StartupTrace::mark(const QString &phase)
+{
+    QMutexLocker locker(&mutex);
+
+    if (clock.isValid())
+    {
+        qint64 current = clock.nsecsElapsed();
+        Phase temp = {phase, current - lastMark, current};
+        phases.append(temp);
+        lastMark = current;
+    }
+}
+
+/**
+ * @brief Add a phase that ran next to the main thread phases.
+ * @param Name of the phase
+ * @param Duration of the phase in nanoseconds
+ */
+void StartupTrace::record(const QString &phase, qint64 nsecs)
+{
+    QMutexLocker locker(&mutex);
+
+    if (clock.isValid())
+    {
+        Phase temp = {phase, nsecs, clock.nsecsElapsed()};
+        phases.append(temp);
+    }
+}
+
+/**
+ * @brief Get the time passed since startup.
+ * @return Elapsed time in nanoseconds or 0 if the clock was not started
+ */
+qint64 StartupTrace::elapsed()
+{
+    QMutexLocker locker(&mutex);
+
+    return clock.isValid() ? clock.nsecsElapsed() : 0;
+}
+
+/**
+ * @brief Log the recorded phases once. Nothing is logged unless tracing
+ *     is enabled.
+ */
+void StartupTrace::report()
+{
+    QMutexLocker locker(&mutex);
+
+    if (enabled && !reported && clock.isValid())
+    {
+        reported = true;
+
+        Logger::LogInfo(QString("Startup trace:"), true, true);
+
+        QListIterator<Phase> iter(phases);
+        while (iter.hasNext())
+        {
+            const Phase &temp = iter.next();
+            Logger::LogInfo(QString("  %1: %2 ms (done at %3 ms)")
+                            .arg(temp.name)
+                            .arg(temp.nsecs / 1000000.0, 0, 'f', 2)
+                            .arg(temp.finished / 1000000.0, 0, 'f', 2), true, true);
+        }
+
+        Logger::LogInfo(QString("Startup finished after %1 ms")
+                        .arg(clock.nsecsElapsed() / 1000000.0, 0, 'f', 2), true, true);
+    }
+}
@@ -0,0 +1,61 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QList>
+#include <QElapsedTimer>
+#include <QMutex>
+
+/**
+ * @brief Records how long each startup phase takes. Phases on the main
+ *     thread are closed with mark(). Phases that run on helper threads
+ *     time themselves and are added with record(). The summary is only
+ *     logged when tracing was requested on the command line.
+ */
+class StartupTrace
+{
+public:
+    static void start();
+    static void setEnabled(bool status);
+    static bool isEnabled();
+
+    static void mark(const QString &phase);
+    static void record(const QString &phase, qint64 nsecs);
+    static qint64 elapsed();
+    static void report();
+
+private:
+    struct Phase
+    {
+        QString name;
+        qint64 nsecs;
+        qint64 finished;
+    };
+
+    static QElapsedTimer clock;
+    static qint64 lastMark;
+    static bool enabled;
+    static bool reported;
+    static QList<Phase> phases;
+    static QMutex mutex;
+};
+
+#endif // STARTUPTRACE_H
@@ -0,0 +1,63 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "subpixelaccumulator.h"
+
+// Largest distance in pixels sent for a single event. Excess movement
+// is dropped rather than carried over so the cursor stops with the stick.
+const int SubPixelAccumulator::MAXDELTA = 32767;
+
+// Fixed point value of one pixel.
+static const qint64 FIXEDUNIT = 65536;
+
+
+SubPixelAccumulator::SubPixelAccumulator()
+{
+    residue = 0;
+}
+
+/**
+ * @brief Add a distance to the accumulator and take out the whole pixels.
+ *     Whole pixels are truncated towards zero so the residue keeps the
+ *     sign of the movement.
+ * @param Distance in pixels
+ * @return Whole pixels to move
+ */
+int SubPixelAccumulator::add(double distance)
+{
+    residue += qRound64(distance * FIXEDUNIT);
+
+    qint64 whole = residue / FIXEDUNIT;
+    residue -= whole * FIXEDUNIT;
+
+    return static_cast<int>(qBound(static_cast<qint64>(-MAXDELTA), whole,
+                                   static_cast<qint64>(MAXDELTA)));
+}
+
+void SubPixelAccumulator::reset()
+{
+    residue = 0;
+}
+
+/**
+ * @brief Distance in pixels that has not been sent yet.
+ */
+double SubPixelAccumulator::getResidue() const
+{
+    return static_cast<double>(residue) / FIXEDUNIT;
+}
@@ -0,0 +1,45 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SUBPIXELACCUMULATOR_H
+#define SUBPIXELACCUMULATOR_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Fixed point accumulator for one relative output axis. Distances
+ *     are stored in 1/65536 pixel so the part of a move that cannot be
+ *     sent yet is carried over exactly, regardless of the direction of
+ *     the next move.
+ */
+class SubPixelAccumulator
+{
+public:
+    SubPixelAccumulator();
+
+    int add(double distance);
+    void reset();
+    double getResidue() const;
+
+    static const int MAXDELTA;
+
+private:
+    qint64 residue;
+};
+
+#endif // SUBPIXELACCUMULATOR_H
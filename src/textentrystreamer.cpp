@@ -0,0 +1,201 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "textentrystreamer.h"
+
+#include "messagehandler.h"
+#include "common.h"
+#include "eventhandlerdispatch.h"
+
+#include <QDebug>
+#include <QThread>
+
+
+TextEntryStreamer* TextEntryStreamer::instance = nullptr;
+
+// Rate is expressed in key steps (presses and releases) per second.
+const int TextEntryStreamer::DEFAULTKEYSTROKERATE = 2000;
+const int TextEntryStreamer::MAXKEYSTROKERATE = 100000;
+const int TextEntryStreamer::STREAMINTERVAL = 5;
+
+QAtomicInt TextEntryStreamer::keystrokeRate(TextEntryStreamer::DEFAULTKEYSTROKERATE);
+
+
+TextEntryStreamer::TextEntryStreamer(QObject *parent) :
+    QObject(parent),
+    streamTimer(this)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    nextStep = 0;
+    stepBudget = 0.0;
+
+    streamTimer.setInterval(STREAMINTERVAL);
+    streamTimer.setTimerType(Qt::PreciseTimer);
+    connect(&streamTimer, &QTimer::timeout, this, &TextEntryStreamer::streamPendingSteps);
+}
+
+TextEntryStreamer::~TextEntryStreamer()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    streamTimer.stop();
+}
+
+/**
+ * @brief Create the streamer and hand it and its stream timer to the
+ *     input event thread. Has to be called at startup before that thread
+ *     runs. Text entries can be queued from several device workers, so
+ *     the instance is not created on first use.
+ * @param Thread that streams the text entries
+ */
+void TextEntryStreamer::createInstance(QThread *thread)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (instance == nullptr)
+    {
+        instance = new TextEntryStreamer();
+        instance->moveToThread(thread);
+    }
+}
+
+/**
+ * @brief Get the streamer instance made by createInstance.
+ * @return TextEntryStreamer instance
+ */
+TextEntryStreamer* TextEntryStreamer::getInstance()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return instance;
+}
+
+void TextEntryStreamer::deleteInstance()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (instance != nullptr)
+    {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+/**
+ * @brief Append a compiled text entry to the output queue. The first step
+ *     goes out right away; the rest is paced by the stream timer.
+ * @param Compiled keystroke program
+ */
+void TextEntryStreamer::queueProgram(const KeystrokeProgram::Steps &program)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (!program.isEmpty())
+    {
+        PadderCommon::OutputStageLocker outputLocker;
+
+        if (nextStep > 0)
+        {
+            pendingSteps.remove(0, nextStep);
+            nextStep = 0;
+        }
+
+        pendingSteps += program;
+
+        if (!streamTimer.isActive())
+        {
+            stepBudget = 1.0;
+            lastStreamTime.start();
+
+            if (thread() == QThread::currentThread())
+            {
+                streamPendingSteps();
+            }
+            else
+            {
+                // Entries queued by a device worker are streamed by the
+                // thread that owns the stream timer.
+                QMetaObject::invokeMethod(this, "streamPendingSteps", Qt::QueuedConnection);
+            }
+        }
+    }
+}
+
+bool TextEntryStreamer::isStreaming()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    // Buttons of devices on worker threads poll this while they wait.
+    PadderCommon::OutputStageLocker outputLocker;
+    return nextStep < pendingSteps.size();
+}
+
+void TextEntryStreamer::setKeystrokeRate(int rate)
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    if (rate > 0)
+    {
+        keystrokeRate.store(qMin(rate, MAXKEYSTROKERATE));
+    }
+}
+
+int TextEntryStreamer::getKeystrokeRate()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    return keystrokeRate.load();
+}
+
+/**
+ * @brief Send as many steps as the configured rate allows for the time
+ *     passed since the last call.
+ */
+void TextEntryStreamer::streamPendingSteps()
+{
+    qInstallMessageHandler(MessageHandler::myMessageOutput);
+
+    PadderCommon::OutputStageLocker outputLocker;
+
+    int rate = keystrokeRate.load();
+    double elapsed = lastStreamTime.nsecsElapsed() / 1000000.0;
+    lastStreamTime.restart();
+
+    // Do not let a stalled timer turn into one large burst.
+    double maxBudget = ((rate * STREAMINTERVAL * 2) / 1000.0) + 1.0;
+    stepBudget = qMin(stepBudget + ((elapsed * rate) / 1000.0), maxBudget);
+
+    while ((stepBudget >= 1.0) && (nextStep < pendingSteps.size()))
+    {
+        OutputEventHandler::sendKeystrokeStep(pendingSteps.at(nextStep));
+        nextStep++;
+        stepBudget -= 1.0;
+    }
+
+    if (nextStep >= pendingSteps.size())
+    {
+        pendingSteps.clear();
+        nextStep = 0;
+        stepBudget = 0.0;
+        streamTimer.stop();
+    }
+    else if (!streamTimer.isActive())
+    {
+        streamTimer.start();
+    }
+}
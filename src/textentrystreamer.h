@@ -0,0 +1,73 @@
+/* antimicro Gamepad to KB+M event mapper
+ * Copyright (C) 2015 Travis Nickles <nickles.travis@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEXTENTRYSTREAMER_H
+#define TEXTENTRYSTREAMER_H
+
+#include "keystrokeprogram.h"
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+
+class QThread;
+
+
+/**
+ * @brief Paced output stage for compiled text entries. Steps are sent
+ *     in small chunks from a timer on the thread that owns the streamer
+ *     so long text entries do not stall controller processing.
+ */
+class TextEntryStreamer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void createInstance(QThread *thread);
+    static TextEntryStreamer* getInstance();
+    static void deleteInstance();
+
+    void queueProgram(const KeystrokeProgram::Steps &program);
+    bool isStreaming();
+
+    static void setKeystrokeRate(int rate);
+    static int getKeystrokeRate();
+
+    static const int DEFAULTKEYSTROKERATE;
+    static const int MAXKEYSTROKERATE;
+    static const int STREAMINTERVAL;
+
+protected:
+    explicit TextEntryStreamer(QObject *parent = nullptr);
+    ~TextEntryStreamer();
+
+    static TextEntryStreamer *instance;
+    static QAtomicInt keystrokeRate;
+
+private slots:
+    void streamPendingSteps();
+
+private:
+    KeystrokeProgram::Steps pendingSteps;
+    int nextStep;
+    double stepBudget;
+    QTimer streamTimer;
+    QElapsedTimer lastStreamTime;
+};
+
+#endif // TEXTENTRYSTREAMER_H
@@ -903,7 +903,6 @@ QPoint X11Extras::getPos()
 
     XEvent mouseEvent;
     Window wid = DefaultRootWindow(display());
-    XWindowAttributes xwAttr;
 
     XQueryPointer(display(), wid,
                   &mouseEvent.xbutton.root, &mouseEvent.xbutton.window,
@@ -911,7 +910,6 @@ QPoint X11Extras::getPos()
                   &mouseEvent.xbutton.x, &mouseEvent.xbutton.y,
                   &mouseEvent.xbutton.state);
 
-    XGetWindowAttributes(display(), wid, &xwAttr);
     QPoint currentPoint(mouseEvent.xbutton.x_root, mouseEvent.xbutton.y_root);
     return currentPoint;
 }